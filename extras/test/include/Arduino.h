@@ -9,6 +9,9 @@
    INCLUDE
  ******************************************************************************/
 
+#include <stdint.h>
+#include <string.h>
+
 #include <string>
 
 /******************************************************************************
@@ -16,6 +19,7 @@
  ******************************************************************************/
 
 typedef std::string String;
+typedef uint8_t byte;
 
 /******************************************************************************
    FUNCTION PROTOTYPES
@@ -23,5 +27,12 @@ typedef std::string String;
 
 void          set_millis(unsigned long const millis);
 unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long const ms);
+
+uint16_t      word(uint8_t const high, uint8_t const low);
+void          randomSeed(unsigned long const seed);
+long          random(long const min, long const max);
+int           analogRead(uint8_t const pin);
 
 #endif /* TEST_ARDUINO_H_ */
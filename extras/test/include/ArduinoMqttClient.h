@@ -0,0 +1,85 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef TEST_ARDUINO_MQTT_CLIENT_H_
+#define TEST_ARDUINO_MQTT_CLIENT_H_
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <Arduino.h>
+#include <Client.h>
+
+#include <deque>
+#include <vector>
+
+/******************************************************************************
+   CLASS DECLARATION
+ ******************************************************************************/
+
+/* Host stand-in for ArduinoMqttClient which exchanges messages with the
+ * in-process broker stand-in (see util/FakeBroker.h) instead of a network
+ * connection. Only the subset of the API used by the library is provided.
+ * The host is no board with a TLS client, ArduinoIoTCloudTCP does not set
+ * any Client then and the stand-in uses a link of its own.
+ */
+class MqttClient
+{
+public:
+
+  typedef void(*MessageCallback)(int);
+
+
+  MqttClient(Client * client);
+  virtual ~MqttClient();
+
+
+  void setClient            (Client & client);
+  void onMessage            (MessageCallback callback);
+  void setId                (char const * id);
+  void setUsernamePassword  (String const & username, String const & password);
+  void setKeepAliveInterval (unsigned long const interval);
+  void setConnectionTimeout (unsigned long const timeout);
+
+  int  connect              (char const * host, uint16_t const port);
+  int  connected            ();
+  void stop                 ();
+  void poll                 ();
+
+  int  subscribe            (String const & topic, uint8_t const qos = 0);
+  int  subscribe            (char const * topic, uint8_t const qos = 0);
+
+  int    beginMessage       (String const & topic, unsigned long const size, bool const retain = false, uint8_t const qos = 0, bool const dup = false);
+  int    beginMessage       (char const * topic, unsigned long const size, bool const retain = false, uint8_t const qos = 0, bool const dup = false);
+  size_t write              (uint8_t const * buf, size_t const size);
+  int    endMessage         ();
+
+  String messageTopic       () const;
+  int    available          ();
+  int    read               ();
+
+  /* Called by the broker stand-in in order to deliver a message to this client. */
+  void   deliver            (String const & topic, std::vector<uint8_t> const & payload);
+
+private:
+
+  struct Message
+  {
+    String topic;
+    std::vector<uint8_t> payload;
+  };
+
+  Client _link;
+  Client * _client;
+  MessageCallback _on_message;
+  bool _is_connected;
+  Message _tx_msg;
+  uint8_t _tx_qos;
+  std::deque<Message> _rx_queue;
+  Message _rx_msg;
+  size_t _rx_pos;
+};
+
+#endif /* TEST_ARDUINO_MQTT_CLIENT_H_ */
@@ -0,0 +1,82 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef TEST_ARDUINO_CONNECTION_HANDLER_H_
+#define TEST_ARDUINO_CONNECTION_HANDLER_H_
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <Arduino.h>
+#include <Client.h>
+#include <Udp.h>
+
+#include <deque>
+#include <vector>
+
+/******************************************************************************
+   TYPEDEF
+ ******************************************************************************/
+
+enum class NetworkConnectionState : unsigned int
+{
+  INIT          = 0,
+  CONNECTING    = 1,
+  CONNECTED     = 2,
+  DISCONNECTING = 3,
+  DISCONNECTED  = 4,
+  CLOSED        = 5,
+  ERROR         = 6
+};
+
+/******************************************************************************
+   CLASS DECLARATION
+ ******************************************************************************/
+
+/* Host stand-in for Arduino_ConnectionHandler. The network state is set by
+ * the test via setStatus(). The network time starts at the epoch set via
+ * setTime() and advances with millis(). For LoRa the uplinks written are
+ * recorded, write() returns the result set via setWriteResult() and the
+ * downlinks queued via pushDownlink() are provided by available()/read().
+ */
+class ConnectionHandler
+{
+public:
+
+  ConnectionHandler();
+
+
+  NetworkConnectionState check    ();
+  NetworkConnectionState getStatus();
+  unsigned long          getTime  ();
+  Client &               getClient();
+  UDP &                  getUDP   ();
+
+  int                    write    (uint8_t const * buf, size_t const size);
+  int                    read     ();
+  bool                   available();
+
+  void setStatus     (NetworkConnectionState const status);
+  void setTime       (unsigned long const epoch);
+  void setWriteResult(int const result);
+  void pushDownlink  (std::vector<uint8_t> const & msg);
+  void reset         ();
+
+  inline std::vector<std::vector<uint8_t>> const & uplinks() const { return _uplinks; }
+  inline unsigned long getWriteAttempts() const { return _write_attempt_cnt; }
+
+private:
+
+  NetworkConnectionState _status;
+  unsigned long _epoch;
+  Client _client;
+  UDP _udp;
+  int _write_result;
+  unsigned long _write_attempt_cnt;
+  std::vector<std::vector<uint8_t>> _uplinks;
+  std::deque<uint8_t> _downlink;
+};
+
+#endif /* TEST_ARDUINO_CONNECTION_HANDLER_H_ */
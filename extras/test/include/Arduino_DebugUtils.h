@@ -0,0 +1,37 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef TEST_ARDUINO_DEBUG_UTILS_H_
+#define TEST_ARDUINO_DEBUG_UTILS_H_
+
+/******************************************************************************
+   CONSTANTS
+ ******************************************************************************/
+
+static int const DBG_NONE    = -1;
+static int const DBG_ERROR   =  0;
+static int const DBG_WARNING =  1;
+static int const DBG_INFO    =  2;
+static int const DBG_DEBUG   =  3;
+static int const DBG_VERBOSE =  4;
+
+/******************************************************************************
+   CLASS DECLARATION
+ ******************************************************************************/
+
+/* Host stand-in for Arduino_DebugUtils, all debug output is discarded. */
+class Arduino_DebugUtils
+{
+public:
+
+  void print(int const /* debug_level */, char const * /* fmt */, ...) { }
+};
+
+/******************************************************************************
+   EXTERN DECLARATION
+ ******************************************************************************/
+
+extern Arduino_DebugUtils Debug;
+
+#endif /* TEST_ARDUINO_DEBUG_UTILS_H_ */
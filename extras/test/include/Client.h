@@ -0,0 +1,40 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef TEST_CLIENT_H_
+#define TEST_CLIENT_H_
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <Arduino.h>
+
+/******************************************************************************
+   CLASS DECLARATION
+ ******************************************************************************/
+
+/* Host stand-in for the Arduino core 'Client' class. A connect() succeeds
+ * whenever the in-process broker (see util/FakeBroker.h) is reachable.
+ */
+class Client
+{
+public:
+
+  Client();
+
+
+  int     connect  (char const * host, uint16_t const port);
+  uint8_t connected();
+  void    stop     ();
+
+  inline unsigned long getConnectCount() const { return _connect_cnt; }
+
+private:
+
+  bool _is_connected;
+  unsigned long _connect_cnt;
+};
+
+#endif /* TEST_CLIENT_H_ */
@@ -0,0 +1,32 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef TEST_UDP_H_
+#define TEST_UDP_H_
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <Arduino.h>
+
+/******************************************************************************
+   CLASS DECLARATION
+ ******************************************************************************/
+
+/* Host stand-in for the Arduino core 'UDP' class. No NTP server ever answers. */
+class UDP
+{
+public:
+
+  uint8_t begin      (uint16_t const)                   { return 1; }
+  int     beginPacket(char const *, uint16_t const)     { return 1; }
+  size_t  write      (uint8_t const *, size_t const len) { return len; }
+  int     endPacket  ()                                 { return 1; }
+  int     parsePacket()                                 { delay(1); return 0; }
+  int     read       (uint8_t *, size_t const)          { return 0; }
+  void    stop       ()                                 { }
+};
+
+#endif /* TEST_UDP_H_ */
@@ -0,0 +1,76 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef INCLUDE_ALLOCATION_TRACKER_H_
+#define INCLUDE_ALLOCATION_TRACKER_H_
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <stddef.h>
+
+/**************************************************************************************
+   NAMESPACE
+ **************************************************************************************/
+
+namespace alloc
+{
+
+/**************************************************************************************
+   TYPEDEF
+ **************************************************************************************/
+
+struct Stats
+{
+  unsigned long allocations;   /* Number of allocations                          */
+  unsigned long deallocations; /* Number of deallocations                        */
+  size_t        bytes;         /* Total number of bytes allocated                */
+  size_t        current_bytes; /* Number of bytes allocated and not yet released */
+  size_t        peak_bytes;    /* Maximum of current_bytes                       */
+};
+
+/**************************************************************************************
+   PROTOTYPES
+ **************************************************************************************/
+
+/* Returns the statistics of all heap allocations performed via new/delete and,
+ * on Linux, malloc/calloc/realloc/free since the last call to reset(). Sizes are
+ * the usable sizes reported by the allocator, which may exceed the requested one.
+ */
+Stats stats();
+
+/* Resets all counters, the peak is reset to the number of bytes currently allocated. */
+void reset();
+
+/**************************************************************************************
+   CLASS DECLARATION
+ **************************************************************************************/
+
+/* Measures the heap allocations performed during the lifetime of the object.
+ * Scopes can not be nested since the creation of a scope resets the peak.
+ */
+class Scope
+{
+public:
+
+  Scope();
+
+  unsigned long allocations () const;
+  unsigned long leaks       () const;
+  size_t        bytes       () const;
+  size_t        peak_bytes  () const;
+
+private:
+
+  Stats _start;
+};
+
+/**************************************************************************************
+   NAMESPACE
+ **************************************************************************************/
+
+} /* alloc */
+
+#endif /* INCLUDE_ALLOCATION_TRACKER_H_ */
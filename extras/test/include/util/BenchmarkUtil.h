@@ -0,0 +1,68 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef INCLUDE_BENCHMARK_UTIL_H_
+#define INCLUDE_BENCHMARK_UTIL_H_
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <stddef.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**************************************************************************************
+   NAMESPACE
+ **************************************************************************************/
+
+namespace bench
+{
+
+/**************************************************************************************
+   TYPEDEF
+ **************************************************************************************/
+
+struct Result
+{
+  std::string name;
+  double      ns_per_op;
+  size_t      bytes;
+  double      allocs_per_op;
+};
+
+/* A benchmarked operation returns the number of bytes it has encoded or decoded. */
+typedef std::function<size_t()> Operation;
+
+/**************************************************************************************
+   PROTOTYPES
+ **************************************************************************************/
+
+/* Runs 'op' repeatedly in several rounds lasting at least 'min_duration_ms' each
+ * and returns the duration of a single call in the fastest round as well as the
+ * average number of heap allocations per call.
+ */
+Result measure(std::string const & name, Operation const & op, unsigned long const min_duration_ms);
+
+void print(std::vector<Result> const & results);
+
+bool readBaseline (std::string const & filename, std::map<std::string, Result> & baseline);
+bool writeBaseline(std::string const & filename, std::vector<Result> const & results);
+
+/* Returns the number of regressions, i.e. results which are slower than the
+ * baseline by more than 'time_tolerance_percent', encode to more bytes or
+ * allocate more often. Timing is ignored if 'time_tolerance_percent' is < 0.
+ */
+size_t compare(std::vector<Result> const & results, std::map<std::string, Result> const & baseline, double const time_tolerance_percent);
+
+/**************************************************************************************
+   NAMESPACE
+ **************************************************************************************/
+
+} /* bench */
+
+#endif /* INCLUDE_BENCHMARK_UTIL_H_ */
@@ -0,0 +1,105 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef INCLUDE_FAKE_BROKER_H_
+#define INCLUDE_FAKE_BROKER_H_
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <Arduino.h>
+
+#include <list>
+#include <vector>
+
+/**************************************************************************************
+   FORWARD DECLARATION
+ **************************************************************************************/
+
+class MqttClient;
+
+/**************************************************************************************
+   CLASS DECLARATION
+ **************************************************************************************/
+
+/* In-process stand-in for the Arduino IoT Cloud MQTT broker. It keeps track of
+ * the connected fake MQTT clients and their subscriptions, routes publications
+ * and records every message received from the device together with traffic
+ * counters. If configured it answers 'getLastValues' requests on the shadow
+ * topic with a canned shadow payload.
+ */
+class FakeBroker
+{
+public:
+
+  struct Message
+  {
+    String topic;
+    std::vector<uint8_t> payload;
+    unsigned long tick;
+  };
+
+
+  static FakeBroker & instance();
+
+  void reset();
+
+  /* Broker behaviour */
+  inline void setOnline              (bool const is_online)   { _is_online = is_online; if (!is_online) disconnectAll(); }
+  inline void setSubscriptionsAllowed(bool const is_allowed)  { _is_subscription_allowed = is_allowed; }
+  inline void setShadowReply         (std::vector<uint8_t> const & payload) { _shadow_reply = payload; _is_shadow_reply_enabled = true; }
+  inline void disableShadowReply     ()                       { _is_shadow_reply_enabled = false; }
+  /* QoS 1 publications are received but not acknowledged (no PUBACK) if disabled. */
+  inline void setPublishAcked        (bool const is_acked)    { _is_publish_acked = is_acked; }
+  inline bool isOnline               () const                 { return _is_online; }
+
+  /* Interface used by the fake MQTT client */
+  bool connect    (MqttClient * client);
+  bool isConnected(MqttClient * client) const;
+  void disconnect (MqttClient * client);
+  bool subscribe  (MqttClient * client, String const & topic);
+  /* Returns whether or not a QoS 1 publication is acknowledged. */
+  bool publish    (MqttClient * client, String const & topic, std::vector<uint8_t> const & payload);
+
+  /* Interface used by the test */
+  void disconnectAll();
+  void send(String const & topic, std::vector<uint8_t> const & payload);
+
+  inline std::list<Message> const & received           () const { return _received; }
+  inline unsigned long              getConnectCount    () const { return _connect_cnt; }
+  inline unsigned long              getConnectAttempts () const { return _connect_attempt_cnt; }
+  inline unsigned long              getSubscribeAttempts() const { return _subscribe_attempt_cnt; }
+  inline unsigned long              getMessagesIn      () const { return _received.size(); }
+  inline unsigned long              getBytesIn         () const { return _bytes_in; }
+  unsigned long                     getMessagesIn      (String const & topic) const;
+
+  /* MQTT fixed header + topic length field + topic + payload of a QoS 0 PUBLISH */
+  static size_t getPublishPacketSize(String const & topic, size_t const payload_len);
+
+private:
+
+  struct Subscription
+  {
+    MqttClient * client;
+    String topic;
+  };
+
+  FakeBroker();
+
+  bool _is_online;
+  bool _is_subscription_allowed;
+  bool _is_shadow_reply_enabled;
+  bool _is_publish_acked;
+  std::vector<uint8_t> _shadow_reply;
+  std::list<MqttClient *> _clients;
+  std::list<Subscription> _subscriptions;
+  std::list<Message> _received;
+  unsigned long _connect_cnt;
+  unsigned long _connect_attempt_cnt;
+  unsigned long _subscribe_attempt_cnt;
+  unsigned long _bytes_in;
+};
+
+#endif /* INCLUDE_FAKE_BROKER_H_ */
@@ -0,0 +1,72 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+#ifndef INCLUDE_PACKED_DECODER_H_
+#define INCLUDE_PACKED_DECODER_H_
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+/**************************************************************************************
+   CLASS DECLARATION
+ **************************************************************************************/
+
+/* Reference decoder of the format written by PackedEncoder, which only relies
+ * on the schema exported by PackedEncoder::printSchema() like a decoder on the
+ * cloud side would.
+ */
+class PackedDecoder
+{
+
+public:
+
+  struct Value
+  {
+    std::string name;
+    int         identifier;
+    int         attribute;
+    char        type;
+    bool        bool_val;
+    double      val;
+    std::string str_val;
+  };
+
+  bool setSchema(std::string const & schema);
+  /* Returns false if the message is malformed. Values transmitted as a delta
+   * to a value which has been missed are skipped.
+   */
+  bool decode(std::vector<uint8_t> const & msg, std::vector<Value> & values);
+
+  inline size_t getFieldCount () const { return _field.size(); }
+  inline size_t getSkippedCount() const { return _skipped_cnt; }
+
+private:
+
+  struct Field
+  {
+    std::string name;
+    int         identifier;
+    int         attribute;
+    char        type;
+    int         decimals;
+    int         bits;
+    bool        has_reference;
+    int64_t     reference;
+  };
+
+  std::vector<Field> _field;
+  int                _last_sequence_number = -1;
+  size_t             _skipped_cnt = 0;
+
+  static bool read(std::vector<uint8_t> const & msg, size_t & bit_pos, int const bits, uint32_t & value);
+  static int64_t signExtend(uint32_t const value, int const bits);
+};
+
+#endif /* INCLUDE_PACKED_DECODER_H_ */
@@ -8,6 +8,8 @@
 
 #include <Arduino.h>
 
+#include <stdlib.h>
+
 /******************************************************************************
    GLOBAL VARIABLES
  ******************************************************************************/
@@ -27,3 +29,33 @@ unsigned long millis()
 {
   return current_millis;
 }
+
+unsigned long micros()
+{
+  return current_millis * 1000;
+}
+
+void delay(unsigned long const ms)
+{
+  current_millis += ms;
+}
+
+uint16_t word(uint8_t const high, uint8_t const low)
+{
+  return (static_cast<uint16_t>(high) << 8) | low;
+}
+
+void randomSeed(unsigned long const seed)
+{
+  srand(seed);
+}
+
+long random(long const min, long const max)
+{
+  return (max > min) ? (min + (rand() % (max - min))) : min;
+}
+
+int analogRead(uint8_t const /* pin */)
+{
+  return 0;
+}
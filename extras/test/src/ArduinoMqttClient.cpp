@@ -0,0 +1,175 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <ArduinoMqttClient.h>
+
+#include <util/FakeBroker.h>
+
+/******************************************************************************
+   CTOR/DTOR
+ ******************************************************************************/
+
+MqttClient::MqttClient(Client * client)
+: _client{client ? client : &_link}
+, _on_message{nullptr}
+, _is_connected{false}
+, _tx_qos{0}
+, _rx_pos{0}
+{
+
+}
+
+MqttClient::~MqttClient()
+{
+
+}
+
+/******************************************************************************
+   PUBLIC MEMBER FUNCTIONS
+ ******************************************************************************/
+
+void MqttClient::setClient(Client & client)
+{
+  _client = &client;
+}
+
+void MqttClient::onMessage(MessageCallback callback)
+{
+  _on_message = callback;
+}
+
+void MqttClient::setId(char const * /* id */)
+{
+
+}
+
+void MqttClient::setUsernamePassword(String const & /* username */, String const & /* password */)
+{
+
+}
+
+void MqttClient::setKeepAliveInterval(unsigned long const /* interval */)
+{
+
+}
+
+void MqttClient::setConnectionTimeout(unsigned long const /* timeout */)
+{
+
+}
+
+int MqttClient::connect(char const * host, uint16_t const port)
+{
+  if (!_client || !_client->connect(host, port))
+    return 0;
+
+  _is_connected = FakeBroker::instance().connect(this);
+  if (!_is_connected)
+    _client->stop();
+  return _is_connected ? 1 : 0;
+}
+
+int MqttClient::connected()
+{
+  if (_is_connected && !(_client && _client->connected() && FakeBroker::instance().isConnected(this)))
+    stop();
+  return _is_connected ? 1 : 0;
+}
+
+void MqttClient::stop()
+{
+  FakeBroker::instance().disconnect(this);
+  if (_client)
+    _client->stop();
+  _is_connected = false;
+  _rx_queue.clear();
+}
+
+void MqttClient::poll()
+{
+  while (connected() && !_rx_queue.empty())
+  {
+    _rx_msg = _rx_queue.front();
+    _rx_queue.pop_front();
+    _rx_pos = 0;
+    if (_on_message)
+      _on_message(static_cast<int>(_rx_msg.payload.size()));
+  }
+}
+
+int MqttClient::subscribe(String const & topic, uint8_t const /* qos */)
+{
+  if (!connected())
+    return 0;
+  return FakeBroker::instance().subscribe(this, topic) ? 1 : 0;
+}
+
+int MqttClient::subscribe(char const * topic, uint8_t const qos)
+{
+  return subscribe(String(topic), qos);
+}
+
+int MqttClient::beginMessage(String const & topic, unsigned long const size, bool const /* retain */, uint8_t const qos, bool const /* dup */)
+{
+  if (!connected())
+    return 0;
+  _tx_qos = qos;
+  _tx_msg.topic = topic;
+  _tx_msg.payload.clear();
+  _tx_msg.payload.reserve(size);
+  return 1;
+}
+
+int MqttClient::beginMessage(char const * topic, unsigned long const size, bool const retain, uint8_t const qos, bool const dup)
+{
+  return beginMessage(String(topic), size, retain, qos, dup);
+}
+
+size_t MqttClient::write(uint8_t const * buf, size_t const size)
+{
+  _tx_msg.payload.insert(_tx_msg.payload.end(), buf, buf + size);
+  return size;
+}
+
+int MqttClient::endMessage()
+{
+  if (!connected())
+    return 0;
+  bool const is_acked = FakeBroker::instance().publish(this, _tx_msg.topic, _tx_msg.payload);
+  /* Like ArduinoMqttClient, give up on the connection if the PUBACK of a QoS 1
+   * publication does not arrive in time.
+   */
+  if ((_tx_qos > 0) && !is_acked)
+  {
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+String MqttClient::messageTopic() const
+{
+  return _rx_msg.topic;
+}
+
+int MqttClient::available()
+{
+  return static_cast<int>(_rx_msg.payload.size() - _rx_pos);
+}
+
+int MqttClient::read()
+{
+  if (_rx_pos >= _rx_msg.payload.size())
+    return -1;
+  return _rx_msg.payload[_rx_pos++];
+}
+
+void MqttClient::deliver(String const & topic, std::vector<uint8_t> const & payload)
+{
+  _rx_queue.push_back(Message{topic, payload});
+}
@@ -0,0 +1,110 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <Arduino_ConnectionHandler.h>
+
+/******************************************************************************
+   CONSTANTS
+ ******************************************************************************/
+
+/* 2030-01-01 00:00:00 UTC, way past the compile time of the library. */
+static unsigned long const DEFAULT_EPOCH = 1893456000UL;
+
+/******************************************************************************
+   CTOR/DTOR
+ ******************************************************************************/
+
+ConnectionHandler::ConnectionHandler()
+: _status{NetworkConnectionState::CONNECTED}
+, _epoch{DEFAULT_EPOCH}
+, _write_result{0}
+, _write_attempt_cnt{0}
+{
+
+}
+
+/******************************************************************************
+   PUBLIC MEMBER FUNCTIONS
+ ******************************************************************************/
+
+NetworkConnectionState ConnectionHandler::check()
+{
+  return _status;
+}
+
+NetworkConnectionState ConnectionHandler::getStatus()
+{
+  return _status;
+}
+
+unsigned long ConnectionHandler::getTime()
+{
+  return _epoch + (millis() / 1000);
+}
+
+Client & ConnectionHandler::getClient()
+{
+  return _client;
+}
+
+UDP & ConnectionHandler::getUDP()
+{
+  return _udp;
+}
+
+int ConnectionHandler::write(uint8_t const * buf, size_t const size)
+{
+  _write_attempt_cnt++;
+  if (_write_result >= 0)
+    _uplinks.push_back(std::vector<uint8_t>(buf, buf + size));
+  return _write_result;
+}
+
+int ConnectionHandler::read()
+{
+  if (_downlink.empty())
+    return -1;
+  int const data = _downlink.front();
+  _downlink.pop_front();
+  return data;
+}
+
+bool ConnectionHandler::available()
+{
+  return !_downlink.empty();
+}
+
+void ConnectionHandler::setStatus(NetworkConnectionState const status)
+{
+  _status = status;
+}
+
+void ConnectionHandler::setTime(unsigned long const epoch)
+{
+  _epoch = epoch;
+}
+
+void ConnectionHandler::setWriteResult(int const result)
+{
+  _write_result = result;
+}
+
+void ConnectionHandler::pushDownlink(std::vector<uint8_t> const & msg)
+{
+  _downlink.insert(_downlink.end(), msg.begin(), msg.end());
+}
+
+void ConnectionHandler::reset()
+{
+  _status = NetworkConnectionState::CONNECTED;
+  _epoch = DEFAULT_EPOCH;
+  _write_result = 0;
+  _write_attempt_cnt = 0;
+  _uplinks.clear();
+  _downlink.clear();
+}
@@ -0,0 +1,15 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <Arduino_DebugUtils.h>
+
+/******************************************************************************
+   GLOBAL VARIABLES
+ ******************************************************************************/
+
+Arduino_DebugUtils Debug;
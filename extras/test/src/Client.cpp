@@ -0,0 +1,45 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <Client.h>
+
+#include <util/FakeBroker.h>
+
+/******************************************************************************
+   CTOR/DTOR
+ ******************************************************************************/
+
+Client::Client()
+: _is_connected{false}
+, _connect_cnt{0}
+{
+
+}
+
+/******************************************************************************
+   PUBLIC MEMBER FUNCTIONS
+ ******************************************************************************/
+
+int Client::connect(char const * /* host */, uint16_t const /* port */)
+{
+  _connect_cnt++;
+  _is_connected = FakeBroker::instance().isOnline();
+  return _is_connected ? 1 : 0;
+}
+
+uint8_t Client::connected()
+{
+  if (!FakeBroker::instance().isOnline())
+    _is_connected = false;
+  return _is_connected ? 1 : 0;
+}
+
+void Client::stop()
+{
+  _is_connected = false;
+}
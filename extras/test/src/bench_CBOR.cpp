@@ -0,0 +1,217 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <util/BenchmarkUtil.h>
+
+#include <deque>
+#include <memory>
+
+#include <CBOREncoder.h>
+#include <CBORDecoder.h>
+#include <FloatRegistry.h>
+#include "types/CloudColor.h"
+#include "types/CloudWrapperBool.h"
+#include "types/CloudWrapperFloat.h"
+#include "types/CloudWrapperInt.h"
+#include "types/CloudWrapperString.h"
+#include "types/automation/CloudTelevision.h"
+#include <utility/color/ColorConversion.h>
+
+/**************************************************************************************
+   CONSTANTS
+ **************************************************************************************/
+
+static size_t const PROPERTY_COUNT[] = {1, 10, 100, 500};
+
+/* Number of float properties whose change detection is benchmarked. */
+static size_t const FLOAT_REGISTRY_SIZE = 500;
+
+/* Number of LEDs whose colors are converted from HSB to RGB. */
+static size_t const LED_COUNT = 300;
+
+/* The light payload encodes the property identifier into the lower 8 bit. */
+static size_t const MAX_LIGHT_PAYLOAD_PROPERTY_COUNT = 255;
+
+/**************************************************************************************
+   TYPEDEF
+ **************************************************************************************/
+
+/* A container holding 'count' properties of the same type which are encoded
+ * on every call to encode(). The properties are published on demand and an
+ * update of all of them is requested before each encoding.
+ */
+class Fixture
+{
+public:
+
+  typedef std::function<Property * (Fixture & fixture)> PropertyFactory;
+
+  Fixture(PropertyFactory const & factory, size_t const count)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      _property.emplace_back(factory(*this));
+      addPropertyToContainer(_container, *_property.back(), "property_" + std::to_string(i), Permission::ReadWrite, static_cast<int>(i) + 1).publishOnDemand();
+    }
+  }
+
+  size_t encode(bool const light_payload)
+  {
+    requestUpdateForAllProperties(_container);
+    int bytes_encoded = 0;
+    CBOREncoder::encode(_container, _buf, sizeof(_buf), bytes_encoded, light_payload);
+    return bytes_encoded;
+  }
+
+  size_t decode(uint8_t const * payload, size_t const length)
+  {
+    CBORDecoder::decode(_container, payload, length);
+    return length;
+  }
+
+  std::deque<bool>   bool_values;
+  std::deque<int>    int_values;
+  std::deque<float>  float_values;
+  std::deque<String> string_values;
+
+  inline uint8_t const * buf() const { return _buf; }
+
+private:
+
+  PropertyContainer _container;
+  std::deque<std::unique_ptr<Property>> _property;
+  uint8_t _buf[128 * 1024];
+};
+
+struct PropertyType
+{
+  char const * name;
+  Fixture::PropertyFactory factory;
+};
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+static std::vector<PropertyType> const & types()
+{
+  static std::vector<PropertyType> const TYPES =
+  {
+    {"CloudWrapperBool",   [](Fixture & f) -> Property * { f.bool_values.push_back(true);        return new CloudWrapperBool(f.bool_values.back()); }},
+    {"CloudWrapperInt",    [](Fixture & f) -> Property * { f.int_values.push_back(1234);         return new CloudWrapperInt(f.int_values.back()); }},
+    {"CloudWrapperFloat",  [](Fixture & f) -> Property * { f.float_values.push_back(3.1415f);    return new CloudWrapperFloat(f.float_values.back()); }},
+    {"CloudWrapperString", [](Fixture & f) -> Property * { f.string_values.push_back("a value"); return new CloudWrapperString(f.string_values.back()); }},
+    {"CloudColor",         [](Fixture &)   -> Property * { return new CloudColor(120.0f, 50.0f, 80.0f); }},
+    {"CloudTelevision",    [](Fixture &)   -> Property * { return new CloudTelevision(); }},
+  };
+  return TYPES;
+}
+
+/**************************************************************************************
+   PUBLIC FUNCTIONS
+ **************************************************************************************/
+
+std::vector<bench::Result> benchmarkCBOR(std::string const & filter, unsigned long const min_duration_ms)
+{
+  std::vector<bench::Result> results;
+
+  for (PropertyType const & type : types())
+  {
+    for (size_t const count : PROPERTY_COUNT)
+    {
+      for (bool const light_payload : {false, true})
+      {
+        if (light_payload && (count > MAX_LIGHT_PAYLOAD_PROPERTY_COUNT))
+          continue;
+
+        std::string const suffix = std::string("/") + type.name + "/" + std::to_string(count) + (light_payload ? "/light" : "/full");
+        std::string const encode_name = "encode" + suffix;
+        std::string const decode_name = "decode" + suffix;
+
+        Fixture fixture(type.factory, count);
+
+        if (encode_name.find(filter) != std::string::npos)
+          results.push_back(bench::measure(encode_name, [&fixture, light_payload]() { return fixture.encode(light_payload); }, min_duration_ms));
+
+        if (decode_name.find(filter) != std::string::npos)
+        {
+          size_t const length = fixture.encode(light_payload);
+          std::vector<uint8_t> const payload(fixture.buf(), fixture.buf() + length);
+          results.push_back(bench::measure(decode_name, [&fixture, &payload]() { return fixture.decode(payload.data(), payload.size()); }, min_duration_ms));
+        }
+      }
+    }
+  }
+
+  /* Change detection of float properties, none of which has changed: a call of
+   * isDifferentFromCloud() per wrapper vs. a single FloatRegistry::scan().
+   */
+  std::deque<float> float_values(FLOAT_REGISTRY_SIZE, 3.1415f);
+  std::vector<std::unique_ptr<CloudWrapperFloat>> wrapper;
+  std::vector<std::unique_ptr<CloudWrapperFloat>> attached_wrapper;
+  std::unique_ptr<StaticFloatRegistry<FLOAT_REGISTRY_SIZE>> registry(new StaticFloatRegistry<FLOAT_REGISTRY_SIZE>());
+  for (float & value : float_values)
+  {
+    wrapper.emplace_back(new CloudWrapperFloat(value));
+    attached_wrapper.emplace_back(new CloudWrapperFloat(value));
+    attached_wrapper.back()->attach(*registry);
+  }
+
+  std::string const detect_name = "detect/CloudWrapperFloat/" + std::to_string(FLOAT_REGISTRY_SIZE);
+  if (detect_name.find(filter) != std::string::npos)
+  {
+    results.push_back(bench::measure(detect_name, [&wrapper]()
+    {
+      size_t changed_cnt = 0;
+      for (std::unique_ptr<CloudWrapperFloat> const & w : wrapper)
+        changed_cnt += w->isDifferentFromCloud() ? 1 : 0;
+      return changed_cnt;
+    }, min_duration_ms));
+  }
+
+  std::string const scan_name = "detect/FloatRegistry/" + std::to_string(FLOAT_REGISTRY_SIZE);
+  if (scan_name.find(filter) != std::string::npos)
+    results.push_back(bench::measure(scan_name, [&registry]() { return registry->scan(); }, min_duration_ms));
+
+  /* HSB to RGB conversion of a LED strip: Color::getRGB() per LED vs. a single
+   * call of the integer batch conversion.
+   */
+  std::vector<Color> colors;
+  std::vector<uint16_t> hue(LED_COUNT), sat(LED_COUNT), bri(LED_COUNT);
+  std::vector<uint8_t> rgb(3 * LED_COUNT);
+  for (size_t i = 0; i < LED_COUNT; i++)
+  {
+    colors.push_back(Color(i * 360.0f / LED_COUNT, 80.0f, 60.0f));
+    hue[i] = i * COLOR_HUE_MAX / LED_COUNT;
+    sat[i] = COLOR_UNIT * 8 / 10;
+    bri[i] = COLOR_UNIT * 6 / 10;
+  }
+
+  std::string const color_name = "color/Color::getRGB/" + std::to_string(LED_COUNT);
+  if (color_name.find(filter) != std::string::npos)
+  {
+    results.push_back(bench::measure(color_name, [&colors, &rgb]()
+    {
+      for (size_t i = 0; i < colors.size(); i++)
+        colors[i].getRGB(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+      return rgb.size();
+    }, min_duration_ms));
+  }
+
+  std::string const batch_name = "color/hsbToRgb/" + std::to_string(LED_COUNT);
+  if (batch_name.find(filter) != std::string::npos)
+  {
+    results.push_back(bench::measure(batch_name, [&hue, &sat, &bri, &rgb]()
+    {
+      hsbToRgb(hue.data(), sat.data(), bri.data(), rgb.data(), LED_COUNT);
+      return rgb.size();
+    }, min_duration_ms));
+  }
+
+  return results;
+}
@@ -0,0 +1,88 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <util/BenchmarkUtil.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**************************************************************************************
+   FUNCTION DECLARATION
+ **************************************************************************************/
+
+std::vector<bench::Result> benchmarkCBOR(std::string const & filter, unsigned long const min_duration_ms);
+
+extern "C" unsigned long getTime()
+{
+  return 0;
+}
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+static void usage(char const * name)
+{
+  printf("Usage: %s [options]\n", name);
+  printf("  --filter <text>          only run benchmarks whose name contains <text>\n");
+  printf("  --min-time <ms>          minimum duration of each measurement round (default 10)\n");
+  printf("  --baseline <file>        compare against a baseline, exit with 1 on regressions\n");
+  printf("  --tolerance <percent>    allowed slow down against the baseline (default 50, < 0 ignores timing)\n");
+  printf("  --write-baseline <file>  write the results as new baseline\n");
+}
+
+/**************************************************************************************
+   MAIN
+ **************************************************************************************/
+
+int main(int argc, char ** argv)
+{
+  std::string filter, baseline_file, write_baseline_file;
+  unsigned long min_duration_ms = 10;
+  double tolerance_percent = 50.0;
+
+  for (int i = 1; i < argc; i++)
+  {
+    bool const has_arg = (i + 1) < argc;
+    if      (!strcmp(argv[i], "--filter")         && has_arg) filter = argv[++i];
+    else if (!strcmp(argv[i], "--min-time")       && has_arg) min_duration_ms = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--baseline")       && has_arg) baseline_file = argv[++i];
+    else if (!strcmp(argv[i], "--tolerance")      && has_arg) tolerance_percent = strtod(argv[++i], nullptr);
+    else if (!strcmp(argv[i], "--write-baseline") && has_arg) write_baseline_file = argv[++i];
+    else
+    {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  std::vector<bench::Result> const results = benchmarkCBOR(filter, min_duration_ms);
+  bench::print(results);
+
+  if (!write_baseline_file.empty() && !bench::writeBaseline(write_baseline_file, results))
+  {
+    printf("could not write baseline '%s'\n", write_baseline_file.c_str());
+    return 2;
+  }
+
+  if (!baseline_file.empty())
+  {
+    std::map<std::string, bench::Result> baseline;
+    if (!bench::readBaseline(baseline_file, baseline))
+    {
+      printf("could not read baseline '%s'\n", baseline_file.c_str());
+      return 2;
+    }
+    size_t const regression_cnt = bench::compare(results, baseline, tolerance_percent);
+    printf("%zu regression(s) against '%s'\n", regression_cnt, baseline_file.c_str());
+    return (regression_cnt > 0) ? 1 : 0;
+  }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <CBORDecoder.h>
+#include "types/CloudBool.h"
+#include "types/CloudColor.h"
+#include "types/CloudFloat.h"
+#include "types/CloudInt.h"
+#include "types/CloudLocation.h"
+#include "types/CloudString.h"
+#include "types/automation/CloudColoredLight.h"
+#include "types/automation/CloudContactSensor.h"
+#include "types/automation/CloudDimmedLight.h"
+#include "types/automation/CloudLight.h"
+#include "types/automation/CloudMotionSensor.h"
+#include "types/automation/CloudSmartPlug.h"
+#include "types/automation/CloudSwitch.h"
+#include "types/automation/CloudTelevision.h"
+#include "types/automation/CloudTemperatureSensor.h"
+
+/**************************************************************************************
+   TYPEDEF
+ **************************************************************************************/
+
+/* A container with the property names used by test_decode.cpp (from which the
+ * seed corpus is extracted). 'test' has the identifier 1 for light payloads and
+ * is of a different type in each fixture. Fixtures are never destroyed since
+ * Property has no virtual destructor.
+ */
+class Fixture
+{
+public:
+
+  Fixture(Property * test)
+  : _test{test}
+  {
+    addPropertyToContainer(_container, *_test,       "test",       Permission::ReadWrite, 1);
+    addPropertyToContainer(_container, _bool_test,   "bool_test",  Permission::ReadWrite, 2).onSync(CLOUD_WINS);
+    addPropertyToContainer(_container, _int_test,    "int_test",   Permission::ReadWrite, 3).onSync(CLOUD_WINS);
+    addPropertyToContainer(_container, _float_test,  "float_test", Permission::ReadWrite, 4).onSync(CLOUD_WINS);
+    addPropertyToContainer(_container, _str_test,    "str_test",   Permission::ReadWrite, 5).onSync(CLOUD_WINS);
+    addPropertyToContainer(_container, _str[0],      "str_1",      Permission::ReadWrite, 6);
+    addPropertyToContainer(_container, _str[1],      "str_2",      Permission::ReadWrite, 7);
+    addPropertyToContainer(_container, _str[2],      "str_3",      Permission::ReadWrite, 8);
+    addPropertyToContainer(_container, _str[3],      "str_4",      Permission::Read,      9);
+  }
+
+  void decode(uint8_t const * data, size_t const size)
+  {
+    CBORDecoder::decode(_container, data, size, false);
+    CBORDecoder::decode(_container, data, size, true);
+  }
+
+private:
+
+  PropertyContainer _container;
+  Property * _test;
+  CloudBool _bool_test;
+  CloudInt _int_test;
+  CloudFloat _float_test;
+  CloudString _str_test;
+  CloudString _str[4];
+};
+
+/**************************************************************************************
+   FUZZ TARGET
+ **************************************************************************************/
+
+extern "C" unsigned long getTime()
+{
+  return 0;
+}
+
+/* Every input is decoded into each fixture, both as regular and as sync message. */
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const * data, size_t size)
+{
+  static Fixture * const fixture[] =
+  {
+    new Fixture(new CloudBool),
+    new Fixture(new CloudInt),
+    new Fixture(new CloudFloat),
+    new Fixture(new CloudString),
+    new Fixture(new CloudLocation),
+    new Fixture(new CloudColor),
+    new Fixture(new CloudColoredLight),
+    new Fixture(new CloudContactSensor),
+    new Fixture(new CloudDimmedLight),
+    new Fixture(new CloudLight),
+    new Fixture(new CloudMotionSensor),
+    new Fixture(new CloudSmartPlug),
+    new Fixture(new CloudSwitch),
+    new Fixture(new CloudTelevision),
+    new Fixture(new CloudTemperatureSensor)
+  };
+
+  for (Fixture * f : fixture)
+    f->decode(data, size);
+  return 0;
+}
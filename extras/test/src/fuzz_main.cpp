@@ -0,0 +1,267 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/* Standalone driver for the fuzz targets, used when the compiler does not provide
+ * libFuzzer (i.e. gcc). It accepts the same command line as libFuzzer, so that
+ *
+ *   bin/fuzzCBORDecoder -runs=100000 corpus/CBORDecoder
+ *
+ * works with either build. Every input found in the given files or directories is
+ * executed once, then '-runs' randomly mutated inputs derived from them. Contrary
+ * to libFuzzer the mutations are not coverage guided, for coverage guided fuzzing
+ * build with FUZZ_WITH_LIBFUZZER=ON (clang) or use AFL, i.e.
+ *
+ *   afl-fuzz -i corpus/CBORDecoder -o findings -- bin/fuzzCBORDecoder @@
+ *
+ * An input which crashes the target (detected by the sanitizers or a failed
+ * assertion) is written to 'crash-input', inputs which take longer than
+ * '-timeout_ms' to 'slow-<n>'.
+ */
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <dirent.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+/**************************************************************************************
+   TYPEDEF
+ **************************************************************************************/
+
+typedef std::vector<uint8_t> Input;
+
+/**************************************************************************************
+   FUNCTION DECLARATION
+ **************************************************************************************/
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const * data, size_t size);
+
+/**************************************************************************************
+   GLOBAL VARIABLES
+ **************************************************************************************/
+
+static Input const * current_input = nullptr;
+
+/* Values which are likely to change the structure of a CBOR message: small
+ * integers (map keys), headers of strings, arrays and maps of various
+ * lengths, additional length bytes, simple values and the break marker.
+ */
+static uint8_t const INTERESTING_BYTES[] =
+{
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1F,
+  0x20, 0x38, 0x3B, 0x40, 0x5F, 0x60, 0x61, 0x64, 0x78, 0x7B, 0x7F,
+  0x80, 0x81, 0x82, 0x98, 0x9F, 0xA0, 0xA1, 0xA2, 0xB8, 0xBF,
+  0xC1, 0xF4, 0xF5, 0xF6, 0xF7, 0xF9, 0xFA, 0xFB, 0xFF
+};
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+static bool writeFile(std::string const & filename, Input const & input)
+{
+  FILE * file = fopen(filename.c_str(), "wb");
+  if (!file)
+    return false;
+  bool const success = fwrite(input.data(), 1, input.size(), file) == input.size();
+  fclose(file);
+  return success;
+}
+
+static bool readFile(std::string const & filename, Input & input)
+{
+  FILE * file = fopen(filename.c_str(), "rb");
+  if (!file)
+    return false;
+  uint8_t buf[256];
+  size_t bytes_read;
+  input.clear();
+  while ((bytes_read = fread(buf, 1, sizeof(buf), file)) > 0)
+    input.insert(input.end(), buf, buf + bytes_read);
+  fclose(file);
+  return true;
+}
+
+static bool readCorpus(std::string const & path, std::vector<Input> & corpus)
+{
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0)
+    return false;
+
+  if (!S_ISDIR(st.st_mode))
+  {
+    corpus.emplace_back();
+    return readFile(path, corpus.back());
+  }
+
+  DIR * dir = opendir(path.c_str());
+  if (!dir)
+    return false;
+  for (struct dirent * entry = readdir(dir); entry; entry = readdir(dir))
+  {
+    if (entry->d_name[0] == '.')
+      continue;
+    corpus.emplace_back();
+    if (!readFile(path + "/" + entry->d_name, corpus.back()))
+      corpus.pop_back();
+  }
+  closedir(dir);
+  return true;
+}
+
+static void onDeath()
+{
+  if (current_input && writeFile("crash-input", *current_input))
+    fprintf(stderr, "input written to 'crash-input'\n");
+}
+
+/* Failed assertions, i.e. within tinycbor, abort without the sanitizers. */
+static void onAbort(int sig)
+{
+#if defined(__SANITIZE_ADDRESS__)
+  __sanitizer_print_stack_trace();
+#endif
+  onDeath();
+  signal(sig, SIG_DFL);
+  raise(sig);
+}
+
+static void mutate(Input & input, std::vector<Input> const & corpus, size_t const max_len, std::mt19937 & rng)
+{
+  unsigned int const mutation_cnt = 1 + rng() % 4;
+  for (unsigned int m = 0; m < mutation_cnt; m++)
+  {
+    size_t const pos = input.empty() ? 0 : rng() % input.size();
+    switch (rng() % 8)
+    {
+      case 0: if (!input.empty()) input[pos] ^= static_cast<uint8_t>(1 << (rng() % 8)); break;
+      case 1: if (!input.empty()) input[pos] = static_cast<uint8_t>(rng()); break;
+      case 2: if (!input.empty()) input[pos] = INTERESTING_BYTES[rng() % sizeof(INTERESTING_BYTES)]; break;
+      case 3: input.insert(input.begin() + pos, INTERESTING_BYTES[rng() % sizeof(INTERESTING_BYTES)]); break;
+      case 4: if (!input.empty()) input.erase(input.begin() + pos, input.begin() + pos + 1 + rng() % (input.size() - pos)); break;
+      case 5: /* Duplicate a range, i.e. a complete map. */
+        if (!input.empty())
+        {
+          size_t const len = 1 + rng() % (input.size() - pos);
+          Input const range(input.begin() + pos, input.begin() + pos + len);
+          input.insert(input.begin() + rng() % (input.size() + 1), range.begin(), range.end());
+        }
+        break;
+      case 6: /* Splice with another input of the corpus. */
+        {
+          Input const & other = corpus[rng() % corpus.size()];
+          size_t const other_pos = other.empty() ? 0 : rng() % other.size();
+          input.resize(pos);
+          input.insert(input.end(), other.begin() + other_pos, other.end());
+        }
+        break;
+      case 7: /* Replace with a large integer. */
+        {
+          uint8_t const large_int[] = {0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+          size_t const len = 1 + rng() % sizeof(large_int);
+          input.insert(input.begin() + pos, large_int, large_int + len);
+        }
+        break;
+    }
+  }
+
+  if (input.size() > max_len)
+    input.resize(max_len);
+}
+
+static void usage(char const * name)
+{
+  printf("Usage: %s [options] <file or directory>...\n", name);
+  printf("  -runs=<n>        number of mutated inputs to execute (default 0)\n");
+  printf("  -seed=<n>        seed of the mutations (default 1)\n");
+  printf("  -max_len=<n>     maximum length of a mutated input (default 1024)\n");
+  printf("  -timeout_ms=<n>  report inputs taking longer than <n> ms (default 100)\n");
+}
+
+/**************************************************************************************
+   MAIN
+ **************************************************************************************/
+
+int main(int argc, char ** argv)
+{
+  typedef std::chrono::steady_clock Clock;
+
+  unsigned long runs = 0, seed = 1, max_len = 1024, timeout_ms = 100;
+  std::vector<Input> corpus;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if      (!strncmp(argv[i], "-runs=",       6)) runs       = strtoul(argv[i] +  6, nullptr, 10);
+    else if (!strncmp(argv[i], "-seed=",       6)) seed       = strtoul(argv[i] +  6, nullptr, 10);
+    else if (!strncmp(argv[i], "-max_len=",    9)) max_len    = strtoul(argv[i] +  9, nullptr, 10);
+    else if (!strncmp(argv[i], "-timeout_ms=",12)) timeout_ms = strtoul(argv[i] + 12, nullptr, 10);
+    else if (argv[i][0] == '-')
+    {
+      usage(argv[0]);
+      return 2;
+    }
+    else if (!readCorpus(argv[i], corpus))
+    {
+      printf("could not read '%s'\n", argv[i]);
+      return 2;
+    }
+  }
+
+  if (corpus.empty())
+    corpus.emplace_back();
+
+#if defined(__SANITIZE_ADDRESS__)
+  __sanitizer_set_death_callback(onDeath);
+#endif
+  signal(SIGABRT, onAbort);
+
+  std::mt19937 rng(seed);
+  Clock::duration max_duration = Clock::duration::zero();
+  unsigned long slow_cnt = 0;
+
+  for (unsigned long i = 0; i < corpus.size() + runs; i++)
+  {
+    Input input = corpus[i % corpus.size()];
+    if (i >= corpus.size())
+      mutate(input, corpus, max_len, rng);
+
+    current_input = &input;
+    Clock::time_point const start = Clock::now();
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+    Clock::duration const duration = Clock::now() - start;
+    current_input = nullptr;
+
+    if (duration > max_duration)
+      max_duration = duration;
+
+    if (duration > std::chrono::milliseconds(timeout_ms))
+    {
+      std::string const filename = "slow-" + std::to_string(slow_cnt++);
+      writeFile(filename, input);
+      printf("input of %zu bytes took %lld ms, written to '%s'\n", input.size(),
+             static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()), filename.c_str());
+    }
+  }
+
+  printf("executed %lu inputs (%zu from corpus), slowest input took %lld us\n", corpus.size() + runs, corpus.size(),
+         static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(max_duration).count()));
+  fflush(stdout);
+
+  return (slow_cnt > 0) ? 1 : 0;
+}
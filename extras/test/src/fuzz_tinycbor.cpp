@@ -0,0 +1,93 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <stdlib.h>
+
+#include <cbor/lib/tinycbor/cbor-lib.h>
+
+/**************************************************************************************
+   CONSTANTS
+ **************************************************************************************/
+
+/* Limits the recursion of walk() in the same way as CborValidateBasic does. */
+static int const MAX_NESTING_LEVEL = 64;
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+/* Visits every value using the functions called by CBORDecoder. */
+static CborError walk(CborValue * it, int const nesting_level)
+{
+  while (!cbor_value_at_end(it))
+  {
+    CborError err = CborNoError;
+
+    if (cbor_value_is_container(it))
+    {
+      if (nesting_level >= MAX_NESTING_LEVEL)
+        return CborErrorNestingTooDeep;
+
+      CborValue child;
+      if ((err = cbor_value_enter_container(it, &child)) != CborNoError)
+        return err;
+      if ((err = walk(&child, nesting_level + 1)) != CborNoError)
+        return err;
+      if ((err = cbor_value_leave_container(it, &child)) != CborNoError)
+        return err;
+    }
+    else if (cbor_value_is_text_string(it))
+    {
+      char * str = nullptr;
+      size_t len = 0;
+      if ((err = cbor_value_dup_text_string(it, &str, &len, it)) != CborNoError)
+        return err;
+      free(str);
+    }
+    else
+    {
+      int i;
+      bool b;
+      float f;
+      double d;
+      if      (cbor_value_is_integer(it)) cbor_value_get_int(it, &i);
+      else if (cbor_value_is_boolean(it)) cbor_value_get_boolean(it, &b);
+      else if (cbor_value_is_float  (it)) cbor_value_get_float(it, &f);
+      else if (cbor_value_is_double (it)) cbor_value_get_double(it, &d);
+
+      if ((err = cbor_value_advance(it)) != CborNoError)
+        return err;
+    }
+  }
+  return CborNoError;
+}
+
+/**************************************************************************************
+   FUZZ TARGET
+ **************************************************************************************/
+
+extern "C" unsigned long getTime()
+{
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const * data, size_t size)
+{
+  CborParser parser;
+  CborValue it;
+
+  if (cbor_parser_init(data, size, 0, &parser, &it) != CborNoError)
+    return 0;
+
+  CborValue validate_it = it;
+  cbor_value_validate(&validate_it, CborValidateStrictMode);
+
+  walk(&it, 0);
+
+  return 0;
+}
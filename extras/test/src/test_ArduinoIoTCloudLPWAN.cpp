@@ -0,0 +1,299 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <new>
+#include <vector>
+
+#include <ArduinoIoTCloud.h>
+#include <Arduino_ConnectionHandler.h>
+
+/**************************************************************************************
+   CONSTANTS
+ **************************************************************************************/
+
+static unsigned long const UPDATE_INTERVAL_ms = 10;
+
+/**************************************************************************************
+   GLOBAL VARIABLES
+ **************************************************************************************/
+
+static ConnectionHandler connection;
+
+static int counter, level, alarm;
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+/* {0: id, 2: value} for 0 <= value < 24 */
+static std::vector<uint8_t> encodeInt(uint8_t const id, uint8_t const value)
+{
+  return {0xA2, 0x00, id, 0x02, value};
+}
+
+static std::vector<uint8_t> encodeArray(std::vector<std::vector<uint8_t>> const & items)
+{
+  std::vector<uint8_t> msg = {0x9F};
+  for (auto const & item : items)
+    msg.insert(msg.end(), item.begin(), item.end());
+  msg.push_back(0xFF);
+  return msg;
+}
+
+static uint8_t getSpreadingFactor()
+{
+  return 7;
+}
+
+/* Unless stated otherwise the duty cycle does not restrict the uplinks. */
+static void begin(bool const retry, uint16_t const duty_cycle_permille = 1000)
+{
+  ArduinoCloud.~ArduinoIoTCloudLPWAN();
+  new (&ArduinoCloud) ArduinoIoTCloudLPWAN();
+
+  connection.reset();
+  set_millis(0);
+
+  counter = level = alarm = 0;
+
+  ArduinoCloud.setThingId("thing");
+  ArduinoCloud.begin(connection, retry);
+  ArduinoCloud.setMaxRetry(3);
+  ArduinoCloud.setIntervalRetry(1000);
+  ArduinoCloud.setSpreadingFactorFunc(getSpreadingFactor);
+  ArduinoCloud.setDutyCycle(&duty_cycle_permille, 1);
+  ArduinoCloud.addProperty(counter, 1, Permission::ReadWrite);
+  ArduinoCloud.addProperty(level,   2, Permission::ReadWrite);
+}
+
+static void run(unsigned long const duration_ms)
+{
+  for (unsigned long t = 0; t < duration_ms; t += UPDATE_INTERVAL_ms)
+  {
+    set_millis(millis() + UPDATE_INTERVAL_ms);
+    ArduinoCloud.update();
+  }
+}
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("A LoRa device retries a failed uplink without blocking", "[ArduinoIoTCloudLPWAN]")
+{
+  begin(true);
+  run(1000);
+  REQUIRE(connection.uplinks().size() == 1);
+  REQUIRE(connection.uplinks().back() == encodeArray({encodeInt(1, 0), encodeInt(2, 0)}));
+
+  WHEN("An uplink fails")
+  {
+    connection.setWriteResult(-1);
+    counter = 3;
+    unsigned long const start_ms = millis();
+    run(UPDATE_INTERVAL_ms);
+
+    THEN("update() returns immediately and the uplink is retried later")
+    {
+      REQUIRE(millis() - start_ms == UPDATE_INTERVAL_ms);
+      REQUIRE(connection.getWriteAttempts() == 2);
+      REQUIRE(ArduinoCloud.getLastWriteResult() == -1);
+      REQUIRE(ArduinoCloud.isRetryPending() == true);
+    }
+
+    THEN("the uplink is sent as soon as a retry succeeds")
+    {
+      run(1000);
+      REQUIRE(connection.getWriteAttempts() == 3);
+      connection.setWriteResult(0);
+      run(1000);
+      REQUIRE(connection.getWriteAttempts() == 4);
+      REQUIRE(connection.uplinks().size() == 2);
+      REQUIRE(connection.uplinks().back() == encodeArray({encodeInt(1, 3)}));
+      REQUIRE(ArduinoCloud.getLastWriteResult() == 0);
+      REQUIRE(ArduinoCloud.isRetryPending() == false);
+      REQUIRE(ArduinoCloud.getStats().retransmits == 2);
+      REQUIRE(ArduinoCloud.getStats().publish_failures == 0);
+    }
+
+    THEN("a property changed meanwhile is appended to the pending uplink")
+    {
+      level = 4;
+      run(500);
+      connection.setWriteResult(0);
+      run(1000);
+      REQUIRE(connection.uplinks().size() == 2);
+      REQUIRE(connection.uplinks().back() == encodeArray({encodeInt(1, 3), encodeInt(2, 4)}));
+    }
+
+    THEN("properties changed meanwhile are merged into the pending uplink, replacing older values")
+    {
+      level = 4;
+      run(500);
+      counter = 5;
+      connection.setWriteResult(0);
+      run(1000);
+      REQUIRE(connection.uplinks().size() == 2);
+      REQUIRE(connection.uplinks().back() == encodeArray({encodeInt(2, 4), encodeInt(1, 5)}));
+      REQUIRE(ArduinoCloud.getStats().messages_out == 2);
+    }
+
+    THEN("the uplink is dropped after the maximum number of retries")
+    {
+      run(10000);
+      REQUIRE(connection.getWriteAttempts() == 1 + 1 + 3);
+      REQUIRE(ArduinoCloud.isRetryPending() == false);
+      REQUIRE(ArduinoCloud.getStats().publish_failures == 1);
+    }
+  }
+}
+
+SCENARIO("A LoRa device with disabled retries drops a failed uplink", "[ArduinoIoTCloudLPWAN]")
+{
+  begin(false);
+  run(1000);
+
+  WHEN("An uplink fails")
+  {
+    connection.setWriteResult(-1);
+    counter = 3;
+    run(10000);
+
+    THEN("it is not retried")
+    {
+      REQUIRE(connection.getWriteAttempts() == 2);
+      REQUIRE(ArduinoCloud.isRetryPending() == false);
+      REQUIRE(ArduinoCloud.getLastWriteResult() == -1);
+      REQUIRE(ArduinoCloud.getStats().publish_failures == 1);
+    }
+  }
+}
+
+SCENARIO("A LoRa device respects the duty cycle", "[ArduinoIoTCloudLPWAN]")
+{
+  /* 12 bytes payload at SF7 take 61.7 ms, at 1 % the next uplink is possible after 6.2 s. */
+  begin(false, 10);
+  run(1000);
+  REQUIRE(connection.uplinks().size() == 1);
+
+  WHEN("Properties change while the duty cycle is used up")
+  {
+    for (int value = 1; value <= 5; value++)
+    {
+      counter = value;
+      run(1000);
+    }
+    size_t const uplink_cnt = connection.uplinks().size();
+    run(1000);
+
+    THEN("no uplink is attempted until the duty cycle allows it and then only the latest value is sent")
+    {
+      REQUIRE(uplink_cnt == 1);
+      REQUIRE(connection.getWriteAttempts() == 2);
+      REQUIRE(connection.uplinks().back() == encodeArray({encodeInt(1, 5)}));
+      REQUIRE(ArduinoCloud.getDutyCycle().getConsumedAirtime(0) == DutyCycleScheduler::computeAirtime(12, 7) + DutyCycleScheduler::computeAirtime(7, 7));
+    }
+  }
+
+  WHEN("More properties changed than fit into the next uplink")
+  {
+    ArduinoCloud.addProperty(alarm, 3, Permission::Read).priority(1);
+    ArduinoCloud.setMaxPayloadSizeFunc([]() -> size_t { return 12; });
+    counter = 1;
+    level = 2;
+    alarm = 3;
+    run(7000);
+
+    THEN("the properties with the highest priority are sent first")
+    {
+      REQUIRE(connection.uplinks().size() == 2);
+      REQUIRE(connection.uplinks().back() == encodeArray({encodeInt(3, 3), encodeInt(1, 1)}));
+    }
+  }
+}
+
+SCENARIO("A LoRa device sends packed uplinks", "[ArduinoIoTCloudLPWAN]")
+{
+  begin(false);
+  ArduinoCloud.setPackedEncoding(true);
+  run(1000);
+
+  WHEN("The properties are sent for the first time")
+  {
+    THEN("the uplink is a packed keyframe of both counter and level")
+    {
+      std::vector<uint8_t> const expected = {0xFC, 0x50, 0x00, 0x40, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00};
+      REQUIRE(connection.uplinks().size() == 1);
+      REQUIRE(connection.uplinks().back() == expected);
+    }
+
+    THEN("the schema needed to decode the uplinks can be exported")
+    {
+      char schema[64];
+      REQUIRE(ArduinoCloud.printPackedSchema(schema, sizeof(schema)) == 41);
+      REQUIRE(std::string(schema) == "packed 2 2\n1 counter 1 0 i\n2 level 2 0 i\n");
+    }
+  }
+
+  WHEN("A property changes afterwards")
+  {
+    counter = 3;
+    run(1000);
+
+    THEN("only the delta to the value sent last is transmitted")
+    {
+      std::vector<uint8_t> const expected = {0xFC, 0x40, 0x01, 0x60, 0x00, 0x60};
+      REQUIRE(connection.uplinks().size() == 2);
+      REQUIRE(connection.uplinks().back() == expected);
+    }
+  }
+
+  WHEN("A packed uplink is dropped")
+  {
+    connection.setWriteResult(-1);
+    counter = 3;
+    run(1000);
+    connection.setWriteResult(0);
+    counter = 4;
+    run(1000);
+
+    THEN("the next uplink is a keyframe which does not refer to the dropped one")
+    {
+      std::vector<uint8_t> const expected = {0xFC, 0x50, 0x00, 0x40, 0x00, 0x00, 0x00, 0x80};
+      REQUIRE(connection.uplinks().size() == 2);
+      REQUIRE(connection.uplinks().back() == expected);
+    }
+  }
+}
+
+SCENARIO("A LoRa device receives a message split across several downlinks", "[ArduinoIoTCloudLPWAN]")
+{
+  begin(false);
+  run(1000);
+
+  WHEN("The fragments arrive one after the other")
+  {
+    /* [{0: 1, 2: 7}, {0: 2, 2: 9}] = 82 A2 00 01 02 07 A2 00 02 02 09 */
+    connection.pushDownlink({0xFD, 0x00, 0x82, 0xA2, 0x00, 0x01, 0x02});
+    run(1000);
+    int const counter_after_first_fragment = counter;
+    connection.pushDownlink({0xFD, 0x11, 0x07, 0xA2, 0x00, 0x02, 0x02, 0x09});
+    run(1000);
+
+    THEN("the message is decoded once the last fragment has been received")
+    {
+      REQUIRE(counter_after_first_fragment == 0);
+      REQUIRE(counter == 7);
+      REQUIRE(level == 9);
+      REQUIRE(ArduinoCloud.getStats().messages_in == 2);
+      REQUIRE(ArduinoCloud.getDownlinkReassembler().getDiscardedCount() == 0);
+    }
+  }
+}
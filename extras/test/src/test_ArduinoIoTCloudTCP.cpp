@@ -0,0 +1,470 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <iterator>
+#include <new>
+#include <vector>
+
+#include <ArduinoIoTCloud.h>
+#include <Arduino_ConnectionHandler.h>
+
+#include <util/AllocationTracker.h>
+#include <util/FakeBroker.h>
+
+/**************************************************************************************
+   CONSTANTS
+ **************************************************************************************/
+
+static String const DATA_TOPIC_OUT   = "/a/t/thing/e/o";
+static String const DATA_TOPIC_IN    = "/a/t/thing/e/i";
+static String const SHADOW_TOPIC_OUT = "/a/t/thing/shadow/o";
+
+static unsigned long const UPDATE_INTERVAL_ms = 10;
+
+/**************************************************************************************
+   GLOBAL VARIABLES
+ **************************************************************************************/
+
+static ConnectionHandler connection;
+
+static int counter;
+static Property * counter_property;
+static unsigned int on_connect_cnt, on_disconnect_cnt, on_sync_cnt, on_update_cnt;
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+/* [{0: "counter", 2: value}] for 0 <= value < 24 */
+static std::vector<uint8_t> encodeCounter(uint8_t const value, bool const is_array)
+{
+  std::vector<uint8_t> msg = {0xA2, 0x00, 0x67, 0x63, 0x6F, 0x75, 0x6E, 0x74, 0x65, 0x72, 0x02, value};
+  if (is_array) {
+    msg.insert(msg.begin(), 0x81);
+  } else {
+    msg.insert(msg.begin(), 0x9F);
+    msg.push_back(0xFF);
+  }
+  return msg;
+}
+
+/* ArduinoIoTCloudTCP dispatches incoming MQTT messages to the global
+ * 'ArduinoCloud' object, hence every scenario starts by re-constructing
+ * the global object instead of using an instance of its own.
+ */
+static void begin()
+{
+  ArduinoCloud.~ArduinoIoTCloudTCP();
+  new (&ArduinoCloud) ArduinoIoTCloudTCP();
+
+  FakeBroker::instance().reset();
+  aiotc_trace.clear();
+  connection.setStatus(NetworkConnectionState::CONNECTED);
+  set_millis(0);
+
+  counter = 0;
+  on_connect_cnt = on_disconnect_cnt = on_sync_cnt = on_update_cnt = 0;
+
+  ArduinoCloud.setThingId("thing");
+  ArduinoCloud.begin(connection);
+  counter_property = &ArduinoCloud.addProperty(counter, Permission::ReadWrite).onUpdate([]() { on_update_cnt++; });
+  ArduinoCloud.addCallback(ArduinoIoTCloudEvent::CONNECT,    []() { on_connect_cnt++; });
+  ArduinoCloud.addCallback(ArduinoIoTCloudEvent::DISCONNECT, []() { on_disconnect_cnt++; });
+  ArduinoCloud.addCallback(ArduinoIoTCloudEvent::SYNC,       []() { on_sync_cnt++; });
+}
+
+/* Returns the state transitions recorded in the trace buffer as (from << 8) | to. */
+static std::vector<uint16_t> tracedStateTransitions()
+{
+  std::vector<uint16_t> transitions;
+  for (size_t i = 0; i < aiotc_trace.size(); i++)
+  {
+    if (aiotc_trace.get(i).event == static_cast<uint16_t>(TraceEvent::StateTransition))
+      transitions.push_back(aiotc_trace.get(i).arg0);
+  }
+  return transitions;
+}
+
+static void run(unsigned long const duration_ms)
+{
+  for (unsigned long t = 0; t < duration_ms; t += UPDATE_INTERVAL_ms)
+  {
+    set_millis(millis() + UPDATE_INTERVAL_ms);
+    ArduinoCloud.update();
+  }
+}
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("A device connects to the broker, synchronises and publishes its properties", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  FakeBroker::instance().setShadowReply(encodeCounter(5, true));
+
+  WHEN("The broker is reachable")
+  {
+    run(1000);
+
+    THEN("the device is connected after a single attempt and has subscribed to its topics")
+    {
+      REQUIRE(ArduinoCloud.connected() == 1);
+      REQUIRE(FakeBroker::instance().getConnectAttempts() == 1);
+      REQUIRE(FakeBroker::instance().getSubscribeAttempts() == 2);
+      REQUIRE(on_connect_cnt == 1);
+    }
+
+    THEN("the last values are requested once and the synchronisation is completed")
+    {
+      REQUIRE(FakeBroker::instance().getMessagesIn(SHADOW_TOPIC_OUT) == 1);
+      REQUIRE(on_sync_cnt == 1);
+    }
+
+    THEN("a local change of a property is published exactly once")
+    {
+      unsigned long const msg_cnt = FakeBroker::instance().getMessagesIn(DATA_TOPIC_OUT);
+      counter = 7;
+      run(1000);
+      REQUIRE(FakeBroker::instance().getMessagesIn(DATA_TOPIC_OUT) == msg_cnt + 1);
+      REQUIRE(FakeBroker::instance().received().back().topic == DATA_TOPIC_OUT);
+      REQUIRE(FakeBroker::instance().received().back().payload == encodeCounter(7, false));
+    }
+
+    THEN("a property update sent by the cloud is applied")
+    {
+      FakeBroker::instance().send(DATA_TOPIC_IN, encodeCounter(9, true));
+      run(UPDATE_INTERVAL_ms);
+      REQUIRE(counter == 9);
+      REQUIRE(on_update_cnt == 1);
+    }
+
+    THEN("the statistics account for the messages exchanged with the broker")
+    {
+      CloudStats const & stats = ArduinoCloud.getStats();
+      REQUIRE(stats.connect_attempts == 1);
+      REQUIRE(stats.messages_in == 1);
+      REQUIRE(stats.bytes_in == encodeCounter(5, true).size());
+      REQUIRE(stats.decode_duration_us.getCount() == 1);
+      REQUIRE(stats.messages_out == FakeBroker::instance().getMessagesIn());
+      REQUIRE(stats.encode_duration_us.getCount() == FakeBroker::instance().getMessagesIn(DATA_TOPIC_OUT));
+      REQUIRE(stats.publish_failures == 0);
+      REQUIRE(stats.max_queue_depth == 0);
+    }
+
+    THEN("every state of the connection sequence is traced")
+    {
+      std::vector<uint16_t> const expected = {0x0001, 0x0102, 0x0203, 0x0304, 0x0405};
+      REQUIRE(tracedStateTransitions() == expected);
+      REQUIRE(aiotc_trace.getDroppedCount() == 0);
+    }
+  }
+}
+
+SCENARIO("A device reconnects after the connection to the broker is lost", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  FakeBroker::instance().setShadowReply(encodeCounter(5, true));
+  run(1000);
+  REQUIRE(ArduinoCloud.connected() == 1);
+
+  WHEN("The broker drops the connection")
+  {
+    counter = 3;
+    run(1000);
+    FakeBroker::instance().disconnectAll();
+    run(5000);
+
+    THEN("the device reconnects, resubscribes and synchronises again")
+    {
+      REQUIRE(ArduinoCloud.connected() == 1);
+      REQUIRE(FakeBroker::instance().getConnectCount() == 2);
+      REQUIRE(FakeBroker::instance().getSubscribeAttempts() == 4);
+      REQUIRE(FakeBroker::instance().getMessagesIn(SHADOW_TOPIC_OUT) == 2);
+      REQUIRE(on_disconnect_cnt == 1);
+      REQUIRE(on_connect_cnt == 2);
+      REQUIRE(on_sync_cnt == 2);
+    }
+
+    THEN("the last message, which may have been lost, is retransmitted right after the last values request")
+    {
+      std::list<FakeBroker::Message>::const_reverse_iterator msg = FakeBroker::instance().received().rbegin();
+      REQUIRE(msg->topic == DATA_TOPIC_OUT);
+      REQUIRE(msg->payload == encodeCounter(3, false));
+      msg++;
+      REQUIRE(msg->topic == DATA_TOPIC_OUT);
+      REQUIRE(msg->payload == encodeCounter(3, false));
+      msg++;
+      REQUIRE(msg->topic == SHADOW_TOPIC_OUT);
+      REQUIRE(FakeBroker::instance().getMessagesIn(DATA_TOPIC_OUT) == 4);
+      REQUIRE(ArduinoCloud.getStats().retransmits == 1);
+    }
+
+    THEN("the reconnection is counted")
+    {
+      CloudStats const & stats = ArduinoCloud.getStats();
+      unsigned long reconnect_cnt = 0;
+      for (size_t i = 0; i < CloudStats::MAX_STATE_CNT; i++)
+        reconnect_cnt += stats.reconnects[i];
+      REQUIRE(reconnect_cnt == 1);
+      REQUIRE(stats.connect_attempts == 2);
+      REQUIRE(stats.messages_out == FakeBroker::instance().getMessagesIn());
+    }
+
+    THEN("the connection loss is traced before the connection sequence starts over")
+    {
+      std::vector<uint16_t> const transitions = tracedStateTransitions();
+      REQUIRE(transitions.size() == 11);
+      REQUIRE(transitions[5] == 0x0500);
+      REQUIRE(transitions.back() == 0x0405);
+    }
+  }
+
+  WHEN("The broker drops the connection and a property changes meanwhile")
+  {
+    counter = 3;
+    run(1000);
+    FakeBroker::instance().disconnectAll();
+    counter = 4;
+    run(5000);
+
+    THEN("the new value is published after the synchronisation, following the retransmitted one")
+    {
+      std::list<FakeBroker::Message>::const_reverse_iterator msg = FakeBroker::instance().received().rbegin();
+      REQUIRE(msg->topic == DATA_TOPIC_OUT);
+      REQUIRE(msg->payload == encodeCounter(4, false));
+      msg++;
+      REQUIRE(msg->topic == DATA_TOPIC_OUT);
+      REQUIRE(msg->payload == encodeCounter(3, false));
+      msg++;
+      REQUIRE(msg->topic == SHADOW_TOPIC_OUT);
+    }
+  }
+
+  WHEN("The broker stays offline for a while")
+  {
+    FakeBroker::instance().setOnline(false);
+    run(60000);
+    unsigned long const connect_attempts = FakeBroker::instance().getConnectAttempts();
+    FakeBroker::instance().setOnline(true);
+    run(40000);
+
+    THEN("the reconnection attempts are spaced out by the backoff")
+    {
+      REQUIRE(connect_attempts <= 10);
+      REQUIRE(ArduinoCloud.connected() == 1);
+    }
+  }
+}
+
+SCENARIO("A device whose last values request is never answered", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  static int uptime;
+  uptime = 0;
+  ArduinoCloud.addProperty(uptime, Permission::Read);
+  /* [{0: "uptime", 2: 1}] */
+  std::vector<uint8_t> const uptime_msg = {0x9F, 0xA2, 0x00, 0x66, 0x75, 0x70, 0x74, 0x69, 0x6D, 0x65, 0x02, 0x01, 0xFF};
+
+  run(1000);
+  REQUIRE(FakeBroker::instance().getMessagesIn(SHADOW_TOPIC_OUT) == 1);
+
+  WHEN("A read-only property changes while the synchronisation is pending")
+  {
+    uptime = 1;
+    run(1000);
+
+    THEN("it is published nevertheless")
+    {
+      REQUIRE(FakeBroker::instance().received().back().topic == DATA_TOPIC_OUT);
+      REQUIRE(FakeBroker::instance().received().back().payload == uptime_msg);
+    }
+
+    THEN("the read-write properties are held back")
+    {
+      for (FakeBroker::Message const & msg : FakeBroker::instance().received())
+        REQUIRE(msg.payload != encodeCounter(0, false));
+    }
+  }
+
+  WHEN("The connection is lost while waiting for the last values")
+  {
+    FakeBroker::instance().disconnectAll();
+    run(5000);
+
+    THEN("the device reconnects right away instead of waiting for the last values")
+    {
+      REQUIRE(on_disconnect_cnt == 1);
+      REQUIRE(FakeBroker::instance().getConnectCount() == 2);
+      REQUIRE(ArduinoCloud.getStats().reconnects[4] == 1);
+    }
+  }
+
+  WHEN("The last values are requested for the maximum number of times")
+  {
+    run(120000);
+
+    THEN("the device gives up waiting and falls back to the connected state")
+    {
+      REQUIRE(FakeBroker::instance().getMessagesIn(SHADOW_TOPIC_OUT) == AIOT_CONFIG_MAX_LASTVALUES_SYNC_RETRY_CNT);
+      REQUIRE(tracedStateTransitions().back() == 0x0405);
+      REQUIRE(on_sync_cnt == 0);
+    }
+
+    THEN("the device values are published")
+    {
+      REQUIRE(FakeBroker::instance().received().back().topic == DATA_TOPIC_OUT);
+      REQUIRE(FakeBroker::instance().received().back().payload == encodeCounter(0, false));
+    }
+  }
+}
+
+SCENARIO("A device reconnects while a message is pending for retransmission", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  static int uptime;
+  uptime = 0;
+  ArduinoCloud.addProperty(uptime, Permission::Read);
+  FakeBroker::instance().setShadowReply(encodeCounter(5, true));
+  run(1000);
+  REQUIRE(ArduinoCloud.connected() == 1);
+
+  WHEN("A read-only property changes before the last values are received again")
+  {
+    counter = 3;
+    run(1000);
+    FakeBroker::instance().disconnectAll();
+    FakeBroker::instance().disableShadowReply();
+    uptime = 1;
+    size_t const msg_cnt = FakeBroker::instance().getMessagesIn();
+    run(5000);
+
+    THEN("the message lost with the connection is retransmitted before the read-only property is published")
+    {
+      std::list<FakeBroker::Message>::const_iterator msg = FakeBroker::instance().received().begin();
+      std::advance(msg, msg_cnt);
+      REQUIRE(msg->topic == SHADOW_TOPIC_OUT);
+      msg++;
+      REQUIRE(msg->topic == DATA_TOPIC_OUT);
+      REQUIRE(msg->payload == encodeCounter(3, false));
+      msg++;
+      REQUIRE(msg->topic == DATA_TOPIC_OUT);
+      REQUIRE(msg->payload == std::vector<uint8_t>({0x9F, 0xA2, 0x00, 0x66, 0x75, 0x70, 0x74, 0x69, 0x6D, 0x65, 0x02, 0x01, 0xFF}));
+    }
+  }
+}
+
+SCENARIO("A connected device without local changes does not allocate memory", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  FakeBroker::instance().setShadowReply(encodeCounter(0, true));
+  run(1000);
+  REQUIRE(ArduinoCloud.connected() == 1);
+
+  WHEN("update() is called repeatedly while no property changes")
+  {
+    alloc::Scope scope;
+    run(10000);
+    unsigned long const allocations = scope.allocations();
+
+    THEN("no heap allocation is performed")
+    {
+      REQUIRE(allocations == 0);
+    }
+  }
+}
+
+SCENARIO("Publishing throughput of a device under load", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  FakeBroker::instance().setShadowReply(encodeCounter(0, true));
+  run(1000);
+  REQUIRE(ArduinoCloud.connected() == 1);
+
+  WHEN("A property without rate limit changes on every call of update()")
+  {
+    counter_property->publishOnChange(0, 0);
+
+    unsigned long const DURATION_ms = 10000;
+    unsigned long const msg_cnt_start = FakeBroker::instance().getMessagesIn();
+    unsigned long const bytes_start = FakeBroker::instance().getBytesIn();
+
+    for (unsigned long t = 0; t < DURATION_ms; t += UPDATE_INTERVAL_ms)
+    {
+      counter = (counter + 1) % 24;
+      run(UPDATE_INTERVAL_ms);
+    }
+
+    unsigned long const msg_cnt = FakeBroker::instance().getMessagesIn() - msg_cnt_start;
+    unsigned long const bytes = FakeBroker::instance().getBytesIn() - bytes_start;
+    double const msgs_per_s = msg_cnt * 1000.0 / DURATION_ms;
+    double const bytes_per_msg = static_cast<double>(bytes) / msg_cnt;
+    WARN("messages/s: " << msgs_per_s << ", bytes/message: " << bytes_per_msg);
+
+    THEN("every change is published with a constant message size")
+    {
+      REQUIRE(msg_cnt == DURATION_ms / UPDATE_INTERVAL_ms);
+      REQUIRE(bytes_per_msg == FakeBroker::getPublishPacketSize(DATA_TOPIC_OUT, encodeCounter(0, false).size()));
+    }
+  }
+}
+
+SCENARIO("Float properties are published once their change is detected by the float registry", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  static float temperature;
+  temperature = 20.0f;
+  ArduinoCloud.addProperty(temperature, Permission::ReadWrite).publishOnChange(0.5f);
+  FakeBroker::instance().setShadowReply(encodeCounter(0, true));
+  run(1000);
+  REQUIRE(ArduinoCloud.connected() == 1);
+  unsigned long const msg_cnt = FakeBroker::instance().getMessagesIn(DATA_TOPIC_OUT);
+
+  WHEN("The float changes by more than the minimum delta")
+  {
+    temperature = 21.0f;
+    run(1000);
+
+    THEN("it is published exactly once")
+    {
+      /* [{0: "temperature", 2: 21.0}] */
+      std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x6B, 0x74, 0x65, 0x6D, 0x70, 0x65, 0x72, 0x61, 0x74, 0x75, 0x72, 0x65, 0x02, 0xFA, 0x41, 0xA8, 0x00, 0x00, 0xFF};
+      REQUIRE(FakeBroker::instance().getMessagesIn(DATA_TOPIC_OUT) == msg_cnt + 1);
+      REQUIRE(FakeBroker::instance().received().back().payload == expected);
+    }
+  }
+
+  WHEN("The float changes by less than the minimum delta")
+  {
+    temperature = 20.25f;
+    run(1000);
+
+    THEN("nothing is published")
+    {
+      REQUIRE(FakeBroker::instance().getMessagesIn(DATA_TOPIC_OUT) == msg_cnt);
+    }
+  }
+}
+
+SCENARIO("A property is added with a name composed at runtime", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  static int level;
+  String name = "level";
+  name += "_1";
+  ArduinoCloud.addPropertyReal(level, name, Permission::ReadWrite);
+  name = "changed";
+
+  THEN("the property keeps a copy of the name")
+  {
+    REQUIRE(ArduinoCloud.setTimestamp("level_1", 1) == true);
+    REQUIRE(ArduinoCloud.setTimestamp("changed", 1) == false);
+  }
+}
@@ -0,0 +1,139 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <new>
+#include <vector>
+
+#include <ArduinoIoTCloud.h>
+#include <Arduino_ConnectionHandler.h>
+
+#include <util/FakeBroker.h>
+
+/**************************************************************************************
+   CONSTANTS
+ **************************************************************************************/
+
+static String const DATA_TOPIC_OUT = "/a/t/thing/e/o";
+
+static unsigned long const UPDATE_INTERVAL_ms = 10;
+
+/**************************************************************************************
+   GLOBAL VARIABLES
+ **************************************************************************************/
+
+static ConnectionHandler connection;
+
+static int counter;
+static int uptime;
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+/* [{0: name, 2: value}] for 0 <= value < 24 */
+static std::vector<uint8_t> encodeInt(String const & name, uint8_t const value)
+{
+  std::vector<uint8_t> msg = {0x9F, 0xA2, 0x00, static_cast<uint8_t>(0x60 + name.length())};
+  msg.insert(msg.end(), name.begin(), name.end());
+  msg.insert(msg.end(), {0x02, value, 0xFF});
+  return msg;
+}
+
+/* See test_ArduinoIoTCloudTCP.cpp */
+static void begin()
+{
+  ArduinoCloud.~ArduinoIoTCloudTCP();
+  new (&ArduinoCloud) ArduinoIoTCloudTCP();
+
+  FakeBroker::instance().reset();
+  connection.setStatus(NetworkConnectionState::CONNECTED);
+  set_millis(0);
+
+  counter = 0;
+  uptime = 0;
+
+  ArduinoCloud.setThingId("thing");
+  ArduinoCloud.begin(connection);
+  ArduinoCloud.addProperty(counter, Permission::ReadWrite);
+  ArduinoCloud.addProperty(uptime, Permission::Read);
+}
+
+static void run(unsigned long const duration_ms)
+{
+  for (unsigned long t = 0; t < duration_ms; t += UPDATE_INTERVAL_ms)
+  {
+    set_millis(millis() + UPDATE_INTERVAL_ms);
+    ArduinoCloud.update();
+  }
+}
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("A device publishes with QoS 1", "[ArduinoIoTCloudTCP]")
+{
+  begin();
+  /* [{0: "counter", 2: 0}] */
+  FakeBroker::instance().setShadowReply({0x81, 0xA2, 0x00, 0x67, 0x63, 0x6F, 0x75, 0x6E, 0x74, 0x65, 0x72, 0x02, 0x00});
+  run(1000);
+  REQUIRE(ArduinoCloud.connected() == 1);
+
+  WHEN("The broker acknowledges every message")
+  {
+    counter = 7;
+    run(1000);
+
+    THEN("the message is published once and removed from the retransmit queue")
+    {
+      CloudStats const & stats = ArduinoCloud.getStats();
+      REQUIRE(FakeBroker::instance().received().back().payload == encodeInt("counter", 7));
+      REQUIRE(stats.max_queue_depth == 0);
+      REQUIRE(stats.retransmits == 0);
+      REQUIRE(stats.publish_failures == 0);
+    }
+  }
+
+  WHEN("The broker stops acknowledging while a read-only property keeps changing")
+  {
+    FakeBroker::instance().setPublishAcked(false);
+    for (uptime = 1; uptime <= 6; uptime++)
+      run(60000);
+    uptime--;
+    size_t const msg_cnt = FakeBroker::instance().getMessagesIn();
+
+    THEN("the retransmit queue fills up and no message waiting for its acknowledge is dropped")
+    {
+      REQUIRE(ArduinoCloud.getStats().max_queue_depth == AIOT_CONFIG_MQTT_RETRANSMIT_QUEUE_SIZE);
+      REQUIRE(ArduinoCloud.getStats().publish_failures > 0);
+    }
+
+    AND_WHEN("The broker acknowledges again")
+    {
+      FakeBroker::instance().setPublishAcked(true);
+      run(60000);
+
+      THEN("the queued messages are retransmitted once, oldest first, followed by the value held back meanwhile")
+      {
+        std::vector<std::vector<uint8_t>> resent;
+        std::list<FakeBroker::Message>::const_iterator msg = FakeBroker::instance().received().begin();
+        std::advance(msg, msg_cnt);
+        for (; msg != FakeBroker::instance().received().end(); msg++)
+          if (msg->topic == DATA_TOPIC_OUT)
+            resent.push_back(msg->payload);
+
+        std::vector<std::vector<uint8_t>> const expected = {encodeInt("uptime", 1), encodeInt("uptime", 2), encodeInt("uptime", 3), encodeInt("uptime", 4), encodeInt("uptime", 6)};
+        REQUIRE(resent == expected);
+        REQUIRE(ArduinoCloud.connected() == 1);
+        REQUIRE(ArduinoCloud.getStats().queue_depth == 0);
+      }
+    }
+  }
+}
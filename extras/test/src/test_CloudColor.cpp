@@ -11,6 +11,9 @@
 #include <util/CBORTestUtil.h>
 
 #include <property/types/CloudColor.h>
+#include <utility/color/ColorConversion.h>
+
+#include <stdlib.h>
 
 /**************************************************************************************
   TEST CODE
@@ -89,6 +92,14 @@ SCENARIO("Arduino Cloud Properties ", "[ArduinoCloudThing::CloudColor]")
     REQUIRE(r == 20);
     REQUIRE(g == 50);
     REQUIRE(b == 70);
+
+    value_color_test.setColorRGB(255, 0, 128);
+    value_color_test.getRGB(r, g, b);
+
+    REQUIRE(value_color_test.hue >= 0.0f);
+    REQUIRE(r == 255);
+    REQUIRE(g == 0);
+    REQUIRE(b == 128);
   }
 
   WHEN("Set HSB colors and get RGB")
@@ -112,4 +123,130 @@ SCENARIO("Arduino Cloud Properties ", "[ArduinoCloudThing::CloudColor]")
 
     REQUIRE(verify);
   }
-}
\ No newline at end of file
+}
+
+SCENARIO("Colors are converted with integer arithmetic", "[ColorConversion]")
+{
+  WHEN("Every RGB color is converted to HSB and back")
+  {
+    size_t hsb_mismatch_cnt = 0, rgb_mismatch_cnt = 0;
+
+    for (int r = 0; r < 256; r++)
+    {
+      for (int g = 0; g < 256; g++)
+      {
+        for (int b = 0; b < 256; b++)
+        {
+          Color reference(0, 0, 0);
+          reference.setColorRGB(r, g, b);
+          uint8_t ref_r, ref_g, ref_b;
+          reference.getRGB(ref_r, ref_g, ref_b);
+
+          uint16_t hue, sat, bri;
+          rgbToHsb(r, g, b, hue, sat, bri);
+          uint8_t fx_r, fx_g, fx_b;
+          hsbToRgb(hue, sat, bri, fx_r, fx_g, fx_b);
+
+          /* The hue wraps around at 360 degree. */
+          float hue_diff = fabsf(hue - reference.hue * (COLOR_HUE_SECTOR / 60.0f));
+          hue_diff = (hue_diff > (COLOR_HUE_MAX / 2)) ? (COLOR_HUE_MAX - hue_diff) : hue_diff;
+          if ((hue_diff > 1.0f) ||
+              (fabsf(sat - reference.sat * (COLOR_UNIT / 100.0f)) > 1.0f) ||
+              (fabsf(bri - reference.bri * (COLOR_UNIT / 100.0f)) > 1.0f))
+            hsb_mismatch_cnt++;
+
+          if ((abs(fx_r - ref_r) > 1) || (abs(fx_g - ref_g) > 1) || (abs(fx_b - ref_b) > 1) ||
+              (abs(fx_r - r) > 1)     || (abs(fx_g - g) > 1)     || (abs(fx_b - b) > 1))
+            rgb_mismatch_cnt++;
+        }
+      }
+    }
+
+    THEN("the results are within 1 LSB of the floating point conversion")
+    {
+      REQUIRE(hsb_mismatch_cnt == 0);
+      REQUIRE(rgb_mismatch_cnt == 0);
+    }
+  }
+
+  WHEN("Every hue is converted to RGB")
+  {
+    size_t mismatch_cnt = 0;
+
+    for (uint32_t hue = 0; hue <= COLOR_HUE_MAX; hue++)
+    {
+      for (uint32_t sat = 0; sat <= COLOR_UNIT; sat += COLOR_UNIT / 16)
+      {
+        for (uint32_t bri = 0; bri <= COLOR_UNIT; bri += COLOR_UNIT / 16)
+        {
+          Color reference(hue * (60.0f / COLOR_HUE_SECTOR), sat * (100.0f / COLOR_UNIT), bri * (100.0f / COLOR_UNIT));
+          uint8_t ref_r, ref_g, ref_b;
+          reference.getRGB(ref_r, ref_g, ref_b);
+
+          uint8_t fx_r, fx_g, fx_b;
+          hsbToRgb(hue, sat, bri, fx_r, fx_g, fx_b);
+
+          if ((abs(fx_r - ref_r) > 1) || (abs(fx_g - ref_g) > 1) || (abs(fx_b - ref_b) > 1))
+            mismatch_cnt++;
+        }
+      }
+    }
+
+    THEN("the results are within 1 LSB of the floating point conversion")
+    {
+      REQUIRE(mismatch_cnt == 0);
+    }
+  }
+
+  WHEN("A LED strip is converted at once")
+  {
+    static size_t const LED_CNT = 77;
+    uint16_t hue[LED_CNT], sat[LED_CNT], bri[LED_CNT];
+    uint8_t rgb[3 * LED_CNT];
+    for (size_t i = 0; i < LED_CNT; i++)
+    {
+      rgb[3 * i]     = i * 3;
+      rgb[3 * i + 1] = 255 - i;
+      rgb[3 * i + 2] = i * 7;
+    }
+    rgbToHsb(rgb, hue, sat, bri, LED_CNT);
+    uint8_t converted_rgb[3 * LED_CNT];
+    hsbToRgb(hue, sat, bri, converted_rgb, LED_CNT);
+
+    THEN("every LED is converted like a single color")
+    {
+      for (size_t i = 0; i < LED_CNT; i++)
+      {
+        uint16_t h, s, v;
+        rgbToHsb(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2], h, s, v);
+        REQUIRE(hue[i] == h);
+        REQUIRE(sat[i] == s);
+        REQUIRE(bri[i] == v);
+
+        uint8_t r, g, b;
+        hsbToRgb(h, s, v, r, g, b);
+        REQUIRE(converted_rgb[3 * i]     == r);
+        REQUIRE(converted_rgb[3 * i + 1] == g);
+        REQUIRE(converted_rgb[3 * i + 2] == b);
+      }
+    }
+  }
+
+  WHEN("The integer conversion of a Color is used")
+  {
+    Color color(0, 0, 0);
+    uint8_t r, g, b;
+    color.setColorRGBFast(20, 50, 70);
+    color.getRGBFast(r, g, b);
+
+    THEN("it matches the floating point conversion")
+    {
+      REQUIRE(color.hue == Approx(204.0).margin(0.02));
+      REQUIRE(color.sat == Approx(71.43).margin(0.01));
+      REQUIRE(color.bri == Approx(27.45).margin(0.01));
+      REQUIRE(r == 20);
+      REQUIRE(g == 50);
+      REQUIRE(b == 70);
+    }
+  }
+}
@@ -0,0 +1,143 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <string.h>
+
+#include <utility/stats/CloudStats.h>
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Durations are recorded in logarithmic buckets", "[DurationHistogram]")
+{
+  DurationHistogram histogram;
+
+  WHEN("Nothing has been recorded")
+  {
+    THEN("the histogram is empty")
+    {
+      REQUIRE(histogram.getCount() == 0);
+      REQUIRE(histogram.getMax() == 0);
+      REQUIRE(histogram.getPercentile(99) == 0);
+    }
+  }
+
+  WHEN("Durations are recorded")
+  {
+    THEN("each one is counted in the bucket covering [2^(i-1), 2^i)")
+    {
+      REQUIRE(DurationHistogram::getBucketIndex(0) == 0);
+      REQUIRE(DurationHistogram::getBucketIndex(1) == 1);
+      REQUIRE(DurationHistogram::getBucketIndex(2) == 2);
+      REQUIRE(DurationHistogram::getBucketIndex(3) == 2);
+      REQUIRE(DurationHistogram::getBucketIndex(4) == 3);
+      REQUIRE(DurationHistogram::getBucketIndex(1000) == 10);
+      REQUIRE(DurationHistogram::getBucketUpperBound(10) == 1023);
+    }
+
+    THEN("durations exceeding the last bucket are counted in the last one")
+    {
+      REQUIRE(DurationHistogram::getBucketIndex(1000000) == DurationHistogram::BUCKET_CNT - 1);
+      histogram.add(1000000);
+      REQUIRE(histogram.getBucket(DurationHistogram::BUCKET_CNT - 1) == 1);
+      REQUIRE(histogram.getMax() == 1000000);
+      REQUIRE(histogram.getPercentile(50) == 1000000);
+    }
+  }
+
+  WHEN("Most durations are short and a few ones are long")
+  {
+    for (int i = 0; i < 98; i++)
+      histogram.add(100);
+    histogram.add(5000);
+    histogram.add(6000);
+
+    THEN("the percentiles are the upper bounds of the buckets containing them")
+    {
+      REQUIRE(histogram.getCount() == 100);
+      REQUIRE(histogram.getPercentile(50) == 127);
+      REQUIRE(histogram.getPercentile(98) == 127);
+      REQUIRE(histogram.getPercentile(99) == 6000);
+      REQUIRE(histogram.getMax() == 6000);
+    }
+
+    THEN("reset() clears the histogram")
+    {
+      histogram.reset();
+      REQUIRE(histogram.getCount() == 0);
+      REQUIRE(histogram.getMax() == 0);
+    }
+  }
+}
+
+SCENARIO("Cloud statistics are collected", "[CloudStats]")
+{
+  CloudStats stats;
+
+  WHEN("Messages are sent and received")
+  {
+    stats.onMessageIn(10);
+    stats.onMessageOut(20);
+    stats.onMessageOut(30);
+    stats.onQueueDepth(3);
+    stats.onQueueDepth(1);
+    stats.onReconnect(2);
+    stats.onReconnect(CloudStats::MAX_STATE_CNT);
+
+    THEN("messages and bytes are counted in both directions")
+    {
+      REQUIRE(stats.messages_in == 1);
+      REQUIRE(stats.bytes_in == 10);
+      REQUIRE(stats.messages_out == 2);
+      REQUIRE(stats.bytes_out == 50);
+    }
+
+    THEN("the current and the maximum queue depth are tracked")
+    {
+      REQUIRE(stats.queue_depth == 1);
+      REQUIRE(stats.max_queue_depth == 3);
+    }
+
+    THEN("reconnects are counted per state, invalid states are ignored")
+    {
+      REQUIRE(stats.reconnects[2] == 1);
+      for (size_t i = 0; i < CloudStats::MAX_STATE_CNT; i++)
+        if (i != 2)
+          REQUIRE(stats.reconnects[i] == 0);
+    }
+
+    THEN("the summary lists the counters")
+    {
+      char buf[160];
+      stats.print(buf, sizeof(buf));
+      REQUIRE(strncmp(buf, "mi=1,bi=10,mo=2,bo=50,", 22) == 0);
+    }
+
+    THEN("reset() clears all counters")
+    {
+      stats.reset();
+      REQUIRE(stats.messages_out == 0);
+      REQUIRE(stats.max_queue_depth == 0);
+      REQUIRE(stats.reconnects[2] == 0);
+    }
+  }
+
+  WHEN("A counter reaches its maximum value")
+  {
+    for (int i = 0; i < 70000; i++)
+      stats.onReconnect(0);
+
+    THEN("it saturates instead of wrapping around")
+    {
+      REQUIRE(stats.reconnects[0] == 0xFFFF);
+    }
+  }
+}
@@ -0,0 +1,133 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <util/CBORTestUtil.h>
+
+#include <property/types/CloudTrack.h>
+
+/**************************************************************************************
+  TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Tracks are encoded as polylines", "[Polyline]")
+{
+  StaticPolyline<8> track;
+
+  WHEN("The example of the Encoded Polyline Algorithm Format is encoded")
+  {
+    track.add(38.5f, -120.2f);
+    track.add(40.7f, -120.95f);
+    track.add(43.252f, -126.453f);
+    String polyline;
+    track.encode(polyline);
+
+    THEN("the result is the same")
+    {
+      REQUIRE(polyline == "_p~iF~ps|U_ulLnnqC_mqNvxq`@");
+    }
+  }
+
+  WHEN("A fix is closer than the tolerance to the last one")
+  {
+    track.setTolerance(5.0f);
+    REQUIRE(track.add(45.0f, 7.0f) == true);
+
+    THEN("it is dropped")
+    {
+      REQUIRE(track.add(45.00002f, 7.00002f) == false);
+      REQUIRE(track.add(45.0001f, 7.0f) == true);
+      REQUIRE(track.size() == 2);
+    }
+  }
+}
+
+/**************************************************************************************/
+
+SCENARIO("Tracks are simplified with bounded memory", "[Polyline]")
+{
+  StaticPolyline<32> track;
+  track.setTolerance(5.0f);
+
+  WHEN("A road with a corner is driven, deviating by 1 m from the road")
+  {
+    for (int i = 0; i < 100; i++)
+    {
+      float const jitter = (i % 2) ? 0.00001f : -0.00001f;
+      if (i < 50)
+        track.add(45.0f + jitter, 7.0f + i * 0.0001f);
+      else
+        track.add(45.0f + (i - 49) * 0.0001f, 7.0049f + jitter);
+      REQUIRE(track.size() <= track.capacity());
+    }
+    track.simplify();
+
+    THEN("only the start, the corner and the end remain")
+    {
+      REQUIRE(track.size() == 3);
+      REQUIRE(track.lon(1) >= 700480);
+      REQUIRE(track.lon(1) <= 700500);
+      REQUIRE(track.lat(1) >= 4499999);
+      REQUIRE(track.lat(1) <= 4500011);
+    }
+  }
+
+  WHEN("A zigzag road, where every point is significant, is driven")
+  {
+    for (int i = 0; i < 100; i++)
+      track.add(45.0f + ((i % 2) ? 0.001f : 0.0f), 7.0f + i * 0.001f);
+
+    THEN("the memory is still bounded and the route is kept coarsely")
+    {
+      REQUIRE(track.size() <= track.capacity());
+      REQUIRE(track.size() >= 2);
+      REQUIRE(track.lon(0) == 700000);
+      REQUIRE(track.lon(track.size() - 1) == 709900);
+    }
+  }
+}
+
+/**************************************************************************************/
+
+SCENARIO("A 'Track' property publishes the path travelled since the last update", "[CloudTrack]")
+{
+  PropertyContainer track_container, location_container;
+  CloudTrack track;
+  CloudLocation location;
+  addPropertyToContainer(track_container, track, "track", Permission::Read).publishOnChange(0.0f, 0);
+  addPropertyToContainer(location_container, location, "location", Permission::Read).publishOnChange(0.0f, 0);
+  cbor::encode(track_container);
+  cbor::encode(location_container);
+
+  WHEN("A slightly curved road of 1 km is driven with a fix every 10 m")
+  {
+    size_t location_bytes = 0;
+    for (int i = 1; i <= 100; i++)
+    {
+      Location const fix(45.0f + i * 0.00009f, 7.0f + i * i * 0.0000005f);
+      track = fix;
+      location = fix;
+      location_bytes += cbor::encode(location_container).size();
+    }
+    std::vector<uint8_t> const track_bytes = cbor::encode(track_container);
+
+    THEN("the track needs less than a tenth of the bytes of publishing every location")
+    {
+      REQUIRE(track_bytes.size() > 0);
+      REQUIRE(track_bytes.size() * 10 < location_bytes);
+      REQUIRE(cbor::encode(track_container).size() == 0);
+    }
+
+    THEN("the next track starts with the last point sent")
+    {
+      REQUIRE(track.getValue().size() == 1);
+      REQUIRE(track.getValue().lat(0) == 4500900);
+    }
+  }
+}
@@ -0,0 +1,119 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <vector>
+
+#include <utility/lora/DownlinkReassembler.h>
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+static std::vector<uint8_t> fragment(uint8_t const message_id, bool const is_last, uint8_t const index, std::vector<uint8_t> const & payload)
+{
+  std::vector<uint8_t> msg = {DownlinkReassembler::HEADER_MARKER, static_cast<uint8_t>((message_id << 5) | (is_last ? 0x10 : 0x00) | index)};
+  msg.insert(msg.end(), payload.begin(), payload.end());
+  return msg;
+}
+
+static DownlinkReassembler::Result push(DownlinkReassembler & reassembler, std::vector<uint8_t> const & msg)
+{
+  return reassembler.push(msg.data(), msg.size());
+}
+
+static std::vector<uint8_t> message(DownlinkReassembler const & reassembler)
+{
+  return std::vector<uint8_t>(reassembler.data(), reassembler.data() + reassembler.length());
+}
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Fragmented downlinks are reassembled", "[DownlinkReassembler]")
+{
+  DownlinkReassembler reassembler;
+
+  WHEN("A downlink is not fragmented")
+  {
+    std::vector<uint8_t> const msg = {0x81, 0xA2, 0x00, 0x01, 0x02, 0x07};
+
+    THEN("it is passed on unchanged")
+    {
+      REQUIRE(DownlinkReassembler::isFragment(msg.data(), msg.size()) == false);
+      REQUIRE(push(reassembler, msg) == DownlinkReassembler::Result::NotFragmented);
+    }
+  }
+
+  WHEN("All fragments of a message arrive in order")
+  {
+    REQUIRE(push(reassembler, fragment(3, false, 0, {0x01, 0x02})) == DownlinkReassembler::Result::Incomplete);
+    REQUIRE(push(reassembler, fragment(3, false, 1, {0x03})) == DownlinkReassembler::Result::Incomplete);
+    REQUIRE(reassembler.isPending() == true);
+
+    THEN("the message is complete with the last fragment")
+    {
+      REQUIRE(push(reassembler, fragment(3, true, 2, {0x04, 0x05})) == DownlinkReassembler::Result::Complete);
+      REQUIRE(message(reassembler) == std::vector<uint8_t>{0x01, 0x02, 0x03, 0x04, 0x05});
+      REQUIRE(reassembler.isPending() == false);
+      REQUIRE(reassembler.getDiscardedCount() == 0);
+    }
+
+    THEN("the next message starts from scratch")
+    {
+      REQUIRE(push(reassembler, fragment(3, true, 2, {0x04, 0x05})) == DownlinkReassembler::Result::Complete);
+      REQUIRE(push(reassembler, fragment(4, true, 0, {0x06})) == DownlinkReassembler::Result::Complete);
+      REQUIRE(message(reassembler) == std::vector<uint8_t>{0x06});
+    }
+  }
+
+  WHEN("A fragment is lost")
+  {
+    push(reassembler, fragment(1, false, 0, {0x01}));
+
+    THEN("the message is discarded")
+    {
+      REQUIRE(push(reassembler, fragment(1, true, 2, {0x03})) == DownlinkReassembler::Result::Discarded);
+      REQUIRE(reassembler.isPending() == false);
+      REQUIRE(reassembler.getDiscardedCount() == 1);
+    }
+
+    THEN("the message is discarded if the cloud starts another one")
+    {
+      REQUIRE(push(reassembler, fragment(2, false, 0, {0x0A})) == DownlinkReassembler::Result::Incomplete);
+      REQUIRE(push(reassembler, fragment(2, true, 1, {0x0B})) == DownlinkReassembler::Result::Complete);
+      REQUIRE(message(reassembler) == std::vector<uint8_t>{0x0A, 0x0B});
+      REQUIRE(reassembler.getDiscardedCount() == 1);
+    }
+  }
+
+  WHEN("A fragment belongs to another message")
+  {
+    push(reassembler, fragment(1, false, 0, {0x01}));
+
+    THEN("the message is discarded")
+    {
+      REQUIRE(push(reassembler, fragment(2, true, 1, {0x02})) == DownlinkReassembler::Result::Discarded);
+      REQUIRE(reassembler.getDiscardedCount() == 1);
+    }
+  }
+
+  WHEN("A message exceeds the reassembly buffer")
+  {
+    std::vector<uint8_t> const payload(DownlinkReassembler::BUFFER_SIZE / 2 + 1, 0x55);
+    push(reassembler, fragment(1, false, 0, payload));
+
+    THEN("it is discarded")
+    {
+      REQUIRE(push(reassembler, fragment(1, true, 1, payload)) == DownlinkReassembler::Result::Discarded);
+      REQUIRE(reassembler.getDiscardedCount() == 1);
+    }
+  }
+}
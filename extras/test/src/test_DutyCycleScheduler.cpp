@@ -0,0 +1,104 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <utility/lora/DutyCycleScheduler.h>
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("The airtime of an uplink is computed from its size and spreading factor", "[DutyCycleScheduler]")
+{
+  WHEN("A 10 byte payload is sent")
+  {
+    THEN("the airtime matches the reference values of Semtech's LoRa calculator")
+    {
+      REQUIRE(DutyCycleScheduler::computeAirtime(10,  7) ==   61696);
+      REQUIRE(DutyCycleScheduler::computeAirtime(10,  9) ==  205824);
+      REQUIRE(DutyCycleScheduler::computeAirtime(10, 12) == 1482752);
+    }
+  }
+
+  WHEN("The payload grows")
+  {
+    THEN("the airtime grows as well")
+    {
+      REQUIRE(DutyCycleScheduler::computeAirtime(51, 12) > DutyCycleScheduler::computeAirtime(10, 12));
+      REQUIRE(DutyCycleScheduler::computeAirtime(222, 7) > DutyCycleScheduler::computeAirtime(51, 7));
+    }
+  }
+}
+
+SCENARIO("Transmissions are limited by the duty cycle of the sub-bands", "[DutyCycleScheduler]")
+{
+  set_millis(0);
+  DutyCycleScheduler scheduler;
+
+  WHEN("No duty cycle is configured")
+  {
+    scheduler.onTransmit(100000);
+
+    THEN("transmissions are not restricted")
+    {
+      REQUIRE(scheduler.isAvailable() == true);
+      REQUIRE(scheduler.getWaitTime() == 0);
+      REQUIRE(scheduler.getConsumedAirtime(0) == 100000);
+    }
+  }
+
+  WHEN("A single sub-band with 1 % duty cycle is configured")
+  {
+    uint16_t const duty_cycle_permille[] = {10};
+    REQUIRE(scheduler.setSubBands(duty_cycle_permille, 1));
+    scheduler.onTransmit(100000);
+
+    THEN("the sub-band is blocked for 100 times the airtime")
+    {
+      REQUIRE(scheduler.isAvailable() == false);
+      REQUIRE(scheduler.getWaitTime() == 10000);
+      set_millis(9999);
+      REQUIRE(scheduler.isAvailable() == false);
+      set_millis(10000);
+      REQUIRE(scheduler.isAvailable() == true);
+      REQUIRE(scheduler.getConsumedAirtime(0) == 100000);
+    }
+  }
+
+  WHEN("Several sub-bands are configured")
+  {
+    uint16_t const duty_cycle_permille[] = {10, 10, 1};
+    REQUIRE(scheduler.setSubBands(duty_cycle_permille, 3));
+    scheduler.onTransmit(100000);
+    scheduler.onTransmit(100000);
+
+    THEN("every transmission is accounted to another available sub-band")
+    {
+      REQUIRE(scheduler.isAvailable() == true);
+      scheduler.onTransmit(100000);
+      REQUIRE(scheduler.isAvailable() == false);
+      REQUIRE(scheduler.getWaitTime() == 10000);
+      REQUIRE(scheduler.getConsumedAirtime(0) == 100000);
+      REQUIRE(scheduler.getConsumedAirtime(1) == 100000);
+      REQUIRE(scheduler.getConsumedAirtime(2) == 100000);
+    }
+  }
+
+  WHEN("An invalid configuration is set")
+  {
+    uint16_t const duty_cycle_permille[] = {10, 0};
+
+    THEN("it is rejected")
+    {
+      REQUIRE(scheduler.setSubBands(duty_cycle_permille, 2) == false);
+      REQUIRE(scheduler.setSubBands(duty_cycle_permille, 0) == false);
+      REQUIRE(scheduler.getSubBandCount() == 1);
+    }
+  }
+}
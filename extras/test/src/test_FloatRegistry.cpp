@@ -0,0 +1,140 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <vector>
+
+#include <util/CBORTestUtil.h>
+#include <FloatRegistry.h>
+#include "types/CloudWrapperFloat.h"
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("The changes of many floats are detected in a single scan", "[FloatRegistry]")
+{
+  StaticFloatRegistry<4> registry;
+  float a = 1.0f, b = 2.0f, c = 3.0f, d = 4.0f, e = 5.0f;
+
+  REQUIRE(registry.add(a, a) == 0);
+  REQUIRE(registry.add(b, b) == 1);
+  REQUIRE(registry.add(c, c) == 2);
+  REQUIRE(registry.add(d, d) == 3);
+
+  WHEN("The registry is full")
+  {
+    THEN("no further float is added")
+    {
+      REQUIRE(registry.add(e, e) == -1);
+      REQUIRE(registry.size() == registry.capacity());
+    }
+  }
+
+  WHEN("No float has changed")
+  {
+    THEN("the scan reports no change")
+    {
+      REQUIRE(registry.scan() == 0);
+    }
+  }
+
+  WHEN("Some floats have changed")
+  {
+    registry.setMinDelta(3, 1.0f);
+    b = 2.5f;
+    c = 3.5f;
+    d = 4.5f;
+
+    THEN("the changed ones are flagged unless they are within their minimum delta")
+    {
+      REQUIRE(registry.scan() == 2);
+      REQUIRE(registry.isChanged(0) == false);
+      REQUIRE(registry.isChanged(1) == true);
+      REQUIRE(registry.isChanged(2) == true);
+      REQUIRE(registry.isChanged(3) == false);
+    }
+
+    THEN("a change is cleared once the cloud value has been updated")
+    {
+      registry.scan();
+      registry.cloudValue(1) = b;
+      registry.clearChanged(1);
+      REQUIRE(registry.isChanged(1) == false);
+      REQUIRE(registry.scan() == 1);
+    }
+  }
+}
+
+SCENARIO("Float wrappers attached to a registry are published on change", "[FloatRegistry]")
+{
+  PropertyContainer property_container;
+  StaticFloatRegistry<1> registry;
+  float value = 1.0f, other = 2.0f;
+
+  CloudWrapperFloat wrapper(value);
+  CloudWrapperFloat other_wrapper(other);
+  REQUIRE(wrapper.attach(registry) == true);
+  REQUIRE(other_wrapper.attach(registry) == false);
+  addPropertyToContainer(property_container, wrapper, "value", Permission::ReadWrite).publishOnChange(0.5f);
+  addPropertyToContainer(property_container, other_wrapper, "other", Permission::ReadWrite).publishOnChange(0.0f);
+
+  REQUIRE(cbor::encode(property_container).size() != 0);
+  registry.scan();
+  REQUIRE(cbor::encode(property_container).size() == 0);
+
+  WHEN("The value changes by more than the minimum delta")
+  {
+    value = 2.0f;
+    registry.scan();
+
+    THEN("it is encoded exactly once")
+    {
+      /* [{0: "value", 2: 2.0}] */
+      std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x65, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x02, 0xFA, 0x40, 0x00, 0x00, 0x00, 0xFF};
+      REQUIRE(cbor::encode(property_container) == expected);
+      REQUIRE(cbor::encode(property_container).size() == 0);
+      REQUIRE(registry.cloudValue(0) == 2.0f);
+    }
+  }
+
+  WHEN("The value changes by less than the minimum delta")
+  {
+    value = 1.25f;
+
+    THEN("it is not encoded")
+    {
+      REQUIRE(registry.scan() == 0);
+      REQUIRE(cbor::encode(property_container).size() == 0);
+    }
+  }
+
+  WHEN("The value is changed by the cloud")
+  {
+    registry.cloudValue(0) = 7.0f;
+    wrapper.fromCloudToLocal();
+
+    THEN("the primitive value is updated and nothing is sent back")
+    {
+      REQUIRE(value == 7.0f);
+      REQUIRE(registry.scan() == 0);
+      REQUIRE(cbor::encode(property_container).size() == 0);
+    }
+  }
+
+  WHEN("A wrapper could not be attached")
+  {
+    other = 3.0f;
+
+    THEN("it detects its changes by itself")
+    {
+      REQUIRE(cbor::encode(property_container).size() != 0);
+    }
+  }
+}
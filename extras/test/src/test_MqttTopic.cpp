@@ -0,0 +1,82 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <string.h>
+
+#include <utility/mqtt/MqttTopic.h>
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Incoming topics are matched against precomputed MQTT topics", "[MqttTopic]")
+{
+  MqttTopic topic;
+
+  WHEN("No topic has been set")
+  {
+    THEN("the topic is empty and matches nothing, not even an empty topic")
+    {
+      REQUIRE(topic.isEmpty() == true);
+      REQUIRE(topic.length() == 0);
+      REQUIRE(strcmp(topic.c_str(), "") == 0);
+      REQUIRE(topic.matches(String("")) == false);
+    }
+  }
+
+  WHEN("A topic is set")
+  {
+    REQUIRE(topic.set(String("/a/t/thing/e/i")) == true);
+
+    THEN("a copy of the topic and its length are stored")
+    {
+      REQUIRE(topic.isEmpty() == false);
+      REQUIRE(topic.length() == 14);
+      REQUIRE(strcmp(topic.c_str(), "/a/t/thing/e/i") == 0);
+    }
+
+    THEN("only the identical topic matches")
+    {
+      REQUIRE(topic.matches(String("/a/t/thing/e/i")) == true);
+      REQUIRE(topic.matches(String("/a/t/thing/e/o")) == false);
+      REQUIRE(topic.matches(String("/a/t/thing/e/i/")) == false);
+      REQUIRE(topic.matches(String("/a/t/thing/e/")) == false);
+    }
+
+    THEN("a topic with the same length and hash but different content does not match")
+    {
+      char const other[] = "/a/t/thing/e/o";
+      REQUIRE(topic.matches(other, strlen(other), MqttTopic::hash(topic.c_str(), topic.length())) == false);
+    }
+  }
+
+  WHEN("A topic exceeding the maximum length is set")
+  {
+    topic.set(String("/a/t/thing/e/i"));
+
+    THEN("it is rejected and the topic is cleared")
+    {
+      REQUIRE(topic.set(String(MqttTopic::MAX_LENGTH + 1, 'x')) == false);
+      REQUIRE(topic.isEmpty() == true);
+      REQUIRE(topic.matches(String("/a/t/thing/e/i")) == false);
+    }
+  }
+
+  WHEN("A topic of exactly the maximum length is set")
+  {
+    String const max_topic(MqttTopic::MAX_LENGTH, 'x');
+
+    THEN("it is accepted")
+    {
+      REQUIRE(topic.set(max_topic) == true);
+      REQUIRE(topic.matches(max_topic) == true);
+    }
+  }
+}
@@ -0,0 +1,223 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <utility/mqtt/RetransmitQueue.h>
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Published messages are kept until they are acknowledged", "[RetransmitQueue]")
+{
+  RetransmitQueue<4, 8> queue;
+  uint8_t const msg_1[] = {0x01};
+  uint8_t const msg_2[] = {0x02, 0x02};
+  uint8_t const msg_3[] = {0x03, 0x03, 0x03};
+
+  uint16_t const id_1 = queue.push(msg_1, sizeof(msg_1));
+  uint16_t const id_2 = queue.push(msg_2, sizeof(msg_2));
+  uint16_t const id_3 = queue.push(msg_3, sizeof(msg_3));
+
+  WHEN("Messages are pushed into the queue")
+  {
+    THEN("each one gets its own non-zero packet id and a copy of the data")
+    {
+      REQUIRE(id_1 != 0);
+      REQUIRE(id_2 != id_1);
+      REQUIRE(id_3 != id_2);
+      REQUIRE(queue.size() == 3);
+
+      uint8_t const * data = nullptr;
+      size_t length = 0;
+      REQUIRE(queue.get(id_2, data, length) == true);
+      REQUIRE(length == sizeof(msg_2));
+      REQUIRE(data[0] == 0x02);
+      REQUIRE(data[1] == 0x02);
+    }
+  }
+
+  WHEN("A message is acknowledged")
+  {
+    THEN("only that message is removed from the queue")
+    {
+      REQUIRE(queue.ack(id_2) == true);
+      REQUIRE(queue.ack(id_2) == false);
+      REQUIRE(queue.size() == 2);
+
+      uint8_t const * data = nullptr;
+      size_t length = 0;
+      REQUIRE(queue.get(id_2, data, length) == false);
+      REQUIRE(queue.get(id_1, data, length) == true);
+      REQUIRE(queue.get(id_3, data, length) == true);
+    }
+  }
+
+  WHEN("An unknown packet id is acknowledged")
+  {
+    THEN("the queue is not modified")
+    {
+      REQUIRE(queue.ack(0) == false);
+      REQUIRE(queue.ack(id_3 + 1) == false);
+      REQUIRE(queue.size() == 3);
+    }
+  }
+
+  WHEN("A message is too large for the queue")
+  {
+    uint8_t const msg[9] = {0};
+
+    THEN("it is rejected")
+    {
+      REQUIRE(queue.push(msg, sizeof(msg)) == 0);
+      REQUIRE(queue.size() == 3);
+    }
+  }
+
+  WHEN("The queue is full")
+  {
+    uint16_t const id_4 = queue.push(msg_1, sizeof(msg_1));
+    REQUIRE(queue.isFull() == true);
+    uint16_t const id_5 = queue.push(msg_1, sizeof(msg_1));
+
+    THEN("a new message is rejected and no message waiting for its acknowledge is dropped")
+    {
+      REQUIRE(id_5 == 0);
+      REQUIRE(queue.size() == 4);
+
+      uint8_t const * data = nullptr;
+      size_t length = 0;
+      REQUIRE(queue.get(id_1, data, length) == true);
+      REQUIRE(queue.get(id_4, data, length) == true);
+    }
+
+    THEN("a new message is accepted once a message has been acknowledged")
+    {
+      REQUIRE(queue.ack(id_2) == true);
+      REQUIRE(queue.push(msg_1, sizeof(msg_1)) != 0);
+      REQUIRE(queue.isFull() == true);
+    }
+  }
+}
+
+SCENARIO("Messages which were not acknowledged are retransmitted", "[RetransmitQueue]")
+{
+  RetransmitQueue<4, 8> queue;
+  uint8_t const msg[] = {0xAA};
+
+  uint16_t const id_1 = queue.push(msg, sizeof(msg));
+  uint16_t const id_2 = queue.push(msg, sizeof(msg));
+  uint16_t const id_3 = queue.push(msg, sizeof(msg));
+
+  WHEN("No retransmission has been requested")
+  {
+    THEN("there is nothing to retransmit")
+    {
+      REQUIRE(queue.nextResend() == 0);
+    }
+  }
+
+  WHEN("A retransmission is requested after some messages have been acknowledged")
+  {
+    queue.ack(id_2);
+    queue.requestResend();
+
+    THEN("only the pending messages are retransmitted, oldest first and only once")
+    {
+      REQUIRE(queue.nextResend() == id_1);
+      REQUIRE(queue.nextResend() == id_3);
+      REQUIRE(queue.nextResend() == 0);
+      REQUIRE(queue.size() == 2);
+    }
+  }
+
+  WHEN("Messages are pushed after a retransmission has been requested")
+  {
+    queue.requestResend();
+    queue.push(msg, sizeof(msg));
+
+    THEN("the new message is not retransmitted")
+    {
+      REQUIRE(queue.nextResend() == id_1);
+      REQUIRE(queue.nextResend() == id_2);
+      REQUIRE(queue.nextResend() == id_3);
+      REQUIRE(queue.nextResend() == 0);
+    }
+  }
+}
+
+SCENARIO("Released messages are kept for a retransmission only", "[RetransmitQueue]")
+{
+  RetransmitQueue<2, 8> queue;
+  uint8_t const msg[] = {0xAA};
+
+  uint16_t const id_1 = queue.push(msg, sizeof(msg));
+  uint16_t const id_2 = queue.push(msg, sizeof(msg));
+
+  WHEN("A message is released")
+  {
+    REQUIRE(queue.release(id_2) == true);
+
+    THEN("it is no longer pending but is still retransmitted")
+    {
+      REQUIRE(queue.size() == 1);
+      queue.requestResend();
+      REQUIRE(queue.nextResend() == id_1);
+      REQUIRE(queue.nextResend() == id_2);
+      REQUIRE(queue.nextResend() == 0);
+    }
+
+    THEN("it is replaced before an older pending message")
+    {
+      uint16_t const id_3 = queue.push(msg, sizeof(msg));
+      uint8_t const * data = nullptr;
+      size_t length = 0;
+      REQUIRE(queue.get(id_1, data, length) == true);
+      REQUIRE(queue.get(id_2, data, length) == false);
+      REQUIRE(queue.get(id_3, data, length) == true);
+    }
+  }
+
+  WHEN("Every message is released, as with QoS 0")
+  {
+    queue.release(id_1);
+    queue.release(id_2);
+    for (int i = 0; i < 10; i++)
+      REQUIRE(queue.release(queue.push(msg, sizeof(msg))) == true);
+
+    THEN("no message is pending")
+    {
+      REQUIRE(queue.size() == 0);
+    }
+  }
+}
+
+SCENARIO("Packet ids wrap around", "[RetransmitQueue]")
+{
+  RetransmitQueue<2, 1> queue;
+  uint8_t const msg[] = {0x00};
+
+  WHEN("The packet id passes 65535 while messages are pending")
+  {
+    for (unsigned int i = 1; i < 65535; i++)
+      queue.ack(queue.push(msg, sizeof(msg)));
+
+    uint16_t const id_1 = queue.push(msg, sizeof(msg));
+    uint16_t const id_2 = queue.push(msg, sizeof(msg));
+
+    THEN("packet id 0 is skipped and messages are still retransmitted oldest first")
+    {
+      REQUIRE(id_1 == 65535);
+      REQUIRE(id_2 == 1);
+      queue.requestResend();
+      REQUIRE(queue.nextResend() == id_1);
+      REQUIRE(queue.nextResend() == id_2);
+    }
+  }
+}
@@ -0,0 +1,141 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <limits>
+
+#include <utility/time/TimedAttempt.h>
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("A failed operation is retried with exponential backoff", "[TimedAttempt]")
+{
+  unsigned long const MIN_DELAY_ms = 1000;
+  unsigned long const MAX_DELAY_ms = 32000;
+
+  set_millis(0);
+  TimedAttempt attempt(MIN_DELAY_ms, MAX_DELAY_ms);
+
+  WHEN("No attempt has failed yet")
+  {
+    THEN("it is not a retry and the attempt can be performed immediately")
+    {
+      REQUIRE(attempt.isRetry() == false);
+      REQUIRE(attempt.getRetryCount() == 0);
+      REQUIRE(attempt.isExpired() == true);
+    }
+  }
+
+  WHEN("An attempt fails")
+  {
+    unsigned long const wait_time_ms = attempt.retry();
+
+    THEN("the wait time is within [min_delay / 2, min_delay]")
+    {
+      REQUIRE(attempt.isRetry() == true);
+      REQUIRE(attempt.getRetryCount() == 1);
+      REQUIRE(attempt.getWaitTime() == wait_time_ms);
+      REQUIRE(wait_time_ms >= MIN_DELAY_ms / 2);
+      REQUIRE(wait_time_ms <= MIN_DELAY_ms);
+    }
+
+    THEN("the attempt expires exactly when the wait time has elapsed")
+    {
+      set_millis(wait_time_ms - 1);
+      REQUIRE(attempt.isExpired() == false);
+      set_millis(wait_time_ms);
+      REQUIRE(attempt.isExpired() == true);
+    }
+  }
+
+  WHEN("Attempts keep failing")
+  {
+    THEN("the backoff delay doubles with every failure and saturates at max_delay")
+    {
+      unsigned long expected_delay_ms = MIN_DELAY_ms;
+      for (unsigned int i = 1; i <= 10; i++)
+      {
+        unsigned long const wait_time_ms = attempt.retry();
+        REQUIRE(attempt.getRetryCount() == i);
+        REQUIRE(wait_time_ms >= expected_delay_ms / 2);
+        REQUIRE(wait_time_ms <= expected_delay_ms);
+        expected_delay_ms = std::min(expected_delay_ms * 2, MAX_DELAY_ms);
+      }
+    }
+  }
+
+  WHEN("The attempt succeeds after some failures")
+  {
+    attempt.retry();
+    attempt.retry();
+    attempt.reset();
+
+    THEN("the backoff starts again from min_delay")
+    {
+      REQUIRE(attempt.isRetry() == false);
+      REQUIRE(attempt.getRetryCount() == 0);
+      REQUIRE(attempt.isExpired() == true);
+      REQUIRE(attempt.retry() <= MIN_DELAY_ms);
+    }
+  }
+
+  WHEN("The tick counter wraps around while waiting")
+  {
+    unsigned long const MAX_TICK = std::numeric_limits<unsigned long>::max();
+    set_millis(MAX_TICK - 100);
+    unsigned long const wait_time_ms = attempt.retry();
+
+    THEN("the attempt still expires after the wait time")
+    {
+      set_millis(MAX_TICK);
+      REQUIRE(attempt.isExpired() == false);
+      set_millis(MAX_TICK - 100 + wait_time_ms);
+      REQUIRE(attempt.isExpired() == true);
+    }
+  }
+}
+
+SCENARIO("Retry jitter depends on the seed", "[TimedAttempt]")
+{
+  set_millis(0);
+
+  WHEN("Two attempts are seeded identically")
+  {
+    TimedAttempt attempt_1(1000, 32000), attempt_2(1000, 32000);
+    attempt_1.seed(0xCAFE);
+    attempt_2.seed(0xCAFE);
+
+    THEN("they produce the same sequence of wait times")
+    {
+      for (int i = 0; i < 8; i++)
+        REQUIRE(attempt_1.retry() == attempt_2.retry());
+    }
+  }
+
+  WHEN("Attempts are seeded differently")
+  {
+    THEN("the wait times are spread across the jitter window")
+    {
+      unsigned long min_wait_time_ms = 32000, max_wait_time_ms = 0;
+      for (uint32_t seed = 1; seed <= 100; seed++)
+      {
+        TimedAttempt attempt(32000, 32000);
+        attempt.seed(seed * 2654435761UL);
+        unsigned long const wait_time_ms = attempt.retry();
+        min_wait_time_ms = std::min(min_wait_time_ms, wait_time_ms);
+        max_wait_time_ms = std::max(max_wait_time_ms, wait_time_ms);
+      }
+      REQUIRE(min_wait_time_ms < 20000);
+      REQUIRE(max_wait_time_ms > 28000);
+    }
+  }
+}
@@ -0,0 +1,109 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <vector>
+
+#include <utility/trace/Trace.h>
+
+/**************************************************************************************
+   LOCAL CLASSES
+ **************************************************************************************/
+
+class BufferWriter
+{
+public:
+  size_t write(uint8_t const * data, size_t const length)
+  {
+    bytes.insert(bytes.end(), data, data + length);
+    return length;
+  }
+  std::vector<uint8_t> bytes;
+};
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Events are recorded in a ring buffer", "[Trace]")
+{
+  TraceBuffer<4> trace;
+  set_millis(0);
+
+  WHEN("Fewer events than the buffer can hold are recorded")
+  {
+    trace.record(TraceEvent::MqttConnectBegin);
+    set_millis(2);
+    trace.record(TraceEvent::MqttConnectEnd, 1, 0);
+
+    THEN("they are kept in order with their timestamp and arguments")
+    {
+      REQUIRE(trace.size() == 2);
+      REQUIRE(trace.getDroppedCount() == 0);
+      REQUIRE(trace.get(0).event == static_cast<uint16_t>(TraceEvent::MqttConnectBegin));
+      REQUIRE(trace.get(0).timestamp_us == 0);
+      REQUIRE(trace.get(1).event == static_cast<uint16_t>(TraceEvent::MqttConnectEnd));
+      REQUIRE(trace.get(1).timestamp_us == 2000);
+      REQUIRE(trace.get(1).arg0 == 1);
+    }
+  }
+
+  WHEN("More events than the buffer can hold are recorded")
+  {
+    for (uint32_t i = 0; i < 6; i++)
+      trace.record(TraceEvent::MessageIn, 0, i);
+
+    THEN("the oldest ones are overwritten and counted as dropped")
+    {
+      REQUIRE(trace.size() == 4);
+      REQUIRE(trace.getDroppedCount() == 2);
+      for (size_t i = 0; i < 4; i++)
+        REQUIRE(trace.get(i).arg1 == i + 2);
+    }
+  }
+
+  WHEN("The buffer is cleared")
+  {
+    trace.record(TraceEvent::MessageIn, 0, 0);
+    trace.clear();
+
+    THEN("no event is left")
+    {
+      REQUIRE(trace.size() == 0);
+      REQUIRE(trace.getDroppedCount() == 0);
+    }
+  }
+}
+
+SCENARIO("The trace buffer is dumped in a binary format", "[Trace]")
+{
+  TraceBuffer<2> trace;
+  BufferWriter out;
+  set_millis(0x10);
+
+  WHEN("The buffer has wrapped around")
+  {
+    trace.record(TraceEvent::Encode);
+    trace.record(TraceEvent::Decode, 0, 0x1234);
+    trace.record(TraceEvent::StateTransition, 0x0405, 0xAABBCCDD);
+    size_t const bytes_written = trace.dump(out);
+
+    THEN("a little endian header is followed by the entries from the oldest to the newest")
+    {
+      std::vector<uint8_t> const expected =
+      {
+        'T', 'R', 'C', 0x01, 0x02, 0x00, 0x0C, 0x00, 0x01, 0x00, 0x00, 0x00,
+        0x80, 0x3E, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x34, 0x12, 0x00, 0x00,
+        0x80, 0x3E, 0x00, 0x00, 0x01, 0x00, 0x05, 0x04, 0xDD, 0xCC, 0xBB, 0xAA,
+      };
+      REQUIRE(bytes_written == expected.size());
+      REQUIRE(out.bytes == expected);
+    }
+  }
+}
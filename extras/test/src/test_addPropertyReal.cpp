@@ -81,4 +81,76 @@ SCENARIO("The same arduino cloud properties are added multiple times", "[Arduino
       REQUIRE(str_property_ptr_1 == str_property_ptr_2);
     }
   }
-}
\ No newline at end of file
+}
+
+SCENARIO("The names of arduino cloud properties are stored without copying string literals", "[ArduinoCloudThing::addPropertyToContainer]")
+{
+  PropertyContainer property_container;
+
+  CloudInt literal_property = 1;
+  CloudInt composed_property = 2;
+  CloudInt buffer_property = 3;
+
+  static char const LITERAL_NAME[] = "literal_property";
+  addPropertyToContainer(property_container, literal_property, LiteralName(LITERAL_NAME), Permission::ReadWrite);
+
+  String composed_name = "composed";
+  composed_name += "_property";
+  addPropertyToContainer(property_container, composed_property, composed_name, Permission::ReadWrite);
+  composed_name = "changed";
+
+  char buffer_name[32];
+  snprintf(buffer_name, sizeof(buffer_name), "buffer_%d", 3);
+  addPropertyToContainer(property_container, buffer_property, buffer_name, Permission::ReadWrite);
+  snprintf(buffer_name, sizeof(buffer_name), "changed");
+
+  WHEN("A property is added with a string literal as name")
+  {
+    THEN("the property refers to the literal")
+    {
+      REQUIRE(literal_property.name() == LITERAL_NAME);
+      REQUIRE(literal_property.nameLength() == strlen(LITERAL_NAME));
+    }
+  }
+
+  WHEN("A property is added with a name composed at runtime")
+  {
+    THEN("the property keeps a copy of the name")
+    {
+      REQUIRE(String(composed_property.name()) == "composed_property");
+    }
+  }
+
+  WHEN("A property is added with a name written into a buffer at runtime")
+  {
+    THEN("the property keeps a copy of the name")
+    {
+      REQUIRE(buffer_property.name() != buffer_name);
+      REQUIRE(String(buffer_property.name()) == "buffer_3");
+      REQUIRE(getProperty(property_container, "buffer_3") == &buffer_property);
+    }
+  }
+
+  WHEN("A property is looked up by name")
+  {
+    THEN("the length and hash of the name are compared first")
+    {
+      REQUIRE(getProperty(property_container, "literal_property") == &literal_property);
+      REQUIRE(getProperty(property_container, String("composed_property")) == &composed_property);
+      REQUIRE(getProperty(property_container, "composed_propertx") == nullptr);
+      REQUIRE(getProperty(property_container, "literal") == nullptr);
+    }
+  }
+
+  WHEN("A property is copied")
+  {
+    CloudInt copy = composed_property;
+
+    THEN("a name composed at runtime is copied as well")
+    {
+      REQUIRE(copy.name() != composed_property.name());
+      REQUIRE(String(copy.name()) == "composed_property");
+      REQUIRE(copy == composed_property);
+    }
+  }
+}
@@ -0,0 +1,199 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <util/AllocationTracker.h>
+#include <util/PropertyTestUtil.h>
+
+#include <CBOREncoder.h>
+#include <CBORDecoder.h>
+#include "types/CloudColor.h"
+#include "types/CloudWrapperBool.h"
+#include "types/CloudWrapperFloat.h"
+#include "types/CloudWrapperInt.h"
+#include "types/CloudWrapperString.h"
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+/* The test utility cbor::encode returns a std::vector which would be counted
+ * as well, hence the payload is encoded into a static buffer instead.
+ */
+static int encode(PropertyContainer & property_container, bool const light_payload = false)
+{
+  static uint8_t buf[256];
+  int bytes_encoded = 0;
+  CBOREncoder::encode(property_container, buf, sizeof(buf), bytes_encoded, light_payload);
+  return bytes_encoded;
+}
+
+/* Note: Catch allocates memory when entering a section, hence the statistics
+ * of a scope are read before entering the THEN section checking them.
+ */
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Encoding and decoding properties performs a bounded number of heap allocations", "[Allocations]")
+{
+  PropertyContainer property_container;
+
+  CloudBool   bool_value   = false;
+  CloudInt    int_value    = 0;
+  CloudFloat  float_value  = 0.0f;
+  CloudString string_value = "short";
+  CloudColor  color_value  = CloudColor(0.0, 0.0, 0.0);
+
+  addPropertyToContainer(property_container, bool_value,   "bool",   Permission::ReadWrite, 1);
+  addPropertyToContainer(property_container, int_value,    "int",    Permission::ReadWrite, 2);
+  addPropertyToContainer(property_container, float_value,  "float",  Permission::ReadWrite, 3);
+  addPropertyToContainer(property_container, string_value, "string", Permission::ReadWrite, 4);
+  addPropertyToContainer(property_container, color_value,  "color",  Permission::ReadWrite, 5);
+
+  /* All properties are published after being added, ensure the rate limit has elapsed. */
+  set_millis(0);
+  encode(property_container);
+  set_millis(1000);
+
+  WHEN("A container without changed properties is encoded")
+  {
+    alloc::Scope scope;
+    int const bytes_encoded = encode(property_container);
+    unsigned long const allocations = scope.allocations();
+
+    THEN("nothing is encoded and no heap allocation is performed")
+    {
+      REQUIRE(bytes_encoded == 0);
+      REQUIRE(allocations == 0);
+    }
+  }
+
+  WHEN("Changed properties are encoded")
+  {
+    bool_value = true;
+    int_value = 7;
+    float_value = 1.5f;
+    string_value = "other";
+    color_value = Color(120.0, 50.0, 80.0);
+
+    alloc::Scope scope;
+    int const bytes_encoded = encode(property_container);
+    unsigned long const allocations = scope.allocations();
+    unsigned long const leaks = scope.leaks();
+
+    THEN("at most one heap allocation is performed and no memory is leaked")
+    {
+      REQUIRE(bytes_encoded > 0);
+      REQUIRE(allocations <= 1);
+      REQUIRE(leaks == 0);
+    }
+  }
+
+  WHEN("A payload updating two properties is decoded")
+  {
+    /* [{0: "int", 2: 7}, {0: "string", 3: "other"}] */
+    uint8_t const payload[] = {0x82, 0xA2, 0x00, 0x63, 0x69, 0x6E, 0x74, 0x02, 0x07,
+                                     0xA2, 0x00, 0x66, 0x73, 0x74, 0x72, 0x69, 0x6E, 0x67, 0x03, 0x65, 0x6F, 0x74, 0x68, 0x65, 0x72};
+
+    alloc::Scope scope;
+    CBORDecoder::decode(property_container, payload, sizeof(payload));
+    unsigned long const allocations = scope.allocations();
+    unsigned long const leaks = scope.leaks();
+    size_t const peak_bytes = scope.peak_bytes();
+
+    THEN("the strings duplicated by the decoder are released again")
+    {
+      REQUIRE(int_value == 7);
+      REQUIRE(string_value == "other");
+      REQUIRE(allocations <= 5);
+      REQUIRE(leaks == 0);
+      REQUIRE(peak_bytes <= 512);
+    }
+  }
+}
+
+SCENARIO("The RAM occupied by a property is reported", "[Allocations]")
+{
+  size_t const PROPERTY_CNT = 200;
+  static int values[PROPERTY_CNT];
+  /* Released after the container referring to them, reserved up front in
+   * order not to be counted within the scopes below.
+   */
+  std::vector<std::unique_ptr<Property>> wrappers;
+  wrappers.reserve(PROPERTY_CNT);
+  PropertyContainer property_container;
+
+  /* Stand-ins for the string literals passed by ArduinoCloud.addProperty() */
+  static std::vector<std::string> names;
+  for (size_t i = names.size(); i < PROPERTY_CNT; i++)
+    names.push_back("p" + std::to_string(i));
+
+  WHEN("Properties only using the default settings are added like by ArduinoCloud.addProperty()")
+  {
+    alloc::Scope scope;
+    for (size_t i = 0; i < PROPERTY_CNT; i++)
+    {
+      wrappers.emplace_back(new CloudWrapperInt(values[i]));
+      addPropertyToContainer(property_container, *wrappers.back(), LiteralName(names[i].c_str()), Permission::ReadWrite, i + 1).publishOnChange(1, 1000);
+    }
+    size_t const bytes_per_property = scope.bytes() / PROPERTY_CNT;
+    WARN("sizeof(Property): " << sizeof(Property) << ", heap bytes/property: " << bytes_per_property);
+
+    THEN("the policy and timer settings of unused features do not occupy any memory")
+    {
+      REQUIRE(sizeof(Property) <= 128);
+    }
+  }
+
+  WHEN("Properties are added like by the legacy ArduinoCloud.addPropertyReal()")
+  {
+    alloc::Scope scope;
+    for (size_t i = 0; i < PROPERTY_CNT; i++)
+    {
+      wrappers.emplace_back(new CloudWrapperInt(values[i]));
+      Property & property = addPropertyToContainer(property_container, *wrappers.back(), LiteralName(names[i].c_str()), Permission::ReadWrite, i + 1);
+      if (i % 2)
+        property.publishOnChange(0.0f, Property::DEFAULT_MIN_TIME_BETWEEN_UPDATES_MILLIS).onUpdate(nullptr).onSync(CLOUD_WINS);
+      else
+        property.publishEvery(10).onUpdate(nullptr).onSync(CLOUD_WINS);
+    }
+    size_t const bytes_per_property = scope.bytes() / PROPERTY_CNT;
+    unsigned long const allocations = scope.allocations();
+    WARN("heap bytes/property added by the legacy addPropertyReal(): " << bytes_per_property);
+
+    THEN("the default callbacks and a time interval do not allocate any settings")
+    {
+      /* The wrapper and the node of the property list */
+      REQUIRE(allocations == 2 * PROPERTY_CNT);
+    }
+  }
+
+  WHEN("Properties using a callback and a time interval are added")
+  {
+    alloc::Scope scope;
+    for (size_t i = 0; i < PROPERTY_CNT; i++)
+    {
+      wrappers.emplace_back(new CloudWrapperInt(values[i]));
+      addPropertyToContainer(property_container, *wrappers.back(), LiteralName(names[i].c_str()), Permission::ReadWrite, i + 1).onUpdate([]() { }).publishEvery(10);
+    }
+    size_t const bytes_per_property = scope.bytes() / PROPERTY_CNT;
+    WARN("heap bytes/property with callback and time interval: " << bytes_per_property);
+
+    THEN("only those settings are allocated in addition")
+    {
+      REQUIRE(bytes_per_property >= sizeof(CloudWrapperInt) + sizeof(PropertyExtension));
+    }
+  }
+}
@@ -8,6 +8,8 @@
 
 #include <catch.hpp>
 
+#include <limits.h>
+
 #include <memory>
 
 #include <util/CBORTestUtil.h>
@@ -70,6 +72,41 @@ SCENARIO("Arduino Cloud Properties are decoded", "[ArduinoCloudThing::decode]")
 
   /************************************************************************************/
 
+  WHEN("A boolean property with an identifier exceeding 255 is changed via CBOR message - light payload")
+  {
+    PropertyContainer property_container;
+
+    CloudBool test = true, other = true;
+    addPropertyToContainer(property_container, test, "test", Permission::ReadWrite, 300);
+    /* 300 & 255, which would have been matched by the former identifier scheme */
+    addPropertyToContainer(property_container, other, "other", Permission::ReadWrite, 44);
+
+    /* [{0: [300, 0], 4: false}] = 81 A2 00 82 19 01 2C 00 04 F4 */
+    uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x82, 0x19, 0x01, 0x2C, 0x00, 0x04, 0xF4};
+    CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+    REQUIRE(test == false);
+    REQUIRE(other == true);
+  }
+
+  /************************************************************************************/
+
+  WHEN("A boolean property is changed via CBOR message - light payload without attribute identifier")
+  {
+    PropertyContainer property_container;
+
+    CloudBool test = true;
+    addPropertyToContainer(property_container, test, "test", Permission::ReadWrite, 1);
+
+    /* [{0: [1], 4: false}] = 81 A2 00 81 01 04 F4 */
+    uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x81, 0x01, 0x04, 0xF4};
+    CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+    REQUIRE(test == false);
+  }
+
+  /************************************************************************************/
+
   WHEN("A positive int property is changed via CBOR message")
   {
     PropertyContainer property_container;
@@ -136,6 +173,68 @@ SCENARIO("Arduino Cloud Properties are decoded", "[ArduinoCloudThing::decode]")
 
   /************************************************************************************/
 
+  WHEN("A Blob property is changed via CBOR message")
+  {
+    PropertyContainer property_container;
+
+    uint8_t buffer[4] = {0};
+    CloudBlob blob_test(buffer, sizeof(buffer));
+    addPropertyToContainer(property_container, blob_test, "test", Permission::ReadWrite);
+
+    THEN("the bytes are copied from the payload into the buffer")
+    {
+      /* [{0: "test", 8: h'0A0B0C'}] = 81 A2 00 64 74 65 73 74 08 43 0A 0B 0C */
+      uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x08, 0x43, 0x0A, 0x0B, 0x0C};
+      CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+      REQUIRE(blob_test.length() == 3);
+      REQUIRE(buffer[0] == 0x0A);
+      REQUIRE(buffer[1] == 0x0B);
+      REQUIRE(buffer[2] == 0x0C);
+    }
+
+    THEN("a value exceeding the buffer is ignored")
+    {
+      /* [{0: "test", 8: h'0102030405'}] = 81 A2 00 64 74 65 73 74 08 45 01 02 03 04 05 */
+      uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x08, 0x45, 0x01, 0x02, 0x03, 0x04, 0x05};
+      CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+      REQUIRE(blob_test.length() == 0);
+      REQUIRE(buffer[0] == 0x00);
+    }
+
+    THEN("a chunked value is skipped")
+    {
+      /* [{0: "test", 8: (_ h'0A', h'0B')}] = 81 A2 00 64 74 65 73 74 08 5F 41 0A 41 0B FF */
+      uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x08, 0x5F, 0x41, 0x0A, 0x41, 0x0B, 0xFF};
+      CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+      REQUIRE(blob_test.length() == 0);
+    }
+
+    THEN("an ignored value after a sync won by the device does not copy from the sync payload")
+    {
+      blob_test.onSync(DEVICE_WINS);
+
+      /* [{0: "test", 8: h'0A0B0C'}] = 81 A2 00 64 74 65 73 74 08 43 0A 0B 0C */
+      uint8_t sync_payload[] = {0x81, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x08, 0x43, 0x0A, 0x0B, 0x0C};
+      CBORDecoder::decode(property_container, sync_payload, sizeof(sync_payload) / sizeof(uint8_t), true);
+      REQUIRE(blob_test.length() == 0);
+
+      /* The sync payload is gone once the decoder returns. */
+      memset(sync_payload, 0xEE, sizeof(sync_payload));
+
+      /* [{0: "test", 8: h'0102030405'}] = 81 A2 00 64 74 65 73 74 08 45 01 02 03 04 05 */
+      uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x08, 0x45, 0x01, 0x02, 0x03, 0x04, 0x05};
+      CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+      REQUIRE(blob_test.length() == 0);
+      REQUIRE(buffer[0] == 0x00);
+    }
+  }
+
+  /************************************************************************************/
+
   WHEN("A Location property is changed via CBOR message")
   {
     PropertyContainer property_container;
@@ -202,6 +301,25 @@ SCENARIO("Arduino Cloud Properties are decoded", "[ArduinoCloudThing::decode]")
 
   /************************************************************************************/
 
+  WHEN("A Color property with an identifier exceeding 255 is changed via CBOR message - light payload")
+  {
+    PropertyContainer property_container;
+
+    CloudColor color_test = CloudColor(0.0, 0.0, 0.0);
+    addPropertyToContainer(property_container, color_test, "test", Permission::ReadWrite, 300);
+
+    /* [{0: [300, 1], 2: 2.0},{0: [300, 2], 2: 3.0},{0: [300, 3], 2: 4.0}] = 83 A2 00 82 19 01 2C 01 02 FA 40 00 00 00 A2 00 82 19 01 2C 02 02 FA 40 40 00 00 A2 00 82 19 01 2C 03 02 FA 40 80 00 00 */
+    uint8_t const payload[] = {0x83, 0xA2, 0x00, 0x82, 0x19, 0x01, 0x2C, 0x01, 0x02, 0xFA, 0x40, 0x00, 0x00, 0x00, 0xA2, 0x00, 0x82, 0x19, 0x01, 0x2C, 0x02, 0x02, 0xFA, 0x40, 0x40, 0x00, 0x00, 0xA2, 0x00, 0x82, 0x19, 0x01, 0x2C, 0x03, 0x02, 0xFA, 0x40, 0x80, 0x00, 0x00};
+    CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+    Color value_color_test = color_test.getValue();
+    REQUIRE(value_color_test.hue == 2.0);
+    REQUIRE(value_color_test.sat == 3.0);
+    REQUIRE(value_color_test.bri == 4.0);
+  }
+
+  /************************************************************************************/
+
   WHEN("A ColoredLight property is changed via CBOR message")
   {
     PropertyContainer property_container;
@@ -604,4 +722,52 @@ SCENARIO("Arduino Cloud Properties are decoded", "[ArduinoCloudThing::decode]")
   }
 
   /************************************************************************************/
+
+  WHEN("A boolean property is changed via CBOR message with a value which is not a boolean")
+  {
+    PropertyContainer property_container;
+
+    CloudBool test = true;
+    addPropertyToContainer(property_container, test, "test", Permission::ReadWrite);
+
+    /* [{0: "test", 4: 0}] = 81 A2 00 64 74 65 73 74 04 00 */
+    uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x04, 0x00};
+    CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+    REQUIRE(test == true);
+  }
+
+  /************************************************************************************/
+
+  WHEN("A payload containing a map which ends with a key without value is parsed")
+  {
+    PropertyContainer property_container;
+
+    CloudInt test = 0;
+    addPropertyToContainer(property_container, test, "test", Permission::ReadWrite);
+
+    /* [{_ 0: "test", 2: 1, 123}] = 81 BF 00 64 74 65 73 74 02 01 18 7B FF */
+    uint8_t const payload[] = {0x81, 0xBF, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x02, 0x01, 0x18, 0x7B, 0xFF};
+    CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+    REQUIRE(test == 0);
+  }
+
+  /************************************************************************************/
+
+  WHEN("An integer property is changed via CBOR message with a value out of the range of int")
+  {
+    PropertyContainer property_container;
+
+    CloudInt test = 0;
+    addPropertyToContainer(property_container, test, "test", Permission::ReadWrite);
+
+    /* [{0: "test", 2: 1.0e20}] = 81 A2 00 64 74 65 73 74 02 FB 44 15 AF 1D 78 B5 8C 40 */
+    uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x02, 0xFB, 0x44, 0x15, 0xAF, 0x1D, 0x78, 0xB5, 0x8C, 0x40};
+    CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+    REQUIRE(test == INT_MAX);
+  }
+
+  /************************************************************************************/
 }
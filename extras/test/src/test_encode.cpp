@@ -11,6 +11,7 @@
 #include <memory>
 
 #include <util/CBORTestUtil.h>
+#include <CBORDecoder.h>
 #include "types/CloudWrapperBool.h"
 #include "types/CloudWrapperFloat.h"
 #include "types/CloudWrapperInt.h"
@@ -57,6 +58,22 @@ SCENARIO("Arduino Cloud Properties are encoded", "[ArduinoCloudThing::encode-1]"
 
   /************************************************************************************/
 
+  WHEN("A 'bool' property with an identifier exceeding 255 is added - light payload")
+  {
+    PropertyContainer property_container;
+    cbor::encode(property_container);
+
+    CloudBool test = true;
+    addPropertyToContainer(property_container, test, "test", Permission::ReadWrite, 300);
+
+    /* [{0: [300, 0], 4: true}] = 9F A2 00 82 19 01 2C 00 04 F5 FF */
+    std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x82, 0x19, 0x01, 0x2C, 0x00, 0x04, 0xF5, 0xFF};
+    std::vector<uint8_t> const actual = cbor::encode(property_container, true);
+    REQUIRE(actual == expected);
+  }
+
+  /************************************************************************************/
+
   WHEN("A 'int' property is added")
   {
     PropertyContainer property_container;
@@ -89,6 +106,68 @@ SCENARIO("Arduino Cloud Properties are encoded", "[ArduinoCloudThing::encode-1]"
 
   /************************************************************************************/
 
+  WHEN("A 'float' property with compact encoding is added - light payload")
+  {
+    PropertyContainer property_container;
+    cbor::encode(property_container);
+
+    CloudFloat float_test;
+    addPropertyToContainer(property_container, float_test, "test", Permission::ReadWrite, 1).encodeCompactFloat().publishOnChange(0, 0);
+
+    THEN("an integral value is encoded as integer")
+    {
+      /* [{0: 1, 2: 2}] = 9F A2 00 01 02 02 FF */
+      float_test = 2.0f;
+      REQUIRE(cbor::encode(property_container, true) == std::vector<uint8_t>{0x9F, 0xA2, 0x00, 0x01, 0x02, 0x02, 0xFF});
+      /* [{0: 1, 2: -100000}] = 9F A2 00 01 02 3A 00 01 86 9F FF */
+      float_test = -100000.0f;
+      REQUIRE(cbor::encode(property_container, true) == std::vector<uint8_t>{0x9F, 0xA2, 0x00, 0x01, 0x02, 0x3A, 0x00, 0x01, 0x86, 0x9F, 0xFF});
+    }
+
+    THEN("a value exactly representable with half precision is encoded as half float")
+    {
+      /* [{0: 1, 2: 1.5}] = 9F A2 00 01 02 F9 3E 00 FF */
+      float_test = 1.5f;
+      REQUIRE(cbor::encode(property_container, true) == std::vector<uint8_t>{0x9F, 0xA2, 0x00, 0x01, 0x02, 0xF9, 0x3E, 0x00, 0xFF});
+      /* [{0: 1, 2: -2.5}] = 9F A2 00 01 02 F9 C1 00 FF */
+      float_test = -2.5f;
+      REQUIRE(cbor::encode(property_container, true) == std::vector<uint8_t>{0x9F, 0xA2, 0x00, 0x01, 0x02, 0xF9, 0xC1, 0x00, 0xFF});
+      /* [{0: 1, 2: 5.960464477539063e-08}] = 9F A2 00 01 02 F9 00 01 FF */
+      float_test = ldexpf(1.0f, -24);
+      REQUIRE(cbor::encode(property_container, true) == std::vector<uint8_t>{0x9F, 0xA2, 0x00, 0x01, 0x02, 0xF9, 0x00, 0x01, 0xFF});
+    }
+
+    THEN("any other value is encoded as single precision float")
+    {
+      /* [{0: 1, 2: 0.1}] = 9F A2 00 01 02 FA 3D CC CC CD FF */
+      float_test = 0.1f;
+      REQUIRE(cbor::encode(property_container, true) == std::vector<uint8_t>{0x9F, 0xA2, 0x00, 0x01, 0x02, 0xFA, 0x3D, 0xCC, 0xCC, 0xCD, 0xFF});
+      /* [{0: 1, 2: 65536.5}] = 9F A2 00 01 02 FA 47 80 00 40 FF */
+      float_test = 65536.5f;
+      REQUIRE(cbor::encode(property_container, true) == std::vector<uint8_t>{0x9F, 0xA2, 0x00, 0x01, 0x02, 0xFA, 0x47, 0x80, 0x00, 0x40, 0xFF});
+    }
+
+    THEN("the decoded value is identical to the encoded one")
+    {
+      PropertyContainer decoded_property_container;
+      CloudFloat decoded;
+      addPropertyToContainer(decoded_property_container, decoded, "test", Permission::ReadWrite, 1);
+
+      for (float const value : {3.0f, -0.75f, 0.1f, 1.0e-6f, 65504.0f, 1.0e9f})
+      {
+        float_test = value;
+        std::vector<uint8_t> msg = cbor::encode(property_container, true);
+        /* Replace the indefinite length array by an array of one element. */
+        msg.front() = 0x81;
+        msg.pop_back();
+        CBORDecoder::decode(decoded_property_container, msg.data(), msg.size());
+        REQUIRE(decoded == value);
+      }
+    }
+  }
+
+  /************************************************************************************/
+
   WHEN("A 'String' property is added")
   {
     PropertyContainer property_container;
@@ -106,6 +185,30 @@ SCENARIO("Arduino Cloud Properties are encoded", "[ArduinoCloudThing::encode-1]"
 
   /************************************************************************************/
 
+  WHEN("A 'Blob' property is added")
+  {
+    PropertyContainer property_container;
+    cbor::encode(property_container);
+
+    uint8_t buffer[8] = {0x01, 0x02, 0x03};
+    CloudBlob blob_test(buffer, sizeof(buffer), 3);
+    addPropertyToContainer(property_container, blob_test, "test", Permission::ReadWrite).publishOnChange(0.0f, 0);
+
+    /* [{0: "test", 8: h'010203'}] = 9F A2 00 64 74 65 73 74 08 43 01 02 03 FF */
+    std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x08, 0x43, 0x01, 0x02, 0x03, 0xFF};
+    REQUIRE(cbor::encode(property_container) == expected);
+    REQUIRE(cbor::encode(property_container).size() == 0);
+
+    buffer[3] = 0x04;
+    blob_test.setLength(4);
+
+    /* [{0: "test", 8: h'01020304'}] = 9F A2 00 64 74 65 73 74 08 44 01 02 03 04 FF */
+    std::vector<uint8_t> const expected_changed = {0x9F, 0xA2, 0x00, 0x64, 0x74, 0x65, 0x73, 0x74, 0x08, 0x44, 0x01, 0x02, 0x03, 0x04, 0xFF};
+    REQUIRE(cbor::encode(property_container) == expected_changed);
+  }
+
+  /************************************************************************************/
+
   WHEN("A 'Location' property is added")
   {
     PropertyContainer property_container;
@@ -156,6 +259,22 @@ SCENARIO("Arduino Cloud Properties are encoded", "[ArduinoCloudThing::encode-1]"
 
   /************************************************************************************/
 
+  WHEN("A 'Color' property with an identifier exceeding 255 is added - light payload")
+  {
+    PropertyContainer property_container;
+    cbor::encode(property_container);
+
+    CloudColor color_test = CloudColor(2.0, 2.0, 2.0);
+    addPropertyToContainer(property_container, color_test, "test", Permission::ReadWrite, 300);
+
+    /* [{0: [300, 1], 2: 2.0},{0: [300, 2], 2: 2.0},{0: [300, 3], 2: 2.0}] = 9F A2 00 82 19 01 2C 01 02 FA 40 00 00 00 A2 00 82 19 01 2C 02 02 FA 40 00 00 00 A2 00 82 19 01 2C 03 02 FA 40 00 00 00 FF */
+    std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x82, 0x19, 0x01, 0x2C, 0x01, 0x02, 0xFA, 0x40, 0x00, 0x00, 0x00, 0xA2, 0x00, 0x82, 0x19, 0x01, 0x2C, 0x02, 0x02, 0xFA, 0x40, 0x00, 0x00, 0x00, 0xA2, 0x00, 0x82, 0x19, 0x01, 0x2C, 0x03, 0x02, 0xFA, 0x40, 0x00, 0x00, 0x00, 0xFF};
+    std::vector<uint8_t> const actual = cbor::encode(property_container, true);
+    REQUIRE(actual == expected);
+  }
+
+  /************************************************************************************/
+
   WHEN("A 'ColoredLight' property is added")
   {
     PropertyContainer property_container;
@@ -417,3 +536,75 @@ SCENARIO("Arduino Cloud Properties are encoded", "[ArduinoCloudThing::encode-1]"
 
   /************************************************************************************/
 }
+
+SCENARIO("Only the changed attributes of composite properties are encoded", "[ArduinoCloudThing::encode-1]")
+{
+  PropertyContainer property_container;
+  set_millis(0);
+
+  WHEN("A single attribute of a 'ColoredLight' property changes")
+  {
+    CloudColoredLight color_test = CloudColoredLight(true, 2.0, 2.0, 2.0);
+    addPropertyToContainer(property_container, color_test, "test", Permission::ReadWrite);
+    cbor::encode(property_container);
+
+    set_millis(1000);
+    color_test.setBrightness(3.0);
+
+    THEN("only this attribute is encoded")
+    {
+      /* [{0: "test:bri", 2: 3.0}] = 9F A2 00 68 74 65 73 74 3A 62 72 69 02 FA 40 40 00 00 FF */
+      std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x68, 0x74, 0x65, 0x73, 0x74, 0x3A, 0x62, 0x72, 0x69, 0x02, 0xFA, 0x40, 0x40, 0x00, 0x00, 0xFF};
+      REQUIRE(cbor::encode(property_container) == expected);
+      REQUIRE(cbor::encode(property_container).size() == 0);
+    }
+  }
+
+  WHEN("The brightness of a 'DimmedLight' property changes - light payload")
+  {
+    CloudDimmedLight light_test = CloudDimmedLight(true, 2.0);
+    addPropertyToContainer(property_container, light_test, "test", Permission::ReadWrite, 1);
+    cbor::encode(property_container, true);
+
+    set_millis(1000);
+    light_test.setBrightness(3.0);
+
+    THEN("neither the switch nor the constant hue and saturation are encoded, the attribute keeps its identifier")
+    {
+      /* [{0: 1025, 2: 3.0}] = 9F A2 00 19 04 01 02 FA 40 40 00 00 FF */
+      std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x19, 0x04, 0x01, 0x02, 0xFA, 0x40, 0x40, 0x00, 0x00, 0xFF};
+      REQUIRE(cbor::encode(property_container, true) == expected);
+    }
+  }
+
+  WHEN("An update of a 'Television' property is requested")
+  {
+    CloudTelevision tv_test = CloudTelevision(true, 50, false, PlaybackCommands::Play, InputValue::TV, 7);
+    addPropertyToContainer(property_container, tv_test, "test", Permission::ReadWrite);
+    size_t const complete_size = cbor::encode(property_container).size();
+
+    set_millis(1000);
+    tv_test.setVolume(60);
+    tv_test.requestUpdate();
+
+    THEN("all attributes are encoded")
+    {
+      REQUIRE(cbor::encode(property_container).size() == complete_size);
+    }
+  }
+
+  WHEN("A 'Color' property published every second changes")
+  {
+    CloudColor color_test = CloudColor(2.0, 2.0, 2.0);
+    addPropertyToContainer(property_container, color_test, "test", Permission::ReadWrite).publishEvery(1);
+    size_t const complete_size = cbor::encode(property_container).size();
+
+    set_millis(1000);
+    color_test = Color(2.0, 2.0, 3.0);
+
+    THEN("all attributes are encoded")
+    {
+      REQUIRE(cbor::encode(property_container).size() == complete_size);
+    }
+  }
+}
@@ -8,3 +8,41 @@
 
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <util/AllocationTracker.h>
+
+/**************************************************************************************
+   CLASS DECLARATION
+ **************************************************************************************/
+
+/* Resets the allocation statistics at the start of every test case and prints
+ * them at its end if the environment variable ALLOCATION_REPORT is set, i.e.
+ * 'ALLOCATION_REPORT=1 bin/testArduinoIoTCloud'.
+ */
+class AllocationReporter : public Catch::TestEventListenerBase
+{
+public:
+
+  using TestEventListenerBase::TestEventListenerBase;
+
+  void testCaseStarting(Catch::TestCaseInfo const & info) override
+  {
+    TestEventListenerBase::testCaseStarting(info);
+    alloc::reset();
+  }
+
+  void testCaseEnded(Catch::TestCaseStats const & stats) override
+  {
+    if (getenv("ALLOCATION_REPORT"))
+    {
+      alloc::Stats const s = alloc::stats();
+      printf("%-100s allocations: %8lu, bytes: %10zu, peak: %8zu\n", stats.testInfo.name.c_str(), s.allocations, s.bytes, s.peak_bytes);
+    }
+    TestEventListenerBase::testCaseEnded(stats);
+  }
+};
+
+CATCH_REGISTER_LISTENER(AllocationReporter)
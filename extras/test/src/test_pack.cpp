@@ -0,0 +1,197 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <vector>
+
+#include <util/CBORTestUtil.h>
+#include <CBORDecoder.h>
+#include <CBOREncoder.h>
+#include "types/CloudLocation.h"
+#include "types/CloudWrapperInt.h"
+#include "types/CloudWrapperString.h"
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+static std::vector<uint8_t> pack(PropertyContainer & property_container, size_t const mtu, CborError & err)
+{
+  int bytes_encoded = 0;
+  uint8_t buf[255] = {0};
+  err = CBOREncoder::pack(property_container, buf, mtu, bytes_encoded, true);
+  return std::vector<uint8_t>(buf, buf + bytes_encoded);
+}
+
+static std::vector<uint8_t> pack(PropertyContainer & property_container, size_t const mtu)
+{
+  CborError err;
+  return pack(property_container, mtu, err);
+}
+
+static bool isValidCbor(std::vector<uint8_t> const & msg)
+{
+  CborParser parser;
+  CborValue it;
+  if (cbor_parser_init(msg.data(), msg.size(), 0, &parser, &it) != CborNoError)
+    return false;
+  return (cbor_value_validate_basic(&it) == CborNoError);
+}
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Changed properties are packed by priority into messages of limited size", "[CBOREncoder::pack]")
+{
+  PropertyContainer property_container;
+  CloudInt low = 1, high = 2, medium = 3;
+  addPropertyToContainer(property_container, low,    "low",    Permission::ReadWrite, 1);
+  addPropertyToContainer(property_container, high,   "high",   Permission::ReadWrite, 2).priority(2);
+  addPropertyToContainer(property_container, medium, "medium", Permission::ReadWrite, 3).priority(1);
+
+  WHEN("All properties fit into a single message")
+  {
+    /* [{0: 2, 2: 2}, {0: 3, 2: 3}, {0: 1, 2: 1}] = 9F A2 00 02 02 02 A2 00 03 02 03 A2 00 01 02 01 FF */
+    std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x02, 0x02, 0x02, 0xA2, 0x00, 0x03, 0x02, 0x03, 0xA2, 0x00, 0x01, 0x02, 0x01, 0xFF};
+    THEN("they are encoded from the highest to the lowest priority")
+    {
+      REQUIRE(pack(property_container, 222) == expected);
+      REQUIRE(pack(property_container, 222).empty());
+    }
+  }
+
+  WHEN("Only two properties fit into a message")
+  {
+    THEN("the property with the lowest priority is deferred to the next message")
+    {
+      std::vector<uint8_t> const first  = {0x9F, 0xA2, 0x00, 0x02, 0x02, 0x02, 0xA2, 0x00, 0x03, 0x02, 0x03, 0xFF};
+      std::vector<uint8_t> const second = {0x9F, 0xA2, 0x00, 0x01, 0x02, 0x01, 0xFF};
+      REQUIRE(pack(property_container, 12) == first);
+      REQUIRE(pack(property_container, 12) == second);
+      REQUIRE(pack(property_container, 12).empty());
+    }
+  }
+
+  WHEN("Not a single property fits into a message")
+  {
+    CborError err = CborNoError;
+    std::vector<uint8_t> const msg = pack(property_container, 6, err);
+
+    THEN("nothing is encoded and the properties are sent as soon as the message size allows it")
+    {
+      REQUIRE(err == CborErrorOutOfMemory);
+      REQUIRE(msg.empty());
+      REQUIRE(pack(property_container, 7).size() == 7);
+      REQUIRE(pack(property_container, 7).size() == 7);
+      REQUIRE(pack(property_container, 7).size() == 7);
+      REQUIRE(pack(property_container, 7).empty());
+    }
+  }
+}
+
+SCENARIO("A property changed by the cloud is echoed even if it is deferred", "[CBOREncoder::pack]")
+{
+  PropertyContainer property_container;
+  CloudString str;
+  str = "0123456789";
+  addPropertyToContainer(property_container, str, "s", Permission::ReadWrite, 1).onUpdate([]() { });
+  REQUIRE(pack(property_container, 64).size() > 0);
+
+  /* [{0: "s", 3: "abcdefghij"}] = 81 A2 00 61 73 03 6A 61 62 63 64 65 66 67 68 69 6A */
+  uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x61, 0x73, 0x03, 0x6A, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A};
+  CBORDecoder::decode(property_container, payload, sizeof(payload));
+  REQUIRE(str == "abcdefghij");
+
+  WHEN("The echo does not fit into the first message")
+  {
+    CborError err = CborNoError;
+    std::vector<uint8_t> const msg = pack(property_container, 12, err);
+
+    THEN("it is sent with the next message which is large enough")
+    {
+      REQUIRE(err == CborErrorOutOfMemory);
+      REQUIRE(msg.empty());
+      /* [{0: 1, 3: "abcdefghij"}] = 9F A2 00 01 03 6A 61 62 63 64 65 66 67 68 69 6A FF */
+      std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x01, 0x03, 0x6A, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0xFF};
+      REQUIRE(pack(property_container, 64) == expected);
+      REQUIRE(pack(property_container, 64).empty());
+    }
+  }
+}
+
+SCENARIO("A property which does not fit is skipped in favour of smaller ones", "[CBOREncoder::pack]")
+{
+  PropertyContainer property_container;
+  CloudString str;
+  str = "a string which is too long for a small message";
+  CloudInt counter = 7;
+  CloudLocation location(1.5f, 2.5f);
+  addPropertyToContainer(property_container, str,      "str",      Permission::ReadWrite, 1).priority(2);
+  addPropertyToContainer(property_container, location, "location", Permission::ReadWrite, 2).priority(1);
+  addPropertyToContainer(property_container, counter,  "counter",  Permission::ReadWrite, 3);
+
+  WHEN("The message is too small for the string and the location")
+  {
+    std::vector<uint8_t> const msg = pack(property_container, 12);
+
+    THEN("only the counter is encoded")
+    {
+      /* [{0: 3, 2: 7}] = 9F A2 00 03 02 07 FF */
+      std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x03, 0x02, 0x07, 0xFF};
+      REQUIRE(msg == expected);
+    }
+
+    THEN("the location, of which one attribute did fit, has been rolled back and is sent once the message is larger")
+    {
+      std::vector<uint8_t> const next = pack(property_container, 32);
+      REQUIRE(next.size() > 12);
+      REQUIRE(next.size() <= 32);
+      REQUIRE(isValidCbor(next));
+      REQUIRE(pack(property_container, 64).size() > 32);
+      REQUIRE(pack(property_container, 255).empty());
+    }
+  }
+}
+
+SCENARIO("Packing respects the maximum payload of different LoRaWAN data rates", "[CBOREncoder::pack]")
+{
+  /* Maximum payload of EU868 DR0-DR2, DR3 and DR4-DR7, and some smaller sizes. */
+  size_t const mtu = GENERATE(as<size_t>{}, 20, 24, 51, 115, 222);
+
+  PropertyContainer property_container;
+  CloudInt i[10];
+  CloudString str;
+  str = "0123456789";
+  for (int id = 0; id < 10; id++) {
+    i[id] = id * 1000;
+    addPropertyToContainer(property_container, i[id], "i" + std::to_string(id), Permission::ReadWrite, id + 1).priority(id % 3);
+  }
+  addPropertyToContainer(property_container, str, "str", Permission::ReadWrite, 11);
+
+  WHEN("All properties are sent in as few messages as needed")
+  {
+    THEN("every message is valid CBOR not exceeding the maximum payload")
+    {
+      size_t msg_cnt = 0, bytes = 0;
+      for (std::vector<uint8_t> msg = pack(property_container, mtu); !msg.empty(); msg = pack(property_container, mtu))
+      {
+        REQUIRE(msg.size() <= mtu);
+        REQUIRE(isValidCbor(msg));
+        msg_cnt++;
+        bytes += msg.size();
+      }
+      REQUIRE(msg_cnt >= 1);
+      REQUIRE(msg_cnt <= 11);
+      REQUIRE(pack(property_container, 255).empty());
+      if (mtu >= 115)
+        REQUIRE(msg_cnt == 1);
+    }
+  }
+}
@@ -0,0 +1,343 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <catch.hpp>
+
+#include <vector>
+
+#include <util/PackedDecoder.h>
+#include <CBOREncoder.h>
+#include <packed/PackedEncoder.h>
+#include "types/CloudLocation.h"
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+static std::vector<uint8_t> encode(PackedEncoder & encoder, PropertyContainer & property_container, size_t const mtu, CborError & err, bool const delivered = true)
+{
+  int bytes_encoded = 0;
+  uint8_t buf[255] = {0};
+  err = encoder.encode(property_container, buf, mtu, bytes_encoded);
+  if (delivered)
+    encoder.commit();
+  return std::vector<uint8_t>(buf, buf + bytes_encoded);
+}
+
+static std::vector<uint8_t> encode(PackedEncoder & encoder, PropertyContainer & property_container, size_t const mtu = 51)
+{
+  CborError err;
+  return encode(encoder, property_container, mtu, err);
+}
+
+static std::string schema(PackedEncoder & encoder, PropertyContainer & property_container)
+{
+  char buf[512];
+  encoder.printSchema(property_container, buf, sizeof(buf));
+  return std::string(buf);
+}
+
+/**************************************************************************************
+   TEST CODE
+ **************************************************************************************/
+
+SCENARIO("Properties are encoded in the packed format and decoded with the exported schema", "[PackedEncoder]")
+{
+  set_millis(0);
+
+  PropertyContainer property_container;
+  CloudBool sw = true;
+  CloudInt counter = 1000;
+  CloudFloat raw = 3.25f;
+  CloudFloat temperature = 21.5f;
+  CloudString str;
+  str = "abc";
+  CloudLocation location(45.123456f, -7.654321f);
+  addPropertyToContainer(property_container, sw,          "sw",          Permission::ReadWrite, 1);
+  addPropertyToContainer(property_container, counter,     "counter",     Permission::ReadWrite, 2);
+  addPropertyToContainer(property_container, raw,         "raw",         Permission::ReadWrite, 3);
+  addPropertyToContainer(property_container, temperature, "temperature", Permission::ReadWrite, 4).encodeFixedPoint(1, 12);
+  addPropertyToContainer(property_container, str,         "str",         Permission::ReadWrite, 5);
+  addPropertyToContainer(property_container, location,    "location",    Permission::ReadWrite, 6).encodeFixedPoint(6, 32);
+
+  PackedEncoder encoder;
+  PackedDecoder decoder;
+
+  WHEN("The schema is exported")
+  {
+    std::string const expected =
+      "packed 2 7\n"
+      "1 sw 1 0 b\n"
+      "2 counter 2 0 i\n"
+      "3 raw 3 0 f\n"
+      "4 temperature 4 0 q 1 12\n"
+      "5 str 5 0 s\n"
+      "6 location 6 1 q 6 32\n"
+      "7 location 6 2 q 6 32\n";
+
+    THEN("every attribute is a field, numbered like in the light payload")
+    {
+      REQUIRE(schema(encoder, property_container) == expected);
+      REQUIRE(encoder.getFieldCount() == 7);
+      REQUIRE(decoder.setSchema(expected));
+    }
+  }
+
+  WHEN("All properties are sent for the first time")
+  {
+    REQUIRE(decoder.setSchema(schema(encoder, property_container)));
+    std::vector<uint8_t> const msg = encode(encoder, property_container);
+
+    THEN("the message is a keyframe of 198 bits, which is way smaller than the CBOR light payload")
+    {
+      REQUIRE(msg.size() == 3 + 25);
+      REQUIRE(msg[0] == 0xFC);
+      REQUIRE(msg[1] == 0x50);
+      REQUIRE(msg[2] == 0x00);
+
+      PropertyContainer cbor_property_container;
+      CloudBool cbor_sw = true;
+      CloudInt cbor_counter = 1000;
+      CloudFloat cbor_raw = 3.25f;
+      CloudFloat cbor_temperature = 21.5f;
+      CloudString cbor_str;
+      cbor_str = "abc";
+      CloudLocation cbor_location(45.123456f, -7.654321f);
+      addPropertyToContainer(cbor_property_container, cbor_sw,          "sw",          Permission::ReadWrite, 1);
+      addPropertyToContainer(cbor_property_container, cbor_counter,     "counter",     Permission::ReadWrite, 2);
+      addPropertyToContainer(cbor_property_container, cbor_raw,         "raw",         Permission::ReadWrite, 3);
+      addPropertyToContainer(cbor_property_container, cbor_temperature, "temperature", Permission::ReadWrite, 4);
+      addPropertyToContainer(cbor_property_container, cbor_str,         "str",         Permission::ReadWrite, 5);
+      addPropertyToContainer(cbor_property_container, cbor_location,    "location",    Permission::ReadWrite, 6);
+      int cbor_bytes_encoded = 0;
+      uint8_t cbor_buf[255];
+      REQUIRE(CBOREncoder::pack(cbor_property_container, cbor_buf, sizeof(cbor_buf), cbor_bytes_encoded, true) == CborNoError);
+      REQUIRE(msg.size() * 2 < static_cast<size_t>(cbor_bytes_encoded));
+    }
+
+    THEN("the reference decoder restores the values within the resolution of every field")
+    {
+      std::vector<PackedDecoder::Value> values;
+      REQUIRE(decoder.decode(msg, values));
+      REQUIRE(values.size() == 7);
+      REQUIRE(values[0].name == "sw");
+      REQUIRE(values[0].bool_val == true);
+      REQUIRE(values[1].name == "counter");
+      REQUIRE(values[1].val == 1000);
+      REQUIRE(values[2].val == 3.25);
+      REQUIRE(values[3].val == Approx(21.5));
+      REQUIRE(values[4].str_val == "abc");
+      REQUIRE(values[5].attribute == 1);
+      REQUIRE(values[5].val == Approx(45.123456).margin(0.000005));
+      REQUIRE(values[6].attribute == 2);
+      REQUIRE(values[6].val == Approx(-7.654321).margin(0.000005));
+    }
+  }
+
+  WHEN("Numeric properties change slightly after having been sent")
+  {
+    REQUIRE(decoder.setSchema(schema(encoder, property_container)));
+    std::vector<PackedDecoder::Value> values;
+    REQUIRE(decoder.decode(encode(encoder, property_container), values));
+
+    set_millis(1000);
+    counter = 1010;
+    temperature = 21.7f;
+    std::vector<uint8_t> const msg = encode(encoder, property_container);
+
+    THEN("deltas of half the width are sent, the counter in 20 bits and the temperature in 10 bits")
+    {
+      REQUIRE(msg.size() == 3 + 4);
+      REQUIRE(msg[1] == 0x40);
+      REQUIRE(msg[2] == 0x01);
+
+      values.clear();
+      REQUIRE(decoder.decode(msg, values));
+      REQUIRE(values.size() == 2);
+      REQUIRE(values[0].val == 1010);
+      REQUIRE(values[1].val == Approx(21.7));
+    }
+
+    THEN("a decoder having missed a message skips the deltas until the next keyframe")
+    {
+      set_millis(2000);
+      counter = 1020;
+      std::vector<uint8_t> const next = encode(encoder, property_container);
+
+      values.clear();
+      REQUIRE(decoder.decode(next, values));
+      REQUIRE(values.empty());
+      REQUIRE(decoder.getSkippedCount() == 1);
+
+      for (int i = 3; i <= AIOT_CONFIG_PACKED_KEYFRAME_INTERVAL; i++)
+      {
+        set_millis(i * 1000);
+        counter = 1000 + i * 10;
+        values.clear();
+        std::vector<uint8_t> const keyframe = encode(encoder, property_container);
+        REQUIRE(decoder.decode(keyframe, values));
+        REQUIRE(((keyframe[1] & 0x10) != 0) == (i == AIOT_CONFIG_PACKED_KEYFRAME_INTERVAL));
+      }
+      REQUIRE(values.size() == 1);
+      REQUIRE(values[0].val == 1000 + AIOT_CONFIG_PACKED_KEYFRAME_INTERVAL * 10);
+    }
+  }
+
+  WHEN("A delta does not fit into half the width")
+  {
+    encode(encoder, property_container);
+    set_millis(1000);
+    counter = 1000 + 40000;
+    std::vector<uint8_t> const msg = encode(encoder, property_container);
+
+    THEN("the absolute value is sent")
+    {
+      REQUIRE(msg.size() == 3 + 5);
+    }
+  }
+
+  WHEN("A message is lost")
+  {
+    REQUIRE(decoder.setSchema(schema(encoder, property_container)));
+    std::vector<PackedDecoder::Value> values;
+    REQUIRE(decoder.decode(encode(encoder, property_container), values));
+
+    set_millis(1000);
+    counter = 1010;
+    CborError err;
+    REQUIRE(!encode(encoder, property_container, 51, err, false).empty());
+
+    set_millis(2000);
+    counter = 1020;
+    std::vector<uint8_t> const msg = encode(encoder, property_container);
+
+    THEN("the next message is a keyframe which does not refer to the lost one")
+    {
+      REQUIRE((msg[1] & 0x10) != 0);
+      values.clear();
+      REQUIRE(decoder.decode(msg, values));
+      REQUIRE(values.size() == 1);
+      REQUIRE(values[0].val == 1020);
+      REQUIRE(decoder.getSkippedCount() == 0);
+    }
+  }
+
+  WHEN("A fixed point value is out of range")
+  {
+    REQUIRE(decoder.setSchema(schema(encoder, property_container)));
+    temperature = 300.0f;
+    std::vector<PackedDecoder::Value> values;
+    REQUIRE(decoder.decode(encode(encoder, property_container), values));
+
+    THEN("it saturates")
+    {
+      REQUIRE(values[3].name == "temperature");
+      REQUIRE(values[3].val == Approx(204.7));
+    }
+  }
+}
+
+SCENARIO("Packed messages respect the maximum payload", "[PackedEncoder]")
+{
+  set_millis(0);
+
+  PropertyContainer property_container;
+  CloudInt low = 1, high = 2;
+  CloudString str;
+  str = "a string which is too long for a small message";
+  addPropertyToContainer(property_container, low,  "low",  Permission::ReadWrite, 1);
+  addPropertyToContainer(property_container, high, "high", Permission::ReadWrite, 2).priority(1).encodeFixedPoint(0, 8);
+  addPropertyToContainer(property_container, str,  "str",  Permission::ReadWrite, 3).priority(2);
+
+  PackedEncoder encoder;
+  PackedDecoder decoder;
+  REQUIRE(decoder.setSchema(schema(encoder, property_container)));
+
+  WHEN("Only some properties fit into a message")
+  {
+    std::vector<uint8_t> const first = encode(encoder, property_container, 5);
+    std::vector<uint8_t> const second = encode(encoder, property_container, 8);
+
+    THEN("they are packed by priority and the remaining ones are deferred")
+    {
+      std::vector<PackedDecoder::Value> values;
+      REQUIRE(first.size() == 5);
+      REQUIRE(decoder.decode(first, values));
+      REQUIRE(values.size() == 1);
+      REQUIRE(values[0].name == "high");
+      REQUIRE(values[0].val == 2);
+
+      values.clear();
+      REQUIRE(second.size() == 8);
+      REQUIRE(decoder.decode(second, values));
+      REQUIRE(values.size() == 1);
+      REQUIRE(values[0].name == "low");
+    }
+
+    THEN("a message with nothing but the string is sent once the payload is large enough")
+    {
+      CborError err = CborNoError;
+      REQUIRE(encode(encoder, property_container, 20, err).empty());
+      REQUIRE(err == CborErrorOutOfMemory);
+
+      std::vector<PackedDecoder::Value> values;
+      REQUIRE(decoder.decode(encode(encoder, property_container, 51), values));
+      REQUIRE(values.size() == 1);
+      REQUIRE(values[0].str_val == "a string which is too long for a small message");
+      REQUIRE(encode(encoder, property_container, 51).empty());
+    }
+  }
+}
+
+SCENARIO("Properties which do not fit into the schema are sent as CBOR", "[PackedEncoder]")
+{
+  set_millis(0);
+
+  PropertyContainer property_container;
+  CloudInt counter[AIOT_CONFIG_PACKED_MAX_FIELD_CNT];
+  CloudLocation location(45.123456f, -7.654321f);
+  char name[AIOT_CONFIG_PACKED_MAX_FIELD_CNT][16];
+  for (int i = 0; i < AIOT_CONFIG_PACKED_MAX_FIELD_CNT - 1; i++)
+  {
+    snprintf(name[i], sizeof(name[i]), "counter%d", i);
+    addPropertyToContainer(property_container, counter[i], name[i], Permission::ReadWrite, i + 1);
+  }
+  addPropertyToContainer(property_container, location, "location", Permission::ReadWrite, AIOT_CONFIG_PACKED_MAX_FIELD_CNT);
+  snprintf(name[AIOT_CONFIG_PACKED_MAX_FIELD_CNT - 1], sizeof(name[0]), "counter%d", AIOT_CONFIG_PACKED_MAX_FIELD_CNT - 1);
+  addPropertyToContainer(property_container, counter[AIOT_CONFIG_PACKED_MAX_FIELD_CNT - 1], name[AIOT_CONFIG_PACKED_MAX_FIELD_CNT - 1], Permission::ReadWrite, AIOT_CONFIG_PACKED_MAX_FIELD_CNT + 1);
+
+  PackedEncoder encoder;
+
+  WHEN("The schema is full")
+  {
+    std::string const exported = schema(encoder, property_container);
+
+    THEN("a property is left out entirely instead of some of its attributes")
+    {
+      REQUIRE(encoder.getFieldCount() == AIOT_CONFIG_PACKED_MAX_FIELD_CNT);
+      REQUIRE(encoder.getRejectedPropertyCount() == 1);
+      REQUIRE(exported.find("location") == std::string::npos);
+    }
+
+    THEN("its changes are reported and left for the CBOR light payload")
+    {
+      REQUIRE(!encode(encoder, property_container, 255).empty());
+      REQUIRE(encoder.hasRejectedChanges());
+      REQUIRE(encode(encoder, property_container, 255).empty());
+
+      int bytes_encoded = 0;
+      uint8_t buf[255];
+      REQUIRE(CBOREncoder::pack(property_container, buf, sizeof(buf), bytes_encoded, true) == CborNoError);
+      REQUIRE(bytes_encoded > 0);
+      REQUIRE(encode(encoder, property_container, 255).empty());
+      REQUIRE(!encoder.hasRejectedChanges());
+      REQUIRE(CBOREncoder::pack(property_container, buf, sizeof(buf), bytes_encoded, true) == CborNoError);
+      REQUIRE(bytes_encoded == 0);
+    }
+  }
+}
@@ -10,6 +10,9 @@
 
 #include <util/CBORTestUtil.h>
 
+#include <CBORDecoder.h>
+#include "types/CloudWrapperString.h"
+
 /**************************************************************************************
    TEST CODE
  **************************************************************************************/
@@ -41,3 +44,62 @@ SCENARIO("A Arduino cloud property is published on value change", "[ArduinoCloud
     }
   }
 }
+
+SCENARIO("String properties detecting their changes by hash are published on value change", "[ArduinoCloudThing::publishOnChange]")
+{
+  PropertyContainer property_container;
+
+  String     wrapped = "hello";
+  CloudString str    = "hello";
+  CloudWrapperString wrapper(wrapped);
+  wrapper.detectChangesByHash();
+  str.detectChangesByHash();
+
+  addPropertyToContainer(property_container, wrapper, "str_test", Permission::ReadWrite).publishOnChange(0.0f, 0);
+  addPropertyToContainer(property_container, str,     "str",      Permission::ReadWrite).publishOnChange(0.0f, 0);
+
+  WHEN("The values have not changed")
+  {
+    THEN("the properties are only encoded for the 1st time")
+    {
+      REQUIRE(cbor::encode(property_container).size() != 0);
+      REQUIRE(cbor::encode(property_container).size() == 0);
+      REQUIRE(wrapper.isChangedLocally() == false);
+    }
+  }
+
+  WHEN("The values are changed locally")
+  {
+    cbor::encode(property_container);
+    wrapped = "hellO";
+    str = "hello world";
+
+    THEN("both properties are encoded once")
+    {
+      REQUIRE(wrapper.isChangedLocally() == true);
+      REQUIRE(wrapper.isDifferentFromCloud() == true);
+      REQUIRE(str.isDifferentFromCloud() == true);
+      REQUIRE(cbor::encode(property_container).size() != 0);
+      REQUIRE(cbor::encode(property_container).size() == 0);
+    }
+  }
+
+  WHEN("A value is changed by the cloud")
+  {
+    cbor::encode(property_container);
+
+    /* [{0: "str_test", 3: "hello arduino"}] = 81 A2 00 68 73 74 72 5F 74 65 73 74 03 6D 68 65 6C 6C 6F 20 61 72 64 75 69 6E 6F */
+    uint8_t const payload[] = {0x81, 0xA2, 0x00, 0x68, 0x73, 0x74, 0x72, 0x5F, 0x74, 0x65, 0x73, 0x74, 0x03, 0x6D, 0x68, 0x65, 0x6C, 0x6C, 0x6F, 0x20, 0x61, 0x72, 0x64, 0x75, 0x69, 0x6E, 0x6F};
+    CBORDecoder::decode(property_container, payload, sizeof(payload) / sizeof(uint8_t));
+
+    THEN("the received copy is applied and the value is acknowledged only once")
+    {
+      REQUIRE(wrapped == "hello arduino");
+      REQUIRE(cbor::encode(property_container).size() != 0);
+      REQUIRE(cbor::encode(property_container).size() == 0);
+
+      wrapper.fromCloudToLocal();
+      REQUIRE(wrapped == "hello arduino");
+    }
+  }
+}
@@ -59,3 +59,26 @@ SCENARIO("A Arduino cloud property is published on value change but the update r
     }
   }
 }
+
+SCENARIO("A Arduino cloud property is published on value change but the update rate is limited to less than once a minute", "[ArduinoCloudThing::publishOnChange]")
+{
+  PropertyContainer property_container;
+
+  CloudInt test = 0;
+  unsigned long const MIN_TIME_BETWEEN_UPDATES_ms = 100000; /* Exceeds 16 bit */
+
+  addPropertyToContainer(property_container, test, "test", Permission::ReadWrite).publishOnChange(0, MIN_TIME_BETWEEN_UPDATES_ms);
+
+  WHEN("t = 0 ms, property not modified, 1st call to 'encode'") {
+    set_millis(0);
+    REQUIRE(cbor::encode(property_container).size() != 0);
+    test++;
+
+    THEN("the property is not encoded before the min time between updates has elapsed") {
+      set_millis(MIN_TIME_BETWEEN_UPDATES_ms - 1);
+      REQUIRE(cbor::encode(property_container).size() == 0);
+      set_millis(MIN_TIME_BETWEEN_UPDATES_ms);
+      REQUIRE(cbor::encode(property_container).size() != 0);
+    }
+  }
+}
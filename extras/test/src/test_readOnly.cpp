@@ -31,3 +31,31 @@ SCENARIO("A Arduino cloud property is marked 'read only'", "[ArduinoCloudThing::
 
   REQUIRE(test == 0);
 }
+
+SCENARIO("Only 'read only' Arduino cloud properties are encoded while waiting for the last values", "[ArduinoCloudThing::encode]")
+{
+  PropertyContainer property_container;
+
+  CloudInt read_only = 1, read_write = 2;
+  addPropertyToContainer(property_container, read_only, "ro", Permission::Read);
+  addPropertyToContainer(property_container, read_write, "rw", Permission::ReadWrite);
+
+  WHEN("'encode' is called skipping cloud writeable properties")
+  {
+    /* [{0: "ro", 2: 1}] = 9F A2 00 62 72 6F 02 01 FF */
+    std::vector<uint8_t> const expected = {0x9F, 0xA2, 0x00, 0x62, 0x72, 0x6F, 0x02, 0x01, 0xFF};
+    std::vector<uint8_t> const actual = cbor::encode(property_container, false, true);
+
+    THEN("only the 'read only' property is encoded")
+    {
+      REQUIRE(actual == expected);
+    }
+
+    THEN("the 'read write' property is encoded by the next regular 'encode'")
+    {
+      /* [{0: "rw", 2: 2}] = 9F A2 00 62 72 77 02 02 FF */
+      std::vector<uint8_t> const expected_rw = {0x9F, 0xA2, 0x00, 0x62, 0x72, 0x77, 0x02, 0x02, 0xFF};
+      REQUIRE(cbor::encode(property_container) == expected_rw);
+    }
+  }
+}
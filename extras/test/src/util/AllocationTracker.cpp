@@ -0,0 +1,228 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <util/AllocationTracker.h>
+
+#include <stdlib.h>
+
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/**************************************************************************************
+   EXTERN DECLARATION
+ **************************************************************************************/
+
+/* If ALLOCATION_TRACKER_WRAP_MALLOC is defined the executable is linked with
+ * '-Wl,--wrap=malloc,...' so that every call of malloc & co. within the library
+ * and the test code, i.e. tinycbor's cbor_value_dup_text_string, is redirected
+ * to the __wrap_xxx functions below while __real_xxx refers to the C library.
+ */
+#if defined(ALLOCATION_TRACKER_WRAP_MALLOC)
+extern "C" void * __real_malloc (size_t size);
+extern "C" void * __real_calloc (size_t nmemb, size_t size);
+extern "C" void * __real_realloc(void * ptr, size_t size);
+extern "C" void   __real_free   (void * ptr);
+#  define REAL_MALLOC(size)         __real_malloc(size)
+#  define REAL_CALLOC(nmemb, size)  __real_calloc(nmemb, size)
+#  define REAL_REALLOC(ptr, size)   __real_realloc(ptr, size)
+#  define REAL_FREE(ptr)            __real_free(ptr)
+#else
+#  define REAL_MALLOC(size)         malloc(size)
+#  define REAL_CALLOC(nmemb, size)  calloc(nmemb, size)
+#  define REAL_REALLOC(ptr, size)   realloc(ptr, size)
+#  define REAL_FREE(ptr)            free(ptr)
+#endif
+
+/**************************************************************************************
+   GLOBAL VARIABLES
+ **************************************************************************************/
+
+static alloc::Stats allocation_stats = {0, 0, 0, 0, 0};
+
+/**************************************************************************************
+   LOCAL FUNCTIONS
+ **************************************************************************************/
+
+static size_t usable_size(void * ptr)
+{
+#if defined(__GLIBC__)
+  return malloc_usable_size(ptr);
+#else
+  (void)ptr;
+  return 0;
+#endif
+}
+
+static void on_allocate(void * ptr)
+{
+  if (!ptr)
+    return;
+
+  size_t const size = usable_size(ptr);
+  allocation_stats.allocations++;
+  allocation_stats.bytes += size;
+  allocation_stats.current_bytes += size;
+  if (allocation_stats.current_bytes > allocation_stats.peak_bytes)
+    allocation_stats.peak_bytes = allocation_stats.current_bytes;
+}
+
+static void on_deallocate(void * ptr)
+{
+  if (!ptr)
+    return;
+
+  size_t const size = usable_size(ptr);
+  allocation_stats.deallocations++;
+  /* Blocks allocated before the tracker was reset may be released afterwards. */
+  allocation_stats.current_bytes -= (size < allocation_stats.current_bytes) ? size : allocation_stats.current_bytes;
+}
+
+static void * allocate(size_t const size)
+{
+  void * ptr = REAL_MALLOC(size ? size : 1);
+  on_allocate(ptr);
+  return ptr;
+}
+
+static void deallocate(void * ptr)
+{
+  on_deallocate(ptr);
+  REAL_FREE(ptr);
+}
+
+/**************************************************************************************
+   GLOBAL OPERATOR NEW/DELETE
+ **************************************************************************************/
+
+void * operator new(size_t size)
+{
+  void * ptr = allocate(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void * operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void * ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void * ptr, size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void * ptr, size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+/**************************************************************************************
+   WRAPPED C LIBRARY FUNCTIONS
+ **************************************************************************************/
+
+#if defined(ALLOCATION_TRACKER_WRAP_MALLOC)
+extern "C" void * __wrap_malloc(size_t size)
+{
+  return allocate(size);
+}
+
+extern "C" void * __wrap_calloc(size_t nmemb, size_t size)
+{
+  void * ptr = REAL_CALLOC(nmemb, size);
+  on_allocate(ptr);
+  return ptr;
+}
+
+extern "C" void * __wrap_realloc(void * ptr, size_t size)
+{
+  on_deallocate(ptr);
+  void * new_ptr = REAL_REALLOC(ptr, size);
+  /* A failed realloc leaves the original block untouched. */
+  on_allocate(new_ptr ? new_ptr : ptr);
+  return new_ptr;
+}
+
+extern "C" void __wrap_free(void * ptr)
+{
+  deallocate(ptr);
+}
+#endif /* ALLOCATION_TRACKER_WRAP_MALLOC */
+
+/**************************************************************************************
+   NAMESPACE
+ **************************************************************************************/
+
+namespace alloc
+{
+
+/**************************************************************************************
+   PUBLIC FUNCTIONS
+ **************************************************************************************/
+
+Stats stats()
+{
+  return allocation_stats;
+}
+
+void reset()
+{
+  allocation_stats.allocations = 0;
+  allocation_stats.deallocations = 0;
+  allocation_stats.bytes = 0;
+  allocation_stats.peak_bytes = allocation_stats.current_bytes;
+}
+
+/**************************************************************************************
+   CLASS MEMBER FUNCTIONS
+ **************************************************************************************/
+
+Scope::Scope()
+{
+  allocation_stats.peak_bytes = allocation_stats.current_bytes;
+  _start = allocation_stats;
+}
+
+unsigned long Scope::allocations() const
+{
+  return allocation_stats.allocations - _start.allocations;
+}
+
+unsigned long Scope::leaks() const
+{
+  return (allocation_stats.allocations - _start.allocations) - (allocation_stats.deallocations - _start.deallocations);
+}
+
+size_t Scope::bytes() const
+{
+  return allocation_stats.bytes - _start.bytes;
+}
+
+size_t Scope::peak_bytes() const
+{
+  return allocation_stats.peak_bytes - _start.current_bytes;
+}
+
+/**************************************************************************************
+   NAMESPACE
+ **************************************************************************************/
+
+} /* alloc */
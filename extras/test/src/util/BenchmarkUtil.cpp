@@ -0,0 +1,150 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <util/BenchmarkUtil.h>
+#include <util/AllocationTracker.h>
+
+#include <stdio.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+/**************************************************************************************
+   CONSTANTS
+ **************************************************************************************/
+
+static unsigned int const ROUNDS = 5;
+
+/**************************************************************************************
+   NAMESPACE
+ **************************************************************************************/
+
+namespace bench
+{
+
+/**************************************************************************************
+   PUBLIC FUNCTIONS
+ **************************************************************************************/
+
+Result measure(std::string const & name, Operation const & op, unsigned long const min_duration_ms)
+{
+  typedef std::chrono::steady_clock Clock;
+
+  /* Warm up, this also yields the number of bytes per operation. */
+  size_t const bytes = op();
+
+  /* The fastest of several rounds is reported, it is the one which
+   * is least disturbed by other processes running on the host.
+   */
+  double min_ns_per_op = 0.0;
+  unsigned long iterations = 0;
+  unsigned long allocations = 0;
+
+  for (unsigned int round = 0; round < ROUNDS; round++)
+  {
+    unsigned long round_iterations = 0;
+    Clock::duration elapsed = Clock::duration::zero();
+
+    for (unsigned long batch = 1; elapsed < std::chrono::milliseconds(min_duration_ms); batch *= 2)
+    {
+      unsigned long const allocation_cnt_start = alloc::stats().allocations;
+      Clock::time_point const start = Clock::now();
+      for (unsigned long i = 0; i < batch; i++)
+        op();
+      elapsed += Clock::now() - start;
+      allocations += alloc::stats().allocations - allocation_cnt_start;
+      round_iterations += batch;
+    }
+
+    double const ns_per_op = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / round_iterations;
+    if ((round == 0) || (ns_per_op < min_ns_per_op))
+      min_ns_per_op = ns_per_op;
+    iterations += round_iterations;
+  }
+
+  return Result{name, min_ns_per_op, bytes, static_cast<double>(allocations) / iterations};
+}
+
+void print(std::vector<Result> const & results)
+{
+  printf("%-48s %14s %10s %14s\n", "benchmark", "ns/op", "bytes", "allocs/op");
+  for (Result const & r : results)
+    printf("%-48s %14.1f %10zu %14.2f\n", r.name.c_str(), r.ns_per_op, r.bytes, r.allocs_per_op);
+}
+
+bool readBaseline(std::string const & filename, std::map<std::string, Result> & baseline)
+{
+  std::ifstream file(filename);
+  if (!file)
+    return false;
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    Result r;
+    std::istringstream is(line);
+    if (is >> r.name >> r.ns_per_op >> r.bytes >> r.allocs_per_op)
+      baseline[r.name] = r;
+  }
+  return true;
+}
+
+bool writeBaseline(std::string const & filename, std::vector<Result> const & results)
+{
+  FILE * file = fopen(filename.c_str(), "w");
+  if (!file)
+    return false;
+
+  fprintf(file, "# benchmark ns/op bytes allocs/op\n");
+  for (Result const & r : results)
+    fprintf(file, "%s %.1f %zu %.2f\n", r.name.c_str(), r.ns_per_op, r.bytes, r.allocs_per_op);
+  fclose(file);
+  return true;
+}
+
+size_t compare(std::vector<Result> const & results, std::map<std::string, Result> const & baseline, double const time_tolerance_percent)
+{
+  size_t regression_cnt = 0;
+
+  for (Result const & r : results)
+  {
+    std::map<std::string, Result>::const_iterator b = baseline.find(r.name);
+    if (b == baseline.end())
+    {
+      printf("NEW   %s\n", r.name.c_str());
+      continue;
+    }
+
+    bool const is_slower = (time_tolerance_percent >= 0.0) && (r.ns_per_op > b->second.ns_per_op * (1.0 + time_tolerance_percent / 100.0));
+    bool const is_larger = r.bytes > b->second.bytes;
+    /* Allocations per operation are averaged, allow for rounding of the baseline. */
+    bool const is_allocating_more = r.allocs_per_op > b->second.allocs_per_op + 0.01;
+
+    if (is_slower || is_larger || is_allocating_more)
+    {
+      regression_cnt++;
+      printf("FAIL  %s: ns/op %.1f -> %.1f, bytes %zu -> %zu, allocs/op %.2f -> %.2f\n",
+             r.name.c_str(),
+             b->second.ns_per_op, r.ns_per_op,
+             b->second.bytes, r.bytes,
+             b->second.allocs_per_op, r.allocs_per_op);
+    }
+  }
+
+  return regression_cnt;
+}
+
+/**************************************************************************************
+   NAMESPACE
+ **************************************************************************************/
+
+} /* bench */
@@ -24,12 +24,12 @@ namespace cbor
    PUBLIC FUNCTIONS
  **************************************************************************************/
 
-std::vector<uint8_t> encode(PropertyContainer & property_container, bool lightPayload)
+std::vector<uint8_t> encode(PropertyContainer & property_container, bool lightPayload, bool readOnlyOnly)
 {
   int bytes_encoded = 0;
   uint8_t buf[200] = {0};
 
-  if (CBOREncoder::encode(property_container, buf, 200, bytes_encoded, lightPayload) == CborNoError)
+  if (CBOREncoder::encode(property_container, buf, 200, bytes_encoded, lightPayload, readOnlyOnly) == CborNoError)
     return std::vector<uint8_t>(buf, buf + bytes_encoded);
   else
     return std::vector<uint8_t>();
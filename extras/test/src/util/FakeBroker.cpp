@@ -0,0 +1,135 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <util/FakeBroker.h>
+
+#include <algorithm>
+
+#include <ArduinoMqttClient.h>
+
+/**************************************************************************************
+   CONSTANTS
+ **************************************************************************************/
+
+static String const SHADOW_TOPIC_OUT_SUFFIX = "/shadow/o";
+static String const SHADOW_TOPIC_IN_SUFFIX  = "/shadow/i";
+
+/**************************************************************************************
+   CTOR/DTOR
+ **************************************************************************************/
+
+FakeBroker::FakeBroker()
+{
+  reset();
+}
+
+/**************************************************************************************
+   PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+FakeBroker & FakeBroker::instance()
+{
+  static FakeBroker broker;
+  return broker;
+}
+
+void FakeBroker::reset()
+{
+  _is_online = true;
+  _is_subscription_allowed = true;
+  _is_shadow_reply_enabled = false;
+  _is_publish_acked = true;
+  _shadow_reply.clear();
+  _clients.clear();
+  _subscriptions.clear();
+  _received.clear();
+  _connect_cnt = 0;
+  _connect_attempt_cnt = 0;
+  _subscribe_attempt_cnt = 0;
+  _bytes_in = 0;
+}
+
+bool FakeBroker::connect(MqttClient * client)
+{
+  _connect_attempt_cnt++;
+  if (!_is_online)
+    return false;
+
+  disconnect(client);
+  _clients.push_back(client);
+  _connect_cnt++;
+  return true;
+}
+
+bool FakeBroker::isConnected(MqttClient * client) const
+{
+  return std::find(_clients.begin(), _clients.end(), client) != _clients.end();
+}
+
+void FakeBroker::disconnect(MqttClient * client)
+{
+  _clients.remove(client);
+  _subscriptions.remove_if([client](Subscription const & s) { return s.client == client; });
+}
+
+bool FakeBroker::subscribe(MqttClient * client, String const & topic)
+{
+  _subscribe_attempt_cnt++;
+  if (!_is_online || !_is_subscription_allowed)
+    return false;
+
+  _subscriptions.push_back(Subscription{client, topic});
+  return true;
+}
+
+bool FakeBroker::publish(MqttClient * /* client */, String const & topic, std::vector<uint8_t> const & payload)
+{
+  _received.push_back(Message{topic, payload, millis()});
+  _bytes_in += getPublishPacketSize(topic, payload.size());
+
+  /* Answer shadow requests, i.e. 'getLastValues', with the configured shadow. */
+  bool const is_shadow_topic = (topic.length() > SHADOW_TOPIC_OUT_SUFFIX.length()) &&
+                               (topic.compare(topic.length() - SHADOW_TOPIC_OUT_SUFFIX.length(), SHADOW_TOPIC_OUT_SUFFIX.length(), SHADOW_TOPIC_OUT_SUFFIX) == 0);
+  if (is_shadow_topic && _is_shadow_reply_enabled)
+  {
+    String const reply_topic = topic.substr(0, topic.length() - SHADOW_TOPIC_OUT_SUFFIX.length()) + SHADOW_TOPIC_IN_SUFFIX;
+    send(reply_topic, _shadow_reply);
+  }
+
+  return _is_publish_acked;
+}
+
+void FakeBroker::disconnectAll()
+{
+  std::list<MqttClient *> const clients = _clients;
+  for (MqttClient * client : clients)
+    disconnect(client);
+}
+
+void FakeBroker::send(String const & topic, std::vector<uint8_t> const & payload)
+{
+  for (Subscription const & s : _subscriptions)
+  {
+    if (s.topic == topic)
+      s.client->deliver(topic, payload);
+  }
+}
+
+unsigned long FakeBroker::getMessagesIn(String const & topic) const
+{
+  return std::count_if(_received.begin(), _received.end(), [topic](Message const & m) { return m.topic == topic; });
+}
+
+size_t FakeBroker::getPublishPacketSize(String const & topic, size_t const payload_len)
+{
+  size_t const remaining_len = 2 + topic.length() + payload_len;
+  size_t remaining_len_bytes = 1;
+  for (size_t l = remaining_len; l > 127; l /= 128)
+    remaining_len_bytes++;
+  return 1 + remaining_len_bytes + remaining_len;
+}
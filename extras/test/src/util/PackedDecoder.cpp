@@ -0,0 +1,159 @@
+/*
+   Copyright (c) 2021 Arduino.  All rights reserved.
+*/
+
+/**************************************************************************************
+   INCLUDE
+ **************************************************************************************/
+
+#include <util/PackedDecoder.h>
+
+#include <math.h>
+#include <string.h>
+
+#include <sstream>
+
+/**************************************************************************************
+   PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+bool PackedDecoder::setSchema(std::string const & schema)
+{
+  std::istringstream in(schema);
+  std::string magic;
+  int version = 0, field_cnt = 0;
+  if (!(in >> magic >> version >> field_cnt) || (magic != "packed") || (version != 2))
+    return false;
+
+  _field.clear();
+  for (int i = 1; i <= field_cnt; i++)
+  {
+    int index = 0;
+    Field field = {"", 0, 0, 0, 0, 0, false, 0};
+    if (!(in >> index >> field.name >> field.identifier >> field.attribute >> field.type) || (index != i))
+      return false;
+
+    switch (field.type)
+    {
+    case 'b': field.bits = 1;  break;
+    case 'i': field.bits = 32; break;
+    case 'f': field.bits = 32; break;
+    case 's': field.bits = 8;  break;
+    case 'q':
+      if (!(in >> field.decimals >> field.bits) || (field.bits < 1) || (field.bits > 32))
+        return false;
+      break;
+    default: return false;
+    }
+    _field.push_back(field);
+  }
+
+  _last_sequence_number = -1;
+  return true;
+}
+
+bool PackedDecoder::decode(std::vector<uint8_t> const & msg, std::vector<Value> & values)
+{
+  if ((msg.size() < 3) || (msg[0] != 0xFC) || ((msg[1] >> 5) != 2))
+    return false;
+
+  int const sequence_number = ((msg[1] & 0x0F) << 8) | msg[2];
+  bool const is_keyframe = (msg[1] & 0x10) != 0;
+
+  /* The deltas of this message refer to values of a missed one. */
+  if ((_last_sequence_number >= 0) && (sequence_number != ((_last_sequence_number + 1) % 4096)))
+    for (Field & field : _field)
+      field.has_reference = false;
+  _last_sequence_number = sequence_number;
+
+  int index_bits = 0;
+  while ((_field.size() >> index_bits) > 0)
+    index_bits++;
+
+  size_t bit_pos = 24;
+  for (;;)
+  {
+    uint32_t index = 0;
+    if (!read(msg, bit_pos, index_bits, index) || (index == 0))
+      return true;
+    if (index > _field.size())
+      return false;
+
+    Field & field = _field[index - 1];
+    Value value = {field.name, field.identifier, field.attribute, field.type, false, 0.0, ""};
+    uint32_t raw = 0;
+
+    if (field.type == 'b')
+    {
+      if (!read(msg, bit_pos, 1, raw))
+        return false;
+      value.bool_val = raw;
+    }
+    else if (field.type == 'f')
+    {
+      float f;
+      if (!read(msg, bit_pos, 32, raw))
+        return false;
+      memcpy(&f, &raw, sizeof(f));
+      value.val = f;
+    }
+    else if (field.type == 's')
+    {
+      if (!read(msg, bit_pos, 8, raw))
+        return false;
+      for (uint32_t length = raw; length > 0; length--)
+      {
+        if (!read(msg, bit_pos, 8, raw))
+          return false;
+        value.str_val += static_cast<char>(raw);
+      }
+    }
+    else
+    {
+      uint32_t is_delta = 0;
+      if (!read(msg, bit_pos, 1, is_delta))
+        return false;
+      if (is_delta && is_keyframe)
+        return false;
+
+      int const bits = is_delta ? (field.bits + 1) / 2 : field.bits;
+      if (!read(msg, bit_pos, bits, raw))
+        return false;
+
+      if (is_delta && !field.has_reference)
+      {
+        _skipped_cnt++;
+        continue;
+      }
+
+      int64_t const q = is_delta ? (field.reference + signExtend(raw, bits)) : signExtend(raw, bits);
+      field.reference = q;
+      field.has_reference = true;
+      value.val = q / pow(10.0, field.decimals);
+    }
+
+    values.push_back(value);
+  }
+}
+
+/**************************************************************************************
+   PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+bool PackedDecoder::read(std::vector<uint8_t> const & msg, size_t & bit_pos, int const bits, uint32_t & value)
+{
+  if ((bit_pos + bits) > (msg.size() * 8))
+    return false;
+
+  value = 0;
+  for (int b = 0; b < bits; b++, bit_pos++)
+    value = (value << 1) | ((msg[bit_pos / 8] >> (7 - (bit_pos % 8))) & 1);
+  return true;
+}
+
+int64_t PackedDecoder::signExtend(uint32_t const value, int const bits)
+{
+  int64_t const sign = static_cast<int64_t>(1) << (bits - 1);
+  int64_t const v = static_cast<int64_t>(value) & ((sign << 1) - 1);
+  return (v ^ sign) - sign;
+}
@@ -0,0 +1,69 @@
+#!/usr/bin/python3
+
+import struct
+import sys
+
+if len(sys.argv) != 2:
+    print ("Usage: trace_decode.py trace.bin")
+    sys.exit()
+
+# Keep in sync with 'enum class TraceEvent' in src/utility/trace/Trace.h
+EVENTS = {
+    0x01: "StateTransition",
+    0x10: "MqttConnectBegin",
+    0x11: "MqttConnectEnd",
+    0x12: "ConnectionLost",
+    0x20: "TlsHandshakeBegin",
+    0x21: "TlsEntropy",
+    0x22: "TlsClientReset",
+    0x23: "TlsHandshakeEnd",
+    0x30: "Encode",
+    0x31: "EncodeError",
+    0x32: "Decode",
+    0x40: "MessageIn",
+    0x41: "MessageOut",
+    0x42: "PublishFailure",
+    0x50: "OtaRequest",
+    0x51: "OtaResult",
+}
+
+# Keep in sync with 'enum class State' in src/ArduinoIoTCloudTCP.h
+TCP_STATES = ["ConnectPhy", "SyncTime", "ConnectMqttBroker", "SubscribeMqttTopics", "RequestLastValues", "Connected"]
+
+def state_name(state):
+    return TCP_STATES[state] if state < len(TCP_STATES) else str(state)
+
+def format_args(event, arg0, arg1):
+    if event == 0x01:
+        return "{} -> {}".format(state_name(arg0 >> 8), state_name(arg0 & 0xFF))
+    return "arg0 = {}, arg1 = {}".format(arg0, arg1)
+
+with open(sys.argv[1], "rb") as f:
+    data = f.read()
+
+# Skip anything printed before the dump, e.g. debug output on the same serial port.
+start = data.find(b"TRC")
+if start < 0:
+    print ("Error: no trace header found")
+    sys.exit(1)
+
+version, count, entry_size, dropped = struct.unpack_from("<BHHI", data, start + 3)
+if version != 1:
+    print ("Error: unsupported trace format version {}".format(version))
+    sys.exit(1)
+
+print ("{} events, {} dropped".format(count, dropped))
+
+offset = start + 12
+prev_timestamp = None
+for i in range(count):
+    if offset + entry_size > len(data):
+        print ("Error: trace truncated after {} events".format(i))
+        sys.exit(1)
+    timestamp, event, arg0, arg1 = struct.unpack_from("<IHHI", data, offset)
+    offset += entry_size
+    # The microsecond tick wraps around every ~71 minutes.
+    delta = 0 if prev_timestamp is None else (timestamp - prev_timestamp) & 0xFFFFFFFF
+    prev_timestamp = timestamp
+    name = EVENTS.get(event, "0x{:04X}".format(event))
+    print ("{:12d} us {:+10d} us  {:<18s} {}".format(timestamp, delta, name, format_args(event, arg0, arg1)))
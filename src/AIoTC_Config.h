@@ -30,6 +30,121 @@
   #define NTP_USE_RANDOM_PORT     (1)
 #endif
 
+#ifndef AIOT_CONFIG_RECONNECTION_RETRY_DELAY_ms
+  #define AIOT_CONFIG_RECONNECTION_RETRY_DELAY_ms         (1000UL)
+#endif
+
+#ifndef AIOT_CONFIG_MAX_RECONNECTION_RETRY_DELAY_ms
+  #define AIOT_CONFIG_MAX_RECONNECTION_RETRY_DELAY_ms     (32000UL)
+#endif
+
+#ifndef AIOT_CONFIG_SUBSCRIBE_RETRY_DELAY_ms
+  #define AIOT_CONFIG_SUBSCRIBE_RETRY_DELAY_ms            (1000UL)
+#endif
+
+#ifndef AIOT_CONFIG_MAX_SUBSCRIBE_RETRY_DELAY_ms
+  #define AIOT_CONFIG_MAX_SUBSCRIBE_RETRY_DELAY_ms        (32000UL)
+#endif
+
+#ifndef AIOT_CONFIG_MAX_SUBSCRIBE_RETRY_CNT
+  #define AIOT_CONFIG_MAX_SUBSCRIBE_RETRY_CNT             (10)
+#endif
+
+#ifndef AIOT_CONFIG_LASTVALUES_SYNC_RETRY_DELAY_ms
+  #define AIOT_CONFIG_LASTVALUES_SYNC_RETRY_DELAY_ms      (5000UL)
+#endif
+
+#ifndef AIOT_CONFIG_MAX_LASTVALUES_SYNC_RETRY_DELAY_ms
+  #define AIOT_CONFIG_MAX_LASTVALUES_SYNC_RETRY_DELAY_ms  (20000UL)
+#endif
+
+#ifndef AIOT_CONFIG_MAX_LASTVALUES_SYNC_RETRY_CNT
+  #define AIOT_CONFIG_MAX_LASTVALUES_SYNC_RETRY_CNT       (3)
+#endif
+
+#ifndef AIOT_CONFIG_MQTT_QOS
+  #define AIOT_CONFIG_MQTT_QOS                            (0)
+#endif
+
+#ifndef AIOT_CONFIG_MQTT_QOS_EXPERIMENTAL
+  #define AIOT_CONFIG_MQTT_QOS_EXPERIMENTAL               (0)
+#endif
+
+/* ArduinoMqttClient waits for the PUBACK within endMessage(), with QoS 1
+ * every publish blocks update() for a round trip to the broker.
+ */
+#if (AIOT_CONFIG_MQTT_QOS > 0) && !AIOT_CONFIG_MQTT_QOS_EXPERIMENTAL
+  #error "AIOT_CONFIG_MQTT_QOS > 0 is experimental, define AIOT_CONFIG_MQTT_QOS_EXPERIMENTAL to enable it"
+#endif
+
+#ifndef AIOT_CONFIG_MQTT_RETRANSMIT_QUEUE_SIZE
+  #if AIOT_CONFIG_MQTT_QOS > 0
+    #define AIOT_CONFIG_MQTT_RETRANSMIT_QUEUE_SIZE        (4)
+  #else
+    #define AIOT_CONFIG_MQTT_RETRANSMIT_QUEUE_SIZE        (1)
+  #endif
+#endif
+
+#ifndef AIOT_CONFIG_STATS_ENABLED
+  #if defined(ARDUINO_AVR_UNO_WIFI_REV2)
+    #define AIOT_CONFIG_STATS_ENABLED                     (0)
+  #else
+    #define AIOT_CONFIG_STATS_ENABLED                     (1)
+  #endif
+#endif
+
+#ifndef AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s
+  #define AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s              (0)
+#endif
+
+#ifndef AIOT_CONFIG_COMPACT_FLOAT_ENCODING
+  #define AIOT_CONFIG_COMPACT_FLOAT_ENCODING              (0)
+#endif
+
+#ifndef AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE
+  #define AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE              (51)
+#endif
+
+#ifndef AIOT_CONFIG_LPWAN_SPREADING_FACTOR
+  #define AIOT_CONFIG_LPWAN_SPREADING_FACTOR              (12)
+#endif
+
+#ifndef AIOT_CONFIG_LPWAN_DUTY_CYCLE_PERMILLE
+  #define AIOT_CONFIG_LPWAN_DUTY_CYCLE_PERMILLE           (1000)
+#endif
+
+#ifndef AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE
+  #define AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE        (0)
+#endif
+
+#ifndef AIOT_CONFIG_LPWAN_PACKED_ENCODING
+  #define AIOT_CONFIG_LPWAN_PACKED_ENCODING               (0)
+#endif
+
+#ifndef AIOT_CONFIG_PACKED_MAX_FIELD_CNT
+  #define AIOT_CONFIG_PACKED_MAX_FIELD_CNT                (16)
+#endif
+
+#ifndef AIOT_CONFIG_PACKED_KEYFRAME_INTERVAL
+  #define AIOT_CONFIG_PACKED_KEYFRAME_INTERVAL            (8)
+#endif
+
+#ifndef AIOT_CONFIG_FLOAT_REGISTRY_SIZE
+  #define AIOT_CONFIG_FLOAT_REGISTRY_SIZE                 (0)
+#endif
+
+#ifndef AIOT_CONFIG_STRING_HASH_CHANGE_DETECTION
+  #define AIOT_CONFIG_STRING_HASH_CHANGE_DETECTION        (0)
+#endif
+
+#ifndef AIOT_CONFIG_TRACK_MAX_POINTS
+  #define AIOT_CONFIG_TRACK_MAX_POINTS                    (32)
+#endif
+
+#ifndef AIOT_CONFIG_TRACE_BUFFER_SIZE
+  #define AIOT_CONFIG_TRACE_BUFFER_SIZE                   (0)
+#endif
+
 #ifndef DEBUG_ERROR
 # if defined(ARDUINO_AVR_UNO_WIFI_REV2)
 #   define DEBUG_ERROR(fmt, ...) Debug.print(DBG_ERROR, fmt, ## __VA_ARGS__)
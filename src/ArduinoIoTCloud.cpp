@@ -21,6 +21,30 @@
 
 #include <ArduinoIoTCloud.h>
 
+/******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+
+static Permission toPermission(permissionType const permission_type)
+{
+  if (permission_type == READ) {
+    return Permission::Read;
+  } else if (permission_type == WRITE) {
+    return Permission::Write;
+  } else {
+    return Permission::ReadWrite;
+  }
+}
+
+static void configureLegacyProperty(Property & property, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  if (seconds == ON_CHANGE) {
+    property.publishOnChange(minDelta, Property::DEFAULT_MIN_TIME_BETWEEN_UPDATES_MILLIS).onUpdate(fn).onSync(synFn);
+  } else {
+    property.publishEvery(seconds).onUpdate(fn).onSync(synFn);
+  }
+}
+
 /******************************************************************************
  * PUBLIC MEMBER FUNCTIONS
  ******************************************************************************/
@@ -42,127 +66,246 @@ bool ArduinoIoTCloudClass::setTimestamp(String const & prop_name, unsigned long
   return true;
 }
 
+#if AIOT_CONFIG_STATS_ENABLED
+CloudStats const & ArduinoIoTCloudClass::getStats()
+{
+  _stats.updateHeapUsage();
+  return _stats;
+}
+#endif
+
 void ArduinoIoTCloudClass::addCallback(ArduinoIoTCloudEvent const event, OnCloudEventCallback callback)
 {
   _cloud_event_callback[static_cast<size_t>(event)] = callback;
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(Property& property, String name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(Property& property, LiteralName const name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
   addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(Property& property, String name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(Property& property, LiteralName const name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
-  Permission permission = Permission::ReadWrite;
-  if (permission_type == READ) {
-    permission = Permission::Read;
-  } else if (permission_type == WRITE) {
-    permission = Permission::Write;
-  } else {
-    permission = Permission::ReadWrite;
-  }
+  configureLegacyProperty(addPropertyToContainer(_property_container, property, name, toPermission(permission_type), tag), seconds, fn, minDelta, synFn);
+}
 
-  if (seconds == ON_CHANGE) {
-    addPropertyToContainer(_property_container, property, name, permission, tag).publishOnChange(minDelta, Property::DEFAULT_MIN_TIME_BETWEEN_UPDATES_MILLIS).onUpdate(fn).onSync(synFn);
-  } else {
-    addPropertyToContainer(_property_container, property, name, permission, tag).publishEvery(seconds).onUpdate(fn).onSync(synFn);
-  }
+Property& ArduinoIoTCloudClass::addPropertyReal(Property& property, LiteralName const name, Permission const permission)
+{
+  return addPropertyToContainer(_property_container, property, name, permission);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(Property& property, LiteralName const name, int tag, Permission const permission)
+{
+  return addPropertyToContainer(_property_container, property, name, permission, tag);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(bool& property, LiteralName const name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(bool& property, LiteralName const name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  Property* p = new CloudWrapperBool(property);
+  addPropertyReal(*p, name, tag, permission_type, seconds, fn, minDelta, synFn);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(bool& property, LiteralName const name, Permission const permission)
+{
+  return addPropertyReal(property, name, -1, permission);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(bool& property, LiteralName const name, int tag, Permission const permission)
+{
+  Property* p = new CloudWrapperBool(property);
+  return addPropertyToContainer(_property_container, *p, name, permission, tag);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(float& property, LiteralName const name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(float& property, LiteralName const name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  CloudWrapperFloat* p = new CloudWrapperFloat(property);
+#if AIOT_CONFIG_FLOAT_REGISTRY_SIZE > 0
+  p->attach(_float_registry);
+#endif
+  addPropertyReal(*p, name, tag, permission_type, seconds, fn, minDelta, synFn);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(float& property, LiteralName const name, Permission const permission)
+{
+  return addPropertyReal(property, name, -1, permission);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(float& property, LiteralName const name, int tag, Permission const permission)
+{
+  CloudWrapperFloat* p = new CloudWrapperFloat(property);
+#if AIOT_CONFIG_FLOAT_REGISTRY_SIZE > 0
+  p->attach(_float_registry);
+#endif
+  return addPropertyToContainer(_property_container, *p, name, permission, tag);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(int& property, LiteralName const name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(int& property, LiteralName const name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  Property* p = new CloudWrapperInt(property);
+  addPropertyReal(*p, name, tag, permission_type, seconds, fn, minDelta, synFn);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(int& property, LiteralName const name, Permission const permission)
+{
+  return addPropertyReal(property, name, -1, permission);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(int& property, LiteralName const name, int tag, Permission const permission)
+{
+  Property* p = new CloudWrapperInt(property);
+  return addPropertyToContainer(_property_container, *p, name, permission, tag);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(String& property, LiteralName const name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(String& property, LiteralName const name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  Property* p = new CloudWrapperString(property);
+  addPropertyReal(*p, name, tag, permission_type, seconds, fn, minDelta, synFn);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(String& property, LiteralName const name, Permission const permission)
+{
+  return addPropertyReal(property, name, -1, permission);
+}
+
+Property& ArduinoIoTCloudClass::addPropertyReal(String& property, LiteralName const name, int tag, Permission const permission)
+{
+  Property* p = new CloudWrapperString(property);
+  return addPropertyToContainer(_property_container, *p, name, permission, tag);
+}
+
+/* The overloads taking the name as String are meant for names composed at
+ * runtime, the name is copied into the property.
+ */
+
+void ArduinoIoTCloudClass::addPropertyReal(Property& property, String const & name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
+}
+
+void ArduinoIoTCloudClass::addPropertyReal(Property& property, String const & name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+{
+  configureLegacyProperty(addPropertyToContainer(_property_container, property, name, toPermission(permission_type), tag), seconds, fn, minDelta, synFn);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(Property& property, String name, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(Property& property, String const & name, Permission const permission)
 {
   return addPropertyToContainer(_property_container, property, name, permission);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(Property& property, String name, int tag, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(Property& property, String const & name, int tag, Permission const permission)
 {
   return addPropertyToContainer(_property_container, property, name, permission, tag);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(bool& property, String name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(bool& property, String const & name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
   addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(bool& property, String name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(bool& property, String const & name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
   Property* p = new CloudWrapperBool(property);
   addPropertyReal(*p, name, tag, permission_type, seconds, fn, minDelta, synFn);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(bool& property, String name, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(bool& property, String const & name, Permission const permission)
 {
   return addPropertyReal(property, name, -1, permission);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(bool& property, String name, int tag, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(bool& property, String const & name, int tag, Permission const permission)
 {
   Property* p = new CloudWrapperBool(property);
   return addPropertyToContainer(_property_container, *p, name, permission, tag);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(float& property, String name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(float& property, String const & name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
   addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(float& property, String name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(float& property, String const & name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
-  Property* p = new CloudWrapperFloat(property);
+  CloudWrapperFloat* p = new CloudWrapperFloat(property);
+#if AIOT_CONFIG_FLOAT_REGISTRY_SIZE > 0
+  p->attach(_float_registry);
+#endif
   addPropertyReal(*p, name, tag, permission_type, seconds, fn, minDelta, synFn);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(float& property, String name, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(float& property, String const & name, Permission const permission)
 {
   return addPropertyReal(property, name, -1, permission);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(float& property, String name, int tag, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(float& property, String const & name, int tag, Permission const permission)
 {
-  Property* p = new CloudWrapperFloat(property);
+  CloudWrapperFloat* p = new CloudWrapperFloat(property);
+#if AIOT_CONFIG_FLOAT_REGISTRY_SIZE > 0
+  p->attach(_float_registry);
+#endif
   return addPropertyToContainer(_property_container, *p, name, permission, tag);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(int& property, String name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(int& property, String const & name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
   addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(int& property, String name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(int& property, String const & name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
   Property* p = new CloudWrapperInt(property);
   addPropertyReal(*p, name, tag, permission_type, seconds, fn, minDelta, synFn);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(int& property, String name, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(int& property, String const & name, Permission const permission)
 {
   return addPropertyReal(property, name, -1, permission);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(int& property, String name, int tag, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(int& property, String const & name, int tag, Permission const permission)
 {
   Property* p = new CloudWrapperInt(property);
   return addPropertyToContainer(_property_container, *p, name, permission, tag);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(String& property, String name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(String& property, String const & name, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
   addPropertyReal(property, name, -1, permission_type, seconds, fn, minDelta, synFn);
 }
 
-void ArduinoIoTCloudClass::addPropertyReal(String& property, String name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
+void ArduinoIoTCloudClass::addPropertyReal(String& property, String const & name, int tag, permissionType permission_type, long seconds, void(*fn)(void), float minDelta, void(*synFn)(Property & property))
 {
   Property* p = new CloudWrapperString(property);
   addPropertyReal(*p, name, tag, permission_type, seconds, fn, minDelta, synFn);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(String& property, String name, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(String& property, String const & name, Permission const permission)
 {
   return addPropertyReal(property, name, -1, permission);
 }
 
-Property& ArduinoIoTCloudClass::addPropertyReal(String& property, String name, int tag, Permission const permission)
+Property& ArduinoIoTCloudClass::addPropertyReal(String& property, String const & name, int tag, Permission const permission)
 {
   Property* p = new CloudWrapperString(property);
   return addPropertyToContainer(_property_container, *p, name, permission, tag);
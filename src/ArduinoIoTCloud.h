@@ -34,6 +34,7 @@
 
 #include "cbor/CBORDecoder.h"
 
+#include "property/FloatRegistry.h"
 #include "property/Property.h"
 #include "property/PropertyContainer.h"
 #include "property/types/CloudWrapperBool.h"
@@ -42,6 +43,8 @@
 #include "property/types/CloudWrapperString.h"
 
 #include "utility/time/TimeService.h"
+#include "utility/stats/CloudStats.h"
+#include "utility/trace/Trace.h"
 
 /******************************************************************************
    TYPEDEF
@@ -100,23 +103,63 @@ class ArduinoIoTCloudClass
 
     void addCallback(ArduinoIoTCloudEvent const event, OnCloudEventCallback callback);
 
-#define addProperty( v, ...) addPropertyReal(v, #v, __VA_ARGS__)
+#if AIOT_CONFIG_STATS_ENABLED
+    /* Returns counters describing the behaviour of the cloud stack since
+     * startup or the last call to resetStats(), i.e. messages and bytes
+     * transferred, encode/decode durations and reconnections.
+     */
+    CloudStats const & getStats();
+    inline void        resetStats() { _stats.reset(); }
+#endif
+
+    /* Writes the events recorded in the trace buffer (AIOT_CONFIG_TRACE_BUFFER_SIZE,
+     * which must be set as a build flag, see extras/tools/README.md) in binary
+     * form to 'out', e.g. Serial, to be decoded on the host with
+     * extras/tools/trace_decode.py. Returns the number of bytes written.
+     */
+    template <typename WRITER>
+    size_t dumpTrace(WRITER & out)
+    {
+#if AIOT_CONFIG_TRACE_BUFFER_SIZE > 0
+      return aiotc_trace.dump(out);
+#else
+      (void)out;
+      return 0;
+#endif
+    }
+
+#define addProperty( v, ...) addPropertyReal(v, LiteralName(#v), __VA_ARGS__)
+
+    /* Only the string literal passed by the addProperty() macro is referenced,
+     * any other name, i.e. a char const * or a String, is copied and released
+     * together with the property.
+     */
 
     /* The following methods are used for non-LoRa boards which can use the 
      * name of the property to identify a given property within a CBOR message.
      */
 
-    void addPropertyReal(Property& property, String name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-    void addPropertyReal(bool& property, String name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-    void addPropertyReal(float& property, String name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-    void addPropertyReal(int& property, String name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-    void addPropertyReal(String& property, String name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-
-    Property& addPropertyReal(Property& property, String name, Permission const permission);
-    Property& addPropertyReal(bool& property, String name, Permission const permission);
-    Property& addPropertyReal(float& property, String name, Permission const permission);
-    Property& addPropertyReal(int& property, String name, Permission const permission);
-    Property& addPropertyReal(String& property, String name, Permission const permission);
+    void addPropertyReal(Property& property, LiteralName const name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(bool& property, LiteralName const name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(float& property, LiteralName const name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(int& property, LiteralName const name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(String& property, LiteralName const name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(Property& property, String const & name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(bool& property, String const & name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(float& property, String const & name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(int& property, String const & name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(String& property, String const & name, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+
+    Property& addPropertyReal(Property& property, LiteralName const name, Permission const permission);
+    Property& addPropertyReal(bool& property, LiteralName const name, Permission const permission);
+    Property& addPropertyReal(float& property, LiteralName const name, Permission const permission);
+    Property& addPropertyReal(int& property, LiteralName const name, Permission const permission);
+    Property& addPropertyReal(String& property, LiteralName const name, Permission const permission);
+    Property& addPropertyReal(Property& property, String const & name, Permission const permission);
+    Property& addPropertyReal(bool& property, String const & name, Permission const permission);
+    Property& addPropertyReal(float& property, String const & name, Permission const permission);
+    Property& addPropertyReal(int& property, String const & name, Permission const permission);
+    Property& addPropertyReal(String& property, String const & name, Permission const permission);
 
     /* The following methods are for MKR WAN 1300/1310 LoRa boards since
      * they use a number to identify a given property within a CBOR message.
@@ -124,23 +167,39 @@ class ArduinoIoTCloudClass
      * important when using LoRa.
      */
 
-    void addPropertyReal(Property& property, String name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-    void addPropertyReal(bool& property, String name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-    void addPropertyReal(float& property, String name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-    void addPropertyReal(int& property, String name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-    void addPropertyReal(String& property, String name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
-
-    Property& addPropertyReal(Property& property, String name, int tag, Permission const permission);
-    Property& addPropertyReal(bool& property, String name, int tag, Permission const permission);
-    Property& addPropertyReal(float& property, String name, int tag, Permission const permission);
-    Property& addPropertyReal(int& property, String name, int tag, Permission const permission);
-    Property& addPropertyReal(String& property, String name, int tag, Permission const permission);
+    void addPropertyReal(Property& property, LiteralName const name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(bool& property, LiteralName const name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(float& property, LiteralName const name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(int& property, LiteralName const name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(String& property, LiteralName const name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(Property& property, String const & name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(bool& property, String const & name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(float& property, String const & name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(int& property, String const & name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+    void addPropertyReal(String& property, String const & name, int tag, permissionType permission_type = READWRITE, long seconds = ON_CHANGE, void(*fn)(void) = NULL, float minDelta = 0.0f, void(*synFn)(Property & property) = CLOUD_WINS) __attribute__((deprecated("Use addProperty(property, Permission::ReadWrite) instead.")));
+
+    Property& addPropertyReal(Property& property, LiteralName const name, int tag, Permission const permission);
+    Property& addPropertyReal(bool& property, LiteralName const name, int tag, Permission const permission);
+    Property& addPropertyReal(float& property, LiteralName const name, int tag, Permission const permission);
+    Property& addPropertyReal(int& property, LiteralName const name, int tag, Permission const permission);
+    Property& addPropertyReal(String& property, LiteralName const name, int tag, Permission const permission);
+    Property& addPropertyReal(Property& property, String const & name, int tag, Permission const permission);
+    Property& addPropertyReal(bool& property, String const & name, int tag, Permission const permission);
+    Property& addPropertyReal(float& property, String const & name, int tag, Permission const permission);
+    Property& addPropertyReal(int& property, String const & name, int tag, Permission const permission);
+    Property& addPropertyReal(String& property, String const & name, int tag, Permission const permission);
 
   protected:
 
     ConnectionHandler * _connection = nullptr;
     PropertyContainer _property_container;
     TimeService _time_service;
+#if AIOT_CONFIG_STATS_ENABLED
+    CloudStats _stats;
+#endif
+#if AIOT_CONFIG_FLOAT_REGISTRY_SIZE > 0
+    StaticFloatRegistry<AIOT_CONFIG_FLOAT_REGISTRY_SIZE> _float_registry;
+#endif
 
     void execCloudEventCallback(ArduinoIoTCloudEvent const event);
 
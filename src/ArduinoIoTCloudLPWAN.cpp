@@ -26,12 +26,13 @@
 #include<ArduinoIoTCloudLPWAN.h>
 
 #include "cbor/CBOREncoder.h"
+#include "cbor/lib/tinycbor/cbor-lib.h"
 
 /******************************************************************************
    CONSTANTS
  ******************************************************************************/
 
-static size_t const CBOR_LORA_MSG_MAX_SIZE = 255;
+size_t const ArduinoIoTCloudLPWAN::CBOR_LORA_MSG_MAX_SIZE;
 
 /******************************************************************************
    LOCAL MODULE FUNCTIONS
@@ -42,6 +43,81 @@ extern "C" unsigned long getTime()
   return ArduinoCloud.getInternalTime();
 }
 
+/* Every item of an encoded message is a map starting with the identifier
+ * (key 0). Returns the bytes of the item and of its identifier and advances
+ * 'it' to the next item.
+ */
+static bool nextItem(CborValue & it, uint8_t const * & item, uint8_t const * & id, size_t & id_length)
+{
+  CborValue map;
+  int key = -1;
+  item = cbor_value_get_next_byte(&it);
+  if (!cbor_value_is_map(&it) || (cbor_value_enter_container(&it, &map) != CborNoError))
+    return false;
+  if (!cbor_value_is_integer(&map) || (cbor_value_get_int(&map, &key) != CborNoError) || (key != 0) || (cbor_value_advance(&map) != CborNoError))
+    return false;
+  id = cbor_value_get_next_byte(&map);
+  if (cbor_value_advance(&map) != CborNoError)
+    return false;
+  id_length = cbor_value_get_next_byte(&map) - id;
+  return (cbor_value_advance(&it) == CborNoError);
+}
+
+static bool containsIdentifier(uint8_t const * msg, size_t const length, uint8_t const * id, size_t const id_length)
+{
+  CborParser parser;
+  CborValue it, array;
+  if ((cbor_parser_init(msg, length, 0, &parser, &it) != CborNoError) || (cbor_value_enter_container(&it, &array) != CborNoError))
+    return false;
+
+  while (!cbor_value_at_end(&array))
+  {
+    uint8_t const * item, * item_id;
+    size_t item_id_length;
+    if (!nextItem(array, item, item_id, item_id_length))
+      return false;
+    if ((item_id_length == id_length) && (memcmp(item_id, id, id_length) == 0))
+      return true;
+  }
+  return false;
+}
+
+/* Removes the items of the array 'msg' which are superseded by an item of
+ * 'update' for the same property attribute, returns the remaining length.
+ * The message is left as it is if it can't be parsed.
+ */
+static size_t removeSupersededItems(uint8_t * msg, size_t const length, uint8_t const * update, size_t const update_length)
+{
+  CborParser parser;
+  CborValue it, array;
+  if ((cbor_parser_init(msg, length, 0, &parser, &it) != CborNoError) || (cbor_value_enter_container(&it, &array) != CborNoError))
+    return length;
+
+  /* Items are only ever moved towards the front, i.e. behind the parser. */
+  uint8_t * dst = msg + 1;
+  while (!cbor_value_at_end(&array))
+  {
+    uint8_t const * item, * id;
+    size_t id_length;
+    if (!nextItem(array, item, id, id_length))
+      return length;
+    /* Advancing past the last item also consumes the break byte of the
+     * array, which must not be copied along with the item.
+     */
+    uint8_t const * item_end = cbor_value_get_next_byte(&array);
+    if (cbor_value_at_end(&array))
+      item_end--;
+    size_t const item_length = item_end - item;
+    if (!containsIdentifier(update, update_length, id, id_length))
+    {
+      memmove(dst, item, item_length);
+      dst += item_length;
+    }
+  }
+  *dst++ = 0xFF;
+  return dst - msg;
+}
+
 /******************************************************************************
    CTOR/DTOR
  ******************************************************************************/
@@ -51,6 +127,16 @@ ArduinoIoTCloudLPWAN::ArduinoIoTCloudLPWAN()
 , _retryEnable{false}
 , _maxNumRetry{5}
 , _intervalRetry{1000}
+, _get_max_payload_size_func{nullptr}
+, _last_write_result{0}
+, _pending_length{0}
+, _pending_retry_cnt{0}
+, _pending_retry_tick{0}
+, _get_spreading_factor_func{nullptr}
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+, _packed_encoding{false}
+, _packed_fallback{false}
+#endif
 {
 
 }
@@ -105,8 +191,9 @@ ArduinoIoTCloudLPWAN::State ArduinoIoTCloudLPWAN::handle_ConnectPhy()
 
 ArduinoIoTCloudLPWAN::State ArduinoIoTCloudLPWAN::handle_SyncTime()
 {
-  unsigned long const internal_posix_time = _time_service.getTime();
-  DEBUG_VERBOSE("ArduinoIoTCloudLPWAN::%s internal clock configured to posix timestamp %d", __FUNCTION__, internal_posix_time);
+  /* Configures the internal clock unless it is already running. */
+  _time_service.getTime();
+  DEBUG_VERBOSE("ArduinoIoTCloudLPWAN::%s internal clock configured to posix timestamp %d", __FUNCTION__, _time_service.getTime());
   DEBUG_INFO("Connected to Arduino IoT Cloud");
   return State::Connected;
 }
@@ -116,6 +203,11 @@ ArduinoIoTCloudLPWAN::State ArduinoIoTCloudLPWAN::handle_Connected()
   if (!connected())
   {
     DEBUG_ERROR("ArduinoIoTCloudLPWAN::%s connection to gateway lost", __FUNCTION__);
+    AIOT_STATS(onReconnect(static_cast<size_t>(State::Connected)));
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+    /* The first packed uplink after rejoining contains absolute values only. */
+    _packed_encoder.reset();
+#endif
     return State::ConnectPhy;
   }
 
@@ -126,9 +218,20 @@ ArduinoIoTCloudLPWAN::State ArduinoIoTCloudLPWAN::handle_Connected()
   if (_connection->available())
     decodePropertiesFromCloud();
 
+  /* Hold back uplinks while the duty cycle is used up. Changed properties
+   * keep their latest value meanwhile and are merged into the next uplink,
+   * highest priority first.
+   */
+  if (!_duty_cycle.isAvailable())
+    return State::Connected;
+
   /* If properties need updating sent them to the cloud. */
   sendPropertiesToCloud();
 
+  /* Retry a failed uplink once the retry interval has elapsed. */
+  if (isRetryPending() && ((millis() - _pending_retry_tick) >= static_cast<unsigned long>(_intervalRetry)))
+    retryPendingProperties();
+
   return State::Connected;
 }
 
@@ -142,31 +245,170 @@ void ArduinoIoTCloudLPWAN::decodePropertiesFromCloud()
   {
     lora_msg_buf[bytes_received] = _connection->read();
   }
-  CBORDecoder::decode(_property_container, lora_msg_buf, bytes_received);
+  AIOT_STATS(onMessageIn(bytes_received));
+
+  uint8_t const * msg = lora_msg_buf;
+  size_t msg_length = bytes_received;
+#if AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE > 0
+  if (DownlinkReassembler::isFragment(lora_msg_buf, bytes_received))
+  {
+    if (_downlink_reassembler.push(lora_msg_buf, bytes_received) != DownlinkReassembler::Result::Complete)
+      return;
+    msg = _downlink_reassembler.data();
+    msg_length = _downlink_reassembler.length();
+  }
+#endif
+
+  AIOT_STATS_TIMESTAMP(decode_start_us);
+  CBORDecoder::decode(_property_container, msg, msg_length);
+  AIOT_STATS_DURATION(decode_duration_us, decode_start_us);
+  AIOT_TRACE(Decode, msg_length, decode_duration_us);
+  AIOT_STATS(onDecode(decode_duration_us));
 }
 
 void ArduinoIoTCloudLPWAN::sendPropertiesToCloud()
 {
   int bytes_encoded = 0;
-  uint8_t data[CBOR_LORA_MSG_MAX_SIZE];
+  uint8_t data[AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE];
+
+  /* Only as many properties as fit into a single uplink at the current data
+   * rate are encoded, the remaining ones are sent with the next uplink.
+   * While an uplink is waiting for its retry the properties changed in the
+   * meantime are merged into it: the items superseded by a newer value of
+   * the same property attribute are removed and the pending array is
+   * extended by the newly encoded items (without the leading array start and
+   * the trailing break byte). The size check assumes nothing is removed.
+   * A packed uplink can not be extended, the changed properties are sent
+   * once the pending one is gone. Properties which are not part of the packed
+   * schema are sent with the next uplink using the light payload.
+   */
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+  if (_packed_encoding && isRetryPending())
+    return;
+
+  bool const packed = _packed_encoding && !_packed_fallback;
+#endif
+
+  size_t const max_payload_size = getMaxPayloadSize();
+  size_t const pending_items_length = isRetryPending() ? (_pending_length - 2) : 0;
+  if (max_payload_size <= pending_items_length + 2)
+    return;
+
+  AIOT_STATS_TIMESTAMP(encode_start_us);
+#if AIOT_CONFIG_FLOAT_REGISTRY_SIZE > 0
+  _float_registry.scan();
+#endif
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+  CborError const err = packed ? _packed_encoder.encode(_property_container, data, max_payload_size, bytes_encoded)
+                               : CBOREncoder::pack(_property_container, data, max_payload_size - pending_items_length, bytes_encoded, true);
+  _packed_fallback = packed && _packed_encoder.hasRejectedChanges();
+#else
+  CborError const err = CBOREncoder::pack(_property_container, data, max_payload_size - pending_items_length, bytes_encoded, true);
+#endif
+
+  if (err == CborErrorOutOfMemory)
+    AIOT_STATS(onDroppedForSize());
 
-  if (CBOREncoder::encode(_property_container, data, sizeof(data), bytes_encoded, true) == CborNoError)
+  if (err == CborNoError)
     if (bytes_encoded > 0)
-      writeProperties(data, bytes_encoded);
+    {
+      AIOT_STATS_DURATION(encode_duration_us, encode_start_us);
+      AIOT_TRACE(Encode, bytes_encoded, encode_duration_us);
+      AIOT_STATS(onEncode(encode_duration_us));
+      if (isRetryPending())
+      {
+        _pending_length = removeSupersededItems(_pending_msg, _pending_length, data, bytes_encoded);
+        memcpy(_pending_msg + _pending_length - 1, data + 1, bytes_encoded - 1);
+        _pending_length += bytes_encoded - 2;
+      }
+      else
+        writeProperties(data, bytes_encoded);
+    }
+}
+
+size_t ArduinoIoTCloudLPWAN::getMaxPayloadSize()
+{
+  size_t const max_payload_size = _get_max_payload_size_func ? _get_max_payload_size_func() : AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE;
+  return (max_payload_size < AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE) ? max_payload_size : AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE;
 }
 
 int ArduinoIoTCloudLPWAN::writeProperties(const byte data[], int length)
 {
-  int retcode = _connection->write(data, length);
-  int i = 0;
-  while (_retryEnable && retcode < 0 && i < _maxNumRetry)
+  _last_write_result = transmit(data, length);
+
+  if (_last_write_result >= 0)
   {
-    delay(_intervalRetry);
-    retcode = _connection->write(data, length);
-    i++;
+    AIOT_STATS(onMessageOut(length));
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+    _packed_encoder.commit();
+#endif
+    return _last_write_result;
   }
 
-  return 1;
+  /* Keep the message and retry from update() instead of blocking here. */
+  if (_retryEnable && (_maxNumRetry > 0))
+  {
+    memcpy(_pending_msg, data, length);
+    _pending_length = length;
+    _pending_retry_cnt = 0;
+    _pending_retry_tick = millis();
+  }
+  else
+  {
+    AIOT_STATS(onPublishFailure());
+    dropUplink(data);
+  }
+
+  return _last_write_result;
+}
+
+void ArduinoIoTCloudLPWAN::retryPendingProperties()
+{
+  AIOT_STATS(onRetransmit());
+  _pending_retry_cnt++;
+  _last_write_result = transmit(_pending_msg, _pending_length);
+
+  if (_last_write_result >= 0)
+  {
+    AIOT_STATS(onMessageOut(_pending_length));
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+    _packed_encoder.commit();
+#endif
+    _pending_length = 0;
+  }
+  else if (_pending_retry_cnt >= _maxNumRetry)
+  {
+    DEBUG_ERROR("ArduinoIoTCloudLPWAN::%s uplink failed after %d retries, error %d", __FUNCTION__, _pending_retry_cnt, _last_write_result);
+    AIOT_STATS(onPublishFailure());
+    dropUplink(_pending_msg);
+    _pending_length = 0;
+  }
+  else
+    _pending_retry_tick = millis();
+}
+
+void ArduinoIoTCloudLPWAN::dropUplink(const byte data[])
+{
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+  /* The deltas of the next packed uplink must not refer to the values of a
+   * lost one.
+   */
+  if (data[0] == PackedEncoder::FORMAT_MARKER)
+    _packed_encoder.reset();
+#else
+  (void)data;
+#endif
+}
+
+int ArduinoIoTCloudLPWAN::transmit(const byte data[], size_t const length)
+{
+  /* Every attempt is accounted for: a refused uplink merely costs some of the
+   * budget, whereas an uplink exceeding the duty cycle would be refused by the
+   * modem or violate the regulations.
+   */
+  uint8_t const spreading_factor = _get_spreading_factor_func ? _get_spreading_factor_func() : AIOT_CONFIG_LPWAN_SPREADING_FACTOR;
+  _duty_cycle.onTransmit(DutyCycleScheduler::computeAirtime(length, spreading_factor));
+  return _connection->write(data, length);
 }
 
 /******************************************************************************
@@ -24,10 +24,17 @@
 
 #include <ArduinoIoTCloud.h>
 
+#include "packed/PackedEncoder.h"
+#include "utility/lora/DownlinkReassembler.h"
+#include "utility/lora/DutyCycleScheduler.h"
+
 /******************************************************************************
  * CLASS DECLARATION
  ******************************************************************************/
 
+typedef size_t(*GetMaxPayloadSizeFunc)();
+typedef uint8_t(*GetSpreadingFactorFunc)();
+
 class ArduinoIoTCloudLPWAN : public ArduinoIoTCloudClass
 {
   public:
@@ -49,9 +56,57 @@ class ArduinoIoTCloudLPWAN : public ArduinoIoTCloudClass
     inline void setMaxRetry     (int val)  { _maxNumRetry = val; }
     inline void setIntervalRetry(long val) { _intervalRetry = val; }
 
+    /* The maximum payload of an uplink depends on the region and the current
+     * data rate, e.g. 51 bytes at SF12 in EU868. If set, the function is
+     * queried before every uplink, otherwise AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE
+     * is used. Changed properties not fitting into a single uplink are deferred.
+     * AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE is the upper limit in any case, it is
+     * the size of the buffer kept for a retry.
+     */
+    inline void setMaxPayloadSizeFunc(GetMaxPayloadSizeFunc func) { _get_max_payload_size_func = func; }
+
+    /* Result of the last uplink attempt, i.e. the return value of the
+     * connection handler's write(): >= 0 on success, < 0 on error.
+     */
+    inline int  getLastWriteResult() const { return _last_write_result; }
+    /* An uplink which failed is retried from update() every getIntervalRetry()
+     * ms, up to getMaxRetry() times, if retries are enabled.
+     */
+    inline bool isRetryPending    () const { return (_pending_length > 0); }
+
+    /* Uplinks are held back while the duty cycle of all sub-bands of the
+     * region is used up, see DutyCycleScheduler. Unless the duty cycle is
+     * set here or by AIOT_CONFIG_LPWAN_DUTY_CYCLE_PERMILLE uplinks are not
+     * restricted. The airtime of an uplink depends on the spreading factor,
+     * if no function is set to query it AIOT_CONFIG_LPWAN_SPREADING_FACTOR
+     * is assumed.
+     */
+    inline void setSpreadingFactorFunc(GetSpreadingFactorFunc func) { _get_spreading_factor_func = func; }
+    inline bool setDutyCycle(uint16_t const * duty_cycle_permille, size_t const sub_band_cnt) { return _duty_cycle.setSubBands(duty_cycle_permille, sub_band_cnt); }
+    inline DutyCycleScheduler const & getDutyCycle() const { return _duty_cycle; }
+
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+    /* Uplinks are encoded with the PackedEncoder instead of the CBOR light
+     * payload if enabled. The cloud needs the schema of the properties,
+     * as written by printPackedSchema(), in order to decode them.
+     */
+    inline void   setPackedEncoding(bool const enable) { _packed_encoding = enable; }
+    inline bool   isPackedEncoding () const { return _packed_encoding; }
+    inline size_t printPackedSchema(char * buf, size_t const size) { return _packed_encoder.printSchema(_property_container, buf, size); }
+#endif
+
+#if AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE > 0
+    /* Messages exceeding a single downlink are sent by the cloud in fragments,
+     * which are decoded once the last one has been received, see DownlinkReassembler.
+     */
+    inline DownlinkReassembler const & getDownlinkReassembler() const { return _downlink_reassembler; }
+#endif
+
 
   private:
 
+    static size_t const CBOR_LORA_MSG_MAX_SIZE = 255;
+
     enum class State
     {
       ConnectPhy,
@@ -63,6 +118,22 @@ class ArduinoIoTCloudLPWAN : public ArduinoIoTCloudClass
     bool _retryEnable;
     int _maxNumRetry;
     long _intervalRetry;
+    GetMaxPayloadSizeFunc _get_max_payload_size_func;
+    int _last_write_result;
+    uint8_t _pending_msg[AIOT_CONFIG_LPWAN_MAX_PAYLOAD_SIZE];
+    size_t _pending_length;
+    int _pending_retry_cnt;
+    unsigned long _pending_retry_tick;
+    DutyCycleScheduler _duty_cycle;
+    GetSpreadingFactorFunc _get_spreading_factor_func;
+#if AIOT_CONFIG_LPWAN_PACKED_ENCODING
+    bool _packed_encoding;
+    bool _packed_fallback;
+    PackedEncoder _packed_encoder;
+#endif
+#if AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE > 0
+    DownlinkReassembler _downlink_reassembler;
+#endif
 
     State handle_ConnectPhy();
     State handle_SyncTime();
@@ -70,7 +141,11 @@ class ArduinoIoTCloudLPWAN : public ArduinoIoTCloudClass
 
     void decodePropertiesFromCloud();
     void sendPropertiesToCloud();
+    size_t getMaxPayloadSize();
     int writeProperties(const byte data[], int length);
+    int transmit(const byte data[], size_t const length);
+    void retryPendingProperties();
+    void dropUplink(const byte data[]);
 };
 
 /******************************************************************************
@@ -35,14 +35,13 @@
 
 #include "utility/ota/OTA.h"
 #include "utility/ota/FlashSHA256.h"
+#include "utility/hash/FNV1a.h"
 
 #include "cbor/CBOREncoder.h"
 
-/******************************************************************************
-   GLOBAL CONSTANTS
- ******************************************************************************/
-
-static const int TIMEOUT_FOR_LASTVALUES_SYNC = 10000;
+#if (AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s > 0) && !AIOT_CONFIG_STATS_ENABLED
+#  error "AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s requires AIOT_CONFIG_STATS_ENABLED"
+#endif
 
 /******************************************************************************
    LOCAL MODULE FUNCTIONS
@@ -53,16 +52,23 @@ extern "C" unsigned long getTime()
   return ArduinoCloud.getInternalTime();
 }
 
+/* FNV-1a hash of the device id, used to seed the retry jitter with
+ * a value which is different for every device of a fleet.
+ */
+static uint32_t getJitterSeed(String const & device_id)
+{
+  return fnv1a(device_id.c_str(), device_id.length());
+}
+
 /******************************************************************************
    CTOR/DTOR
  ******************************************************************************/
 
 ArduinoIoTCloudTCP::ArduinoIoTCloudTCP()
 : _state{State::ConnectPhy}
-, _lastSyncRequestTickTime{0}
-, _mqtt_data_buf{0}
-, _mqtt_data_len{0}
-, _mqtt_data_request_retransmit{false}
+, _connection_attempt(AIOT_CONFIG_RECONNECTION_RETRY_DELAY_ms, AIOT_CONFIG_MAX_RECONNECTION_RETRY_DELAY_ms)
+, _subscribe_attempt(AIOT_CONFIG_SUBSCRIBE_RETRY_DELAY_ms, AIOT_CONFIG_MAX_SUBSCRIBE_RETRY_DELAY_ms)
+, _last_values_attempt(AIOT_CONFIG_LASTVALUES_SYNC_RETRY_DELAY_ms, AIOT_CONFIG_MAX_LASTVALUES_SYNC_RETRY_DELAY_ms)
 #ifdef BOARD_HAS_ECCX08
 , _sslClient(nullptr, ArduinoIoTCloudTrustAnchor, ArduinoIoTCloudTrustAnchor_NUM, getTime)
 #endif
@@ -70,10 +76,6 @@ ArduinoIoTCloudTCP::ArduinoIoTCloudTCP()
 , _password("")
   #endif
 , _mqttClient{nullptr}
-, _shadowTopicOut("")
-, _shadowTopicIn("")
-, _dataTopicOut("")
-, _dataTopicIn("")
 #if OTA_ENABLED
 , _ota_cap{false}
 , _ota_error{static_cast<int>(OTAError::None)}
@@ -81,6 +83,10 @@ ArduinoIoTCloudTCP::ArduinoIoTCloudTCP()
 , _ota_url{""}
 , _ota_req{false}
 #endif /* OTA_ENABLED */
+#if AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s > 0
+, _diagnostics{""}
+, _diagnostics_tick{0}
+#endif
 {
 
 }
@@ -138,6 +144,7 @@ int ArduinoIoTCloudTCP::begin(String brokerAddress, uint16_t brokerPort)
     return 0;
   }
   ECCX08.end();
+  _mqttClient.setClient(_sslClient);
   #endif
 
   #ifdef BOARD_HAS_ECCX08
@@ -158,13 +165,14 @@ int ArduinoIoTCloudTCP::begin(String brokerAddress, uint16_t brokerPort)
   }
   _sslClient.setClient(_connection->getClient());
   _sslClient.setEccSlot(static_cast<int>(ECCX08Slot::Key), _eccx08_cert.bytes(), _eccx08_cert.length());
+  _mqttClient.setClient(_sslClient);
   #elif defined(BOARD_ESP)
   #ifndef ESP32
   _sslClient.setInsecure();
   #endif
+  _mqttClient.setClient(_sslClient);
   #endif
 
-  _mqttClient.setClient(_sslClient);
   #ifdef BOARD_ESP
   _mqttClient.setUsernamePassword(getDeviceId(), _password);
   #endif
@@ -173,19 +181,31 @@ int ArduinoIoTCloudTCP::begin(String brokerAddress, uint16_t brokerPort)
   _mqttClient.setConnectionTimeout(1500);
   _mqttClient.setId(getDeviceId().c_str());
 
-  _shadowTopicOut = getTopic_shadowout();
-  _shadowTopicIn  = getTopic_shadowin();
-  _dataTopicOut   = getTopic_dataout();
-  _dataTopicIn    = getTopic_datain();
+  if (!_shadowTopicOut.set(getTopic_shadowout()) ||
+      !_shadowTopicIn.set(getTopic_shadowin())   ||
+      !_dataTopicOut.set(getTopic_dataout())     ||
+      !_dataTopicIn.set(getTopic_datain()))
+  {
+    DEBUG_ERROR("ArduinoIoTCloudTCP::%s MQTT topic exceeds %d characters", __FUNCTION__, static_cast<int>(MqttTopic::MAX_LENGTH));
+    return 0;
+  }
+
+  _connection_attempt.seed(getJitterSeed(getDeviceId()));
+  _subscribe_attempt.seed(~getJitterSeed(getDeviceId()));
+  _last_values_attempt.seed(getJitterSeed(getThingId()));
 
 #if OTA_ENABLED
-  addPropertyReal(_ota_cap, "OTA_CAP", Permission::Read);
-  addPropertyReal(_ota_error, "OTA_ERROR", Permission::Read);
-  addPropertyReal(_ota_img_sha256, "OTA_SHA256", Permission::Read);
-  addPropertyReal(_ota_url, "OTA_URL", Permission::ReadWrite).onSync(DEVICE_WINS);
-  addPropertyReal(_ota_req, "OTA_REQ", Permission::ReadWrite).onSync(DEVICE_WINS);
+  addPropertyReal(_ota_cap, LiteralName("OTA_CAP"), Permission::Read);
+  addPropertyReal(_ota_error, LiteralName("OTA_ERROR"), Permission::Read);
+  addPropertyReal(_ota_img_sha256, LiteralName("OTA_SHA256"), Permission::Read);
+  addPropertyReal(_ota_url, LiteralName("OTA_URL"), Permission::ReadWrite).onSync(DEVICE_WINS);
+  addPropertyReal(_ota_req, LiteralName("OTA_REQ"), Permission::ReadWrite).onSync(DEVICE_WINS);
 #endif /* OTA_ENABLED */
 
+#if AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s > 0
+  addPropertyReal(_diagnostics, LiteralName("DIAG"), Permission::Read);
+#endif
+
 #if OTA_STORAGE_SNU && OTA_ENABLED
   String const nina_fw_version = WiFi.firmwareVersion();
   if (nina_fw_version < "1.4.1") {
@@ -213,6 +233,8 @@ void ArduinoIoTCloudTCP::update()
   case State::RequestLastValues:   next_state = handle_RequestLastValues();   break;
   case State::Connected:           next_state = handle_Connected();           break;
   }
+  if (next_state != _state)
+    AIOT_TRACE(StateTransition, (static_cast<uint16_t>(_state) << 8) | static_cast<uint16_t>(next_state), 0);
   _state = next_state;
 
   /* Check for new data from the MQTT client. */
@@ -240,70 +262,155 @@ void ArduinoIoTCloudTCP::printDebugInfo()
 ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handle_ConnectPhy()
 {
   if (_connection->check() == NetworkConnectionState::CONNECTED)
+  {
+    /* Hold back a reconnection attempt until the backoff delay has elapsed. */
+    if (_connection_attempt.isRetry() && !_connection_attempt.isExpired())
+      return State::ConnectPhy;
     return State::SyncTime;
+  }
   else
     return State::ConnectPhy;
 }
 
 ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handle_SyncTime()
 {
-  unsigned long const internal_posix_time = _time_service.getTime();
-  DEBUG_VERBOSE("ArduinoIoTCloudTCP::%s internal clock configured to posix timestamp %d", __FUNCTION__, internal_posix_time);
+  /* Configures the internal clock unless it is already running. */
+  _time_service.getTime();
+  DEBUG_VERBOSE("ArduinoIoTCloudTCP::%s internal clock configured to posix timestamp %d", __FUNCTION__, _time_service.getTime());
   return State::ConnectMqttBroker;
 }
 
 ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handle_ConnectMqttBroker()
 {
+  /* The duration of connect() includes the TLS handshake and CONNECT/CONNACK. */
+  AIOT_STATS(onConnectAttempt());
+#if AIOT_CONFIG_STATS_ENABLED
+  unsigned long const connect_start_ms = millis();
+#endif
+  AIOT_TRACE(MqttConnectBegin, 0, 0);
   if (_mqttClient.connect(_brokerAddress.c_str(), _brokerPort))
+  {
+    AIOT_TRACE(MqttConnectEnd, 1, 0);
+    AIOT_STATS(onHandshake(millis() - connect_start_ms));
+    _subscribe_attempt.reset();
     return State::SubscribeMqttTopics;
+  }
 
+  /* Can't connect to the broker: back off exponentially (with jitter) before the next attempt. */
+  AIOT_TRACE(MqttConnectEnd, 0, 0);
+  AIOT_STATS(onReconnect(static_cast<size_t>(State::ConnectMqttBroker)));
+  unsigned long const wait_time_ms = _connection_attempt.retry();
   DEBUG_ERROR("ArduinoIoTCloudTCP::%s could not connect to %s:%d", __FUNCTION__, _brokerAddress.c_str(), _brokerPort);
+  DEBUG_INFO("ArduinoIoTCloudTCP::%s %d connection attempt at tick time %d, next attempt in %d ms", __FUNCTION__, _connection_attempt.getRetryCount(), millis(), wait_time_ms);
   return State::ConnectPhy;
 }
 
 ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handle_SubscribeMqttTopics()
 {
-  if (!_mqttClient.subscribe(_dataTopicIn))
+  if (!_mqttClient.connected())
+  {
+    DEBUG_ERROR("ArduinoIoTCloudTCP::%s MQTT client connection lost", __FUNCTION__);
+    AIOT_TRACE(ConnectionLost, 0, 0);
+    _mqttClient.stop();
+    _connection_attempt.retry();
+    AIOT_STATS(onReconnect(static_cast<size_t>(State::SubscribeMqttTopics)));
+    return State::ConnectPhy;
+  }
+
+  if (_subscribe_attempt.isRetry() && !_subscribe_attempt.isExpired())
+    return State::SubscribeMqttTopics;
+
+  if (!_mqttClient.subscribe(_dataTopicIn.c_str()))
   {
     DEBUG_ERROR("ArduinoIoTCloudTCP::%s could not subscribe to %s", __FUNCTION__, _dataTopicIn.c_str());
 #if !defined(__AVR__)
     DEBUG_ERROR("Check your thing configuration, and press the reset button on your board.");
 #endif
-    return State::SubscribeMqttTopics;
+    return retrySubscribeMqttTopics();
   }
 
-  if (_shadowTopicIn != "")
+  if (!_shadowTopicIn.isEmpty())
   {
-    if (!_mqttClient.subscribe(_shadowTopicIn))
+    if (!_mqttClient.subscribe(_shadowTopicIn.c_str()))
     {
       DEBUG_ERROR("ArduinoIoTCloudTCP::%s could not subscribe to %s", __FUNCTION__, _shadowTopicIn.c_str());
 #if !defined(__AVR__)
       DEBUG_ERROR("Check your thing configuration, and press the reset button on your board.");
 #endif
-      return State::SubscribeMqttTopics;
+      return retrySubscribeMqttTopics();
     }
   }
 
+  _connection_attempt.reset();
+  _subscribe_attempt.reset();
+  _last_values_attempt.reset();
+
   DEBUG_INFO("Connected to Arduino IoT Cloud");
   execCloudEventCallback(ArduinoIoTCloudEvent::CONNECT);
 
-  if (_shadowTopicIn != "")
+  if (!_shadowTopicIn.isEmpty())
     return State::RequestLastValues;
   else
     return State::Connected;
 }
 
+ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::retrySubscribeMqttTopics()
+{
+  /* Give up on this broker session after too many failed subscriptions
+   * and reconnect, which is subject to the reconnection backoff.
+   */
+  if (_subscribe_attempt.getRetryCount() >= AIOT_CONFIG_MAX_SUBSCRIBE_RETRY_CNT)
+  {
+    _mqttClient.stop();
+    _connection_attempt.retry();
+    AIOT_STATS(onReconnect(static_cast<size_t>(State::SubscribeMqttTopics)));
+    return State::ConnectPhy;
+  }
+
+  unsigned long const wait_time_ms = _subscribe_attempt.retry();
+  DEBUG_INFO("ArduinoIoTCloudTCP::%s %d subscribe attempt at tick time %d, next attempt in %d ms", __FUNCTION__, _subscribe_attempt.getRetryCount(), millis(), wait_time_ms);
+  return State::SubscribeMqttTopics;
+}
+
 ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handle_RequestLastValues()
 {
+  /* Publishing read-only properties and retransmissions may fail and drop the
+   * connection while waiting for the last values.
+   */
+  if (!_mqttClient.connected())
+    return handleConnectionLoss(State::RequestLastValues);
+
   /* Check whether or not we need to send a new request. */
-  unsigned long const now = millis();
-  if ((now - _lastSyncRequestTickTime) > TIMEOUT_FOR_LASTVALUES_SYNC)
+  if (_last_values_attempt.isExpired())
   {
-    DEBUG_VERBOSE("ArduinoIoTCloudTCP::%s [%d] last values requested", __FUNCTION__, now);
+    /* The shadow did not arrive in time for too many times. Stop waiting
+     * and let the device values win: properties which have never been
+     * published are sent with their local value by the next encode.
+     */
+    if (_last_values_attempt.getRetryCount() >= AIOT_CONFIG_MAX_LASTVALUES_SYNC_RETRY_CNT)
+    {
+      DEBUG_WARNING("ArduinoIoTCloudTCP::%s last values not received after %d requests, using device values", __FUNCTION__, _last_values_attempt.getRetryCount());
+      _last_values_attempt.reset();
+      return State::Connected;
+    }
+
+    _last_values_attempt.retry();
+    DEBUG_VERBOSE("ArduinoIoTCloudTCP::%s [%d] last values requested, next request in %d ms", __FUNCTION__, millis(), _last_values_attempt.getWaitTime());
     requestLastValue();
-    _lastSyncRequestTickTime = now;
   }
 
+  /* Messages flagged for retransmission at the connection loss must be sent
+   * before anything else is published, otherwise they are evicted from the
+   * retransmit queue by the next message and lost.
+   */
+  retransmitData();
+
+  /* Properties which are read-only for the cloud can't be changed by the
+   * last values synchronization, hence there is no need to hold them back.
+   */
+  updateTimestampOnLocallyChangedProperties(_property_container);
+  sendPropertiesToCloud(true);
+
   return State::RequestLastValues;
 }
 
@@ -311,18 +418,7 @@ ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handle_Connected()
 {
   if (!_mqttClient.connected())
   {
-    DEBUG_ERROR("ArduinoIoTCloudTCP::%s MQTT client connection lost", __FUNCTION__);
-
-    /* Forcefully disconnect MQTT client and trigger a reconnection. */
-    _mqttClient.stop();
-
-    /* The last message was definitely lost, trigger a retransmit. */
-    _mqtt_data_request_retransmit = true;
-
-    /* We are not connected anymore, trigger the callback for a disconnected event. */
-    execCloudEventCallback(ArduinoIoTCloudEvent::DISCONNECT);
-
-    return State::ConnectPhy;
+    return handleConnectionLoss(State::Connected);
   }
   /* We are connected so let's to our stuff here. */
   else
@@ -339,10 +435,9 @@ ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handle_Connected()
     /* Retransmit data in case there was a lost transaction due
     * to phy layer or MQTT connectivity loss.
     */
-    if(_mqtt_data_request_retransmit && (_mqtt_data_len > 0)) {
-      write(_dataTopicOut, _mqtt_data_buf, _mqtt_data_len);
-      _mqtt_data_request_retransmit = false;
-    }
+    retransmitData();
+
+    updateDiagnostics();
 
     /* Check if any properties need encoding and send them to
     * the cloud if necessary.
@@ -370,6 +465,24 @@ ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handle_Connected()
   }
 }
 
+ArduinoIoTCloudTCP::State ArduinoIoTCloudTCP::handleConnectionLoss(State const state)
+{
+  DEBUG_ERROR("ArduinoIoTCloudTCP::%s MQTT client connection lost in state %d", __FUNCTION__, static_cast<int>(state));
+  AIOT_TRACE(ConnectionLost, 0, 0);
+
+  /* Forcefully disconnect MQTT client and trigger a reconnection. */
+  _mqttClient.stop();
+
+  /* Messages not acknowledged by the broker may have been lost, trigger a retransmit. */
+  _retransmit_queue.requestResend();
+
+  /* We are not connected anymore, trigger the callback for a disconnected event. */
+  AIOT_STATS(onReconnect(static_cast<size_t>(state)));
+  execCloudEventCallback(ArduinoIoTCloudEvent::DISCONNECT);
+
+  return State::ConnectPhy;
+}
+
 void ArduinoIoTCloudTCP::onMessage(int length)
 {
   ArduinoCloud.handleMessage(length);
@@ -377,7 +490,8 @@ void ArduinoIoTCloudTCP::onMessage(int length)
 
 void ArduinoIoTCloudTCP::handleMessage(int length)
 {
-  String topic = _mqttClient.messageTopic();
+  String const topic = _mqttClient.messageTopic();
+  uint32_t const topic_hash = MqttTopic::hash(topic.c_str(), topic.length());
 
   byte bytes[length];
 
@@ -385,38 +499,85 @@ void ArduinoIoTCloudTCP::handleMessage(int length)
     bytes[i] = _mqttClient.read();
   }
 
-  if (_dataTopicIn == topic) {
+  AIOT_STATS(onMessageIn(length));
+  AIOT_TRACE(MessageIn, 0, length);
+
+  if (_dataTopicIn.matches(topic.c_str(), topic.length(), topic_hash)) {
+    AIOT_STATS_TIMESTAMP(decode_start_us);
     CBORDecoder::decode(_property_container, (uint8_t*)bytes, length);
+    AIOT_STATS_DURATION(decode_duration_us, decode_start_us);
+    AIOT_TRACE(Decode, length, decode_duration_us);
+    AIOT_STATS(onDecode(decode_duration_us));
   }
 
-  if ((_shadowTopicIn == topic) && (_state == State::RequestLastValues))
+  if (_shadowTopicIn.matches(topic.c_str(), topic.length(), topic_hash) && (_state == State::RequestLastValues))
   {
     DEBUG_VERBOSE("ArduinoIoTCloudTCP::%s [%d] last values received", __FUNCTION__, millis());
+    AIOT_STATS_TIMESTAMP(decode_start_us);
     CBORDecoder::decode(_property_container, (uint8_t*)bytes, length, true);
+    AIOT_STATS_DURATION(decode_duration_us, decode_start_us);
+    AIOT_TRACE(Decode, length, decode_duration_us);
+    AIOT_STATS(onDecode(decode_duration_us));
     sendPropertiesToCloud();
     execCloudEventCallback(ArduinoIoTCloudEvent::SYNC);
+    _last_values_attempt.reset();
+    AIOT_TRACE(StateTransition, (static_cast<uint16_t>(_state) << 8) | static_cast<uint16_t>(State::Connected), 0);
     _state = State::Connected;
   }
 }
 
-void ArduinoIoTCloudTCP::sendPropertiesToCloud()
+void ArduinoIoTCloudTCP::sendPropertiesToCloud(bool const read_only_only)
 {
   int bytes_encoded = 0;
   uint8_t data[MQTT_TRANSMIT_BUFFER_SIZE];
 
-  if (CBOREncoder::encode(_property_container, data, sizeof(data), bytes_encoded, false) == CborNoError)
+  /* While no message can be stored for a retransmission the properties are
+   * left unchanged and sent once the broker has acknowledged a message.
+   */
+  if (_retransmit_queue.isFull())
+    return;
+
+  AIOT_STATS_TIMESTAMP(encode_start_us);
+#if AIOT_CONFIG_FLOAT_REGISTRY_SIZE > 0
+  _float_registry.scan();
+#endif
+  CborError const err = CBOREncoder::encode(_property_container, data, sizeof(data), bytes_encoded, false, read_only_only);
+
+  if (err == CborErrorOutOfMemory)
+    AIOT_STATS(onDroppedForSize());
+
+  if (err != CborNoError)
+    AIOT_TRACE(EncodeError, static_cast<uint16_t>(err), 0);
+
+  if (err == CborNoError)
     if (bytes_encoded > 0)
     {
-      /* If properties have been encoded store them in the back-up buffer
+      AIOT_STATS_DURATION(encode_duration_us, encode_start_us);
+      AIOT_TRACE(Encode, bytes_encoded, encode_duration_us);
+      AIOT_STATS(onEncode(encode_duration_us));
+      /* If properties have been encoded store them in the retransmit queue
        * in order to allow retransmission in case of failure.
        */
-      _mqtt_data_len = bytes_encoded;
-      memcpy(_mqtt_data_buf, data, _mqtt_data_len);
+      uint16_t const packet_id = _retransmit_queue.push(data, bytes_encoded);
       /* Transmit the properties to the MQTT broker */
-      write(_dataTopicOut, _mqtt_data_buf, _mqtt_data_len);
+      publishData(packet_id, false);
+      /* Messages which have been acknowledged or released are not pending. */
+      AIOT_STATS(onQueueDepth(_retransmit_queue.size()));
     }
 }
 
+void ArduinoIoTCloudTCP::retransmitData()
+{
+  uint16_t packet_id = _retransmit_queue.nextResend();
+  if (packet_id == 0)
+    return;
+
+  for (; packet_id != 0; packet_id = _retransmit_queue.nextResend()) {
+    publishData(packet_id, true);
+  }
+  AIOT_STATS(onQueueDepth(_retransmit_queue.size()));
+}
+
 void ArduinoIoTCloudTCP::requestLastValue()
 {
   // Send the getLastValues CBOR message to the cloud
@@ -426,22 +587,68 @@ void ArduinoIoTCloudTCP::requestLastValue()
   write(_shadowTopicOut, CBOR_REQUEST_LAST_VALUE_MSG, sizeof(CBOR_REQUEST_LAST_VALUE_MSG));
 }
 
-int ArduinoIoTCloudTCP::write(String const topic, byte const data[], int const length)
+void ArduinoIoTCloudTCP::publishData(uint16_t const packet_id, bool const dup)
 {
-  if (_mqttClient.beginMessage(topic, length, false, 0)) {
+  uint8_t const * data = nullptr;
+  size_t length = 0;
+  if (!_retransmit_queue.get(packet_id, data, length))
+    return;
+
+  if (dup)
+    AIOT_STATS(onRetransmit());
+
+  /* With QoS 1 endMessage() blocks until the broker has acknowledged the
+   * message (PUBACK), so it can be removed from the retransmit queue. A failed
+   * publish stops the MQTT client and the message is retransmitted as soon as
+   * the connection is re-established. With QoS 0 there is no acknowledge, the
+   * most recent messages are kept in the queue for retransmission instead.
+   */
+  if (write(_dataTopicOut, data, length, AIOT_CONFIG_MQTT_QOS, dup))
+  {
+    if (AIOT_CONFIG_MQTT_QOS > 0)
+      _retransmit_queue.ack(packet_id);
+    else
+      _retransmit_queue.release(packet_id);
+  }
+}
+
+int ArduinoIoTCloudTCP::write(MqttTopic const & topic, byte const data[], int const length, uint8_t const qos, bool const dup)
+{
+  if (_mqttClient.beginMessage(topic.c_str(), length, false, qos, dup)) {
     if (_mqttClient.write(data, length)) {
       if (_mqttClient.endMessage()) {
+        AIOT_STATS(onMessageOut(length));
+        AIOT_TRACE(MessageOut, 0, length);
         return 1;
       }
     }
   }
+  AIOT_STATS(onPublishFailure());
+  AIOT_TRACE(PublishFailure, 0, length);
   return 0;
 }
 
+void ArduinoIoTCloudTCP::updateDiagnostics()
+{
+#if AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s > 0
+  /* The hidden property 'DIAG' is refreshed periodically and published
+   * on change, the formatting is skipped in between.
+   */
+  if ((millis() - _diagnostics_tick) < (AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s * 1000UL))
+    return;
+
+  _diagnostics_tick = millis();
+  char buf[192];
+  getStats().print(buf, sizeof(buf));
+  _diagnostics = buf;
+#endif
+}
+
 #if OTA_ENABLED
 void ArduinoIoTCloudTCP::onOTARequest()
 {
   DEBUG_VERBOSE("ArduinoIoTCloudTCP::%s _ota_url = %s", __FUNCTION__, _ota_url.c_str());
+  AIOT_TRACE(OtaRequest, 0, 0);
 
   /* Status flag to prevent the reset from being executed
    * when HTTPS download is not supported.
@@ -459,6 +666,7 @@ void ArduinoIoTCloudTCP::onOTARequest()
   {
     DEBUG_ERROR("ArduinoIoTCloudTCP::%s error download to nina: %d", __FUNCTION__, nina_ota_err_code);
     _ota_error = static_cast<int>(OTAError::DownloadFailed);
+    AIOT_TRACE(OtaResult, static_cast<uint16_t>(_ota_error), nina_ota_err_code);
     return;
   }
 
@@ -466,6 +674,8 @@ void ArduinoIoTCloudTCP::onOTARequest()
   ota_download_success = true;
 #endif /* OTA_STORAGE_SNU */
 
+  AIOT_TRACE(OtaResult, static_cast<uint16_t>(OTAError::None), 0);
+
 #ifndef __AVR__
   /* Perform the reset to reboot to SxU. */
   if (ota_download_success)
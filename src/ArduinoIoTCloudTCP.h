@@ -26,6 +26,10 @@
 
 #include <ArduinoIoTCloud.h>
 
+#include "utility/time/TimedAttempt.h"
+#include "utility/mqtt/MqttTopic.h"
+#include "utility/mqtt/RetransmitQueue.h"
+
 #ifdef BOARD_HAS_ECCX08
   #include "tls/BearSSLClient.h"
   #include "tls/utility/ECCX08Cert.h"
@@ -95,13 +99,13 @@ class ArduinoIoTCloudTCP: public ArduinoIoTCloudClass
     };
 
     State _state;
+    TimedAttempt _connection_attempt;
+    TimedAttempt _subscribe_attempt;
+    TimedAttempt _last_values_attempt;
 
-    int _lastSyncRequestTickTime;
     String _brokerAddress;
     uint16_t _brokerPort;
-    uint8_t _mqtt_data_buf[MQTT_TRANSMIT_BUFFER_SIZE];
-    int _mqtt_data_len;
-    bool _mqtt_data_request_retransmit;
+    RetransmitQueue<AIOT_CONFIG_MQTT_RETRANSMIT_QUEUE_SIZE, MQTT_TRANSMIT_BUFFER_SIZE> _retransmit_queue;
 
     #if defined(BOARD_HAS_ECCX08)
     ECCX08CertClass _eccx08_cert;
@@ -116,10 +120,10 @@ class ArduinoIoTCloudTCP: public ArduinoIoTCloudClass
 
     MqttClient _mqttClient;
 
-    String _shadowTopicOut;
-    String _shadowTopicIn;
-    String _dataTopicOut;
-    String _dataTopicIn;
+    MqttTopic _shadowTopicOut;
+    MqttTopic _shadowTopicIn;
+    MqttTopic _dataTopicOut;
+    MqttTopic _dataTopicIn;
 
 #if OTA_ENABLED
     bool _ota_cap;
@@ -129,6 +133,11 @@ class ArduinoIoTCloudTCP: public ArduinoIoTCloudClass
     bool _ota_req;
 #endif /* OTA_ENABLED */
 
+#if AIOT_CONFIG_DIAGNOSTICS_INTERVAL_s > 0
+    String _diagnostics;
+    unsigned long _diagnostics_tick;
+#endif
+
     inline String getTopic_shadowout() { return ( getThingId().length() == 0) ? String("")                            : String("/a/t/" + getThingId() + "/shadow/o"); }
     inline String getTopic_shadowin () { return ( getThingId().length() == 0) ? String("")                            : String("/a/t/" + getThingId() + "/shadow/i"); }
     inline String getTopic_dataout  () { return ( getThingId().length() == 0) ? String("/a/d/" + getDeviceId() + "/e/o") : String("/a/t/" + getThingId() + "/e/o"); }
@@ -138,14 +147,19 @@ class ArduinoIoTCloudTCP: public ArduinoIoTCloudClass
     State handle_SyncTime();
     State handle_ConnectMqttBroker();
     State handle_SubscribeMqttTopics();
+    State retrySubscribeMqttTopics();
     State handle_RequestLastValues();
     State handle_Connected();
+    State handleConnectionLoss(State const state);
 
     static void onMessage(int length);
     void handleMessage(int length);
-    void sendPropertiesToCloud();
+    void sendPropertiesToCloud(bool const read_only_only = false);
     void requestLastValue();
-    int write(String const topic, byte const data[], int const length);
+    void publishData(uint16_t const packet_id, bool const dup);
+    void retransmitData();
+    void updateDiagnostics();
+    int write(MqttTopic const & topic, byte const data[], int const length, uint8_t const qos = 0, bool const dup = false);
 
 #if OTA_ENABLED
     void onOTARequest();
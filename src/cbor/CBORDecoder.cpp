@@ -25,6 +25,8 @@
 #undef min
 #include <algorithm>
 
+#include <limits.h>
+
 #include "CBORDecoder.h"
 
 /******************************************************************************
@@ -66,6 +68,7 @@ void CBORDecoder::decode(PropertyContainer & property_container, uint8_t const *
       case MapParserState::Value        : next_state = handle_Value(&value_iter, map_data); break;
       case MapParserState::StringValue  : next_state = handle_StringValue(&value_iter, map_data); break;
       case MapParserState::BooleanValue : next_state = handle_BooleanValue(&value_iter, map_data); break;
+      case MapParserState::DataValue    : next_state = handle_DataValue(&value_iter, map_data); break;
       case MapParserState::LeaveMap     : next_state = handle_LeaveMap(&map_iter, &value_iter, map_data, property_container, current_property_name, current_property_base_time, current_property_time, isSyncMessage, map_data_list); break;
       case MapParserState::Complete     : /* Nothing to do */ break;
       case MapParserState::Error        : return; break;
@@ -118,6 +121,8 @@ CBORDecoder::MapParserState CBORDecoder::handle_MapKey(CborValue * value_iter) {
           next_state = MapParserState::StringValue;
         } else if (val == static_cast<int>(CborIntegerMapKey::BooleanValue)) {
           next_state = MapParserState::BooleanValue;
+        } else if (val == static_cast<int>(CborIntegerMapKey::DataValue)) {
+          next_state = MapParserState::DataValue;
         } else if (val == static_cast<int>(CborIntegerMapKey::Time)) {
           next_state = MapParserState::Time;
         } else {
@@ -133,7 +138,8 @@ CBORDecoder::MapParserState CBORDecoder::handle_MapKey(CborValue * value_iter) {
 CBORDecoder::MapParserState CBORDecoder::handle_UndefinedKey(CborValue * value_iter) {
   MapParserState next_state = MapParserState::Error;
 
-  if (cbor_value_advance(value_iter) == CborNoError) {
+  /* A malformed map may end with a key which is not followed by a value. */
+  if (!cbor_value_at_end(value_iter) && cbor_value_advance(value_iter) == CborNoError) {
     next_state = MapParserState::MapKey;
   }
 
@@ -214,8 +220,7 @@ CBORDecoder::MapParserState CBORDecoder::handle_Name(CborValue * value_iter, Cbo
       map_data.light_payload.set(true);
       map_data.name_identifier.set(val & 255);
       map_data.attribute_identifier.set(val >> 8);
-      map_data.light_payload.set(true);
-      String name = getPropertyNameByIdentifier(property_container, val);
+      String name = getPropertyNameByIdentifier(property_container, val & 255);
       map_data.name.set(name);
 
 
@@ -223,10 +228,19 @@ CBORDecoder::MapParserState CBORDecoder::handle_Name(CborValue * value_iter, Cbo
         next_state = MapParserState::MapKey;
       }
     }
+  } else if (cbor_value_is_array(value_iter)) {
+    // light payloads of properties with an identifier exceeding 255 use the array [property identifier, attribute identifier]
+    int property_identifier = 0, attribute_identifier = 0;
+    if (decodeIdentifier(value_iter, property_identifier, attribute_identifier)) {
+      map_data.light_payload.set(true);
+      map_data.name_identifier.set(property_identifier);
+      map_data.attribute_identifier.set(attribute_identifier);
+      String name = getPropertyNameByIdentifier(property_container, property_identifier);
+      map_data.name.set(name);
+      next_state = MapParserState::MapKey;
+    }
   }
 
-
-
   return next_state;
 }
 
@@ -265,7 +279,7 @@ CBORDecoder::MapParserState CBORDecoder::handle_BooleanValue(CborValue * value_i
   MapParserState next_state = MapParserState::Error;
 
   bool val = false;
-  if (cbor_value_get_boolean(value_iter, &val) == CborNoError) {
+  if (cbor_value_is_boolean(value_iter) && cbor_value_get_boolean(value_iter, &val) == CborNoError) {
     map_data.bool_val.set(val);
 
     if (cbor_value_advance(value_iter) == CborNoError) {
@@ -276,6 +290,26 @@ CBORDecoder::MapParserState CBORDecoder::handle_BooleanValue(CborValue * value_i
   return next_state;
 }
 
+CBORDecoder::MapParserState CBORDecoder::handle_DataValue(CborValue * value_iter, CborMapData & map_data) {
+  MapParserState next_state = MapParserState::Error;
+
+  if (cbor_value_is_byte_string(value_iter)) {
+    /* The bytes are not copied, the value refers to the payload. Chunked byte
+     * strings are not contiguous in the payload and are skipped.
+     */
+    size_t val_size = 0;
+    bool const is_contiguous = cbor_value_is_length_known(value_iter) && (cbor_value_get_string_length(value_iter, &val_size) == CborNoError);
+    if (cbor_value_advance(value_iter) == CborNoError) {
+      if (is_contiguous) {
+        map_data.data_val.set(CborByteString(cbor_value_get_next_byte(value_iter) - val_size, val_size));
+      }
+      next_state = MapParserState::MapKey;
+    }
+  }
+
+  return next_state;
+}
+
 CBORDecoder::MapParserState CBORDecoder::handle_Time(CborValue * value_iter, CborMapData & map_data) {
   MapParserState next_state = MapParserState::Error;
 
@@ -312,10 +346,10 @@ CBORDecoder::MapParserState CBORDecoder::handle_LeaveMap(CborValue * map_iter, C
     }
     /* Compute the cloud change event baseTime and Time */
     if (map_data.base_time.isSet()) {
-      current_property_base_time = (unsigned long)(map_data.base_time.get());
+      current_property_base_time = convertTimeToUnsignedLong(map_data.base_time.get());
     }
     if (map_data.time.isSet() && (map_data.time.get() > current_property_time)) {
-      current_property_time = (unsigned long)map_data.time.get();
+      current_property_time = convertTimeToUnsignedLong(map_data.time.get());
     }
     map_data_list.push_back(map_data);
     current_property_name = propertyName;
@@ -368,6 +402,33 @@ bool CBORDecoder::ifNumericConvertToDouble(CborValue * value_iter, double * nume
   return false;
 }
 
+/* Decodes [property identifier, attribute identifier], the attribute identifier
+ * may be omitted for properties without attributes, and leaves the array.
+ */
+bool CBORDecoder::decodeIdentifier(CborValue * value_iter, int & property_identifier, int & attribute_identifier) {
+  CborValue identifier_iter;
+  if (cbor_value_enter_container(value_iter, &identifier_iter) != CborNoError)
+    return false;
+
+  if (!cbor_value_is_integer(&identifier_iter) || (cbor_value_get_int(&identifier_iter, &property_identifier) != CborNoError))
+    return false;
+  if (cbor_value_advance(&identifier_iter) != CborNoError)
+    return false;
+
+  attribute_identifier = 0;
+  if (!cbor_value_at_end(&identifier_iter)) {
+    if (!cbor_value_is_integer(&identifier_iter) || (cbor_value_get_int(&identifier_iter, &attribute_identifier) != CborNoError))
+      return false;
+    if (cbor_value_advance(&identifier_iter) != CborNoError)
+      return false;
+  }
+
+  if (!cbor_value_at_end(&identifier_iter))
+    return false;
+
+  return (cbor_value_leave_container(value_iter, &identifier_iter) == CborNoError);
+}
+
 /* Source Idea from https://tools.ietf.org/html/rfc7049 : Page: 50 */
 double CBORDecoder::convertCborHalfFloatToDouble(uint16_t const half_val) {
   int exp = (half_val >> 10) & 0x1f;
@@ -382,3 +443,15 @@ double CBORDecoder::convertCborHalfFloatToDouble(uint16_t const half_val) {
   }
   return half_val & 0x8000 ? -val : val;
 }
+
+/* Converting a double which is out of the range of the target type is undefined
+ * behaviour, times received from the cloud are therefore saturated.
+ */
+unsigned long CBORDecoder::convertTimeToUnsignedLong(double const time) {
+  if (isnan(time) || time <= 0.0) {
+    return 0;
+  } else if (time >= static_cast<double>(ULONG_MAX)) {
+    return ULONG_MAX;
+  }
+  return static_cast<unsigned long>(time);
+}
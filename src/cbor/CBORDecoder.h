@@ -63,6 +63,7 @@ private:
     Value,
     StringValue,
     BooleanValue,
+    DataValue,
     Time,
     LeaveMap,
     Complete,
@@ -79,11 +80,14 @@ private:
   static MapParserState handle_Value(CborValue * value_iter, CborMapData & map_data);
   static MapParserState handle_StringValue(CborValue * value_iter, CborMapData & map_data);
   static MapParserState handle_BooleanValue(CborValue * value_iter, CborMapData & map_data);
+  static MapParserState handle_DataValue(CborValue * value_iter, CborMapData & map_data);
   static MapParserState handle_Time(CborValue * value_iter, CborMapData & map_data);
   static MapParserState handle_LeaveMap(CborValue * map_iter, CborValue * value_iter, CborMapData & map_data, PropertyContainer & property_container, String & current_property_name, unsigned long & current_property_base_time, unsigned long & current_property_time, bool const is_sync_message, std::list<CborMapData> & map_data_list);
 
   static bool   ifNumericConvertToDouble(CborValue * value_iter, double * numeric_val);
+  static bool   decodeIdentifier(CborValue * value_iter, int & property_identifier, int & attribute_identifier);
   static double convertCborHalfFloatToDouble(uint16_t const half_val);
+  static unsigned long convertTimeToUnsignedLong(double const time);
 
 };
 
@@ -31,7 +31,7 @@
  * PUBLIC MEMBER FUNCTIONS
  ******************************************************************************/
 
-CborError CBOREncoder::encode(PropertyContainer & property_container, uint8_t * data, size_t const size, int & bytes_encoded, bool lightPayload)
+CborError CBOREncoder::encode(PropertyContainer & property_container, uint8_t * data, size_t const size, int & bytes_encoded, bool lightPayload, bool readOnlyOnly)
 {
   CborEncoder encoder, arrayEncoder;
 
@@ -47,8 +47,11 @@ CborError CBOREncoder::encode(PropertyContainer & property_container, uint8_t *
   int num_encoded_properties = 0;
   std::for_each(property_container.begin(),
                 property_container.end(),
-                [lightPayload, &arrayEncoder, &error, &num_encoded_properties](Property * p)
+                [lightPayload, readOnlyOnly, &arrayEncoder, &error, &num_encoded_properties](Property * p)
                 {
+                  if (readOnlyOnly && p->isWriteableByCloud())
+                    return;
+
                   if (p->shouldBeUpdated() && p->isReadableByCloud())
                   {
                     error = p->append(&arrayEncoder, lightPayload);
@@ -71,3 +74,69 @@ CborError CBOREncoder::encode(PropertyContainer & property_container, uint8_t *
 
   return CborNoError;
 }
+
+CborError CBOREncoder::pack(PropertyContainer & property_container, uint8_t * data, size_t const size, int & bytes_encoded, bool lightPayload)
+{
+  bytes_encoded = 0;
+
+  /* An empty message consists of the array start and break byte. */
+  if (size < 2)
+    return CborErrorOutOfMemory;
+
+  /* The properties are encoded with one byte less than available, keeping
+   * the room for the break byte closing the array.
+   */
+  CborEncoder encoder, arrayEncoder;
+  cbor_encoder_init(&encoder, data, size - 1, 0);
+  CHECK_CBOR(cbor_encoder_create_array(&encoder, &arrayEncoder, CborIndefiniteLength));
+
+  /* Visit the properties grouped by descending priority. shouldBeUpdated()
+   * must be called only once per property, hence every property is visited
+   * exactly once.
+   */
+  int num_encoded_properties = 0, num_deferred_properties = 0;
+  int priority = -1;
+  std::for_each(property_container.begin(), property_container.end(), [&priority](Property * p) { priority = std::max(priority, static_cast<int>(p->getPriority())); });
+
+  while (priority >= 0)
+  {
+    int next_priority = -1;
+    for (Property * p : property_container)
+    {
+      if (p->getPriority() < priority) {
+        next_priority = std::max(next_priority, static_cast<int>(p->getPriority()));
+        continue;
+      }
+
+      if (p->getPriority() > priority)
+        continue;
+
+      if (!p->shouldBeUpdated() || !p->isReadableByCloud())
+        continue;
+
+      /* A property is only marked as sent if it has been appended entirely,
+       * otherwise the encoder is rolled back to its state before the property.
+       */
+      CborEncoder const rollback = arrayEncoder;
+      CborError const error = p->append(&arrayEncoder, lightPayload);
+      if (error == CborNoError) {
+        num_encoded_properties++;
+      } else if (error == CborErrorOutOfMemory) {
+        arrayEncoder = rollback;
+        num_deferred_properties++;
+      } else {
+        return error;
+      }
+    }
+    priority = next_priority;
+  }
+
+  if (num_encoded_properties == 0)
+    return (num_deferred_properties > 0) ? CborErrorOutOfMemory : CborNoError;
+
+  arrayEncoder.end = data + size;
+  CHECK_CBOR(cbor_encoder_close_container(&encoder, &arrayEncoder));
+  bytes_encoded = cbor_encoder_get_buffer_size(&encoder, data);
+
+  return CborNoError;
+}
@@ -45,7 +45,13 @@ public:
 
     /* encode return > 0 if a property has changed and encodes the changed properties in CBOR format into the provided buffer */
     /* if lightPayload is true the integer identifier of the property will be encoded in the message instead of the property name in order to reduce the size of the message payload*/
-    static CborError encode(PropertyContainer & property_container, uint8_t * data, size_t const size, int & bytes_encoded, bool lightPayload = false);
+    /* if readOnlyOnly is true properties which can be written by the cloud are skipped, e.g. while their last values are still being synchronized */
+    static CborError encode(PropertyContainer & property_container, uint8_t * data, size_t const size, int & bytes_encoded, bool lightPayload = false, bool readOnlyOnly = false);
+    /* pack encodes as many of the changed properties as fit into size bytes, highest priority first. A property which does
+     * not fit is skipped in favour of smaller ones and deferred to a following message. CborErrorOutOfMemory is returned if
+     * properties have changed but not a single one fits.
+     */
+    static CborError pack(PropertyContainer & property_container, uint8_t * data, size_t const size, int & bytes_encoded, bool lightPayload = false);
 
 private:
 
@@ -0,0 +1,397 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+/******************************************************************************
+ * INCLUDE
+ ******************************************************************************/
+
+#include "PackedEncoder.h"
+
+#undef max
+#undef min
+#include <algorithm>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+uint8_t const PackedEncoder::FORMAT_MARKER;
+uint8_t const PackedEncoder::FORMAT_VERSION;
+size_t  const PackedEncoder::HEADER_SIZE;
+size_t  const PackedEncoder::MAX_FIELD_CNT;
+
+/******************************************************************************
+ * CTOR/DTOR
+ ******************************************************************************/
+
+PackedEncoder::PackedEncoder()
+: _field_cnt{0}
+, _property_cnt{0}
+, _rejected_property_cnt{0}
+, _is_describing{false}
+, _msg_cnt{0}
+, _is_keyframe{false}
+, _is_uncommitted{false}
+, _has_rejected_changes{false}
+, _index_bits{0}
+, _data{nullptr}
+, _bit_cnt{0}
+, _bit_pos{0}
+{
+
+}
+
+/******************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ ******************************************************************************/
+
+CborError PackedEncoder::encode(PropertyContainer & property_container, uint8_t * data, size_t const size, int & bytes_encoded)
+{
+  bytes_encoded = 0;
+
+  if (_property_cnt != property_container.size())
+    buildSchema(property_container);
+
+  /* The previous message has neither been committed nor reset. */
+  if (_is_uncommitted)
+    reset();
+
+  if (size <= HEADER_SIZE)
+    return CborErrorOutOfMemory;
+
+  _data = data;
+  _bit_cnt = size * 8;
+  _bit_pos = HEADER_SIZE * 8;
+  _is_keyframe = (_msg_cnt % AIOT_CONFIG_PACKED_KEYFRAME_INTERVAL) == 0;
+
+  /* Visit the properties grouped by descending priority, every property
+   * exactly once, see CBOREncoder::pack().
+   */
+  int num_encoded_properties = 0, num_deferred_properties = 0;
+  int priority = -1;
+  _has_rejected_changes = false;
+  std::for_each(property_container.begin(), property_container.end(), [&priority](Property * p) { priority = std::max(priority, static_cast<int>(p->getPriority())); });
+
+  while (priority >= 0)
+  {
+    int next_priority = -1;
+    for (Property * p : property_container)
+    {
+      if (p->getPriority() < priority) {
+        next_priority = std::max(next_priority, static_cast<int>(p->getPriority()));
+        continue;
+      }
+
+      if (p->getPriority() > priority)
+        continue;
+
+      if (!p->shouldBeUpdated() || !p->isReadableByCloud())
+        continue;
+
+      if (!isInSchema(*p)) {
+        _has_rejected_changes = true;
+        continue;
+      }
+
+      /* The values of a property which could not be appended entirely are
+       * dropped and the bit stream is rolled back.
+       */
+      size_t const rollback = _bit_pos;
+      CborError const error = p->appendPacked(*this);
+      if (error == CborNoError) {
+        num_encoded_properties++;
+      } else {
+        for (size_t i = 0; i < _field_cnt; i++)
+          if (_field[i].property == p)
+            _field[i].has_pending_reference = false;
+        _bit_pos = rollback;
+        if (error == CborErrorOutOfMemory)
+          num_deferred_properties++;
+      }
+    }
+    priority = next_priority;
+  }
+
+  if (num_encoded_properties == 0)
+    return (num_deferred_properties > 0) ? CborErrorOutOfMemory : CborNoError;
+
+  uint16_t const sequence_number = _msg_cnt & 0x0FFF;
+  data[0] = FORMAT_MARKER;
+  data[1] = (FORMAT_VERSION << 5) | (_is_keyframe ? 0x10 : 0x00) | (sequence_number >> 8);
+  data[2] = sequence_number & 0xFF;
+  if (_bit_pos % 8)
+    write(0, 8 - (_bit_pos % 8));
+  bytes_encoded = _bit_pos / 8;
+  _is_uncommitted = true;
+
+  return CborNoError;
+}
+
+void PackedEncoder::commit()
+{
+  if (!_is_uncommitted)
+    return;
+
+  for (size_t i = 0; i < _field_cnt; i++)
+  {
+    Field & field = _field[i];
+    if (field.has_pending_reference) {
+      field.reference = field.pending_reference;
+      field.has_reference = true;
+      field.has_pending_reference = false;
+    }
+  }
+  _msg_cnt++;
+  _is_uncommitted = false;
+}
+
+void PackedEncoder::reset()
+{
+  for (size_t i = 0; i < _field_cnt; i++) {
+    _field[i].has_reference = false;
+    _field[i].has_pending_reference = false;
+  }
+  _msg_cnt = 0;
+  _is_uncommitted = false;
+}
+
+size_t PackedEncoder::printSchema(PropertyContainer & property_container, char * buf, size_t const size)
+{
+  if (_property_cnt != property_container.size())
+    buildSchema(property_container);
+
+  size_t length = snprintf(buf, size, "packed %d %d\n", FORMAT_VERSION, static_cast<int>(_field_cnt));
+  for (size_t i = 0; i < _field_cnt; i++)
+  {
+    Field const & field = _field[i];
+    size_t const offset = std::min(length, size);
+    if (field.type == FieldType::FixedPoint)
+      length += snprintf(buf + offset, size - offset, "%d %s %d %d %c %d %d\n",
+                         static_cast<int>(i + 1), field.property->name(), field.property->identifier(), field.attribute, static_cast<char>(field.type),
+                         field.property->getFixedPointDecimals(), field.property->getFixedPointBits());
+    else
+      length += snprintf(buf + offset, size - offset, "%d %s %d %d %c\n",
+                         static_cast<int>(i + 1), field.property->name(), field.property->identifier(), field.attribute, static_cast<char>(field.type));
+  }
+  return length;
+}
+
+CborError PackedEncoder::append(Property & property, int const attribute, bool const value)
+{
+  if (_is_describing)
+    return addField(property, attribute, FieldType::Bool);
+
+  Field * field = findField(property, attribute);
+  if (!field)
+    return CborErrorUnknownType;
+
+  if (!write(field - _field + 1, _index_bits) || !write(value ? 1 : 0, 1))
+    return CborErrorOutOfMemory;
+
+  return CborNoError;
+}
+
+CborError PackedEncoder::append(Property & property, int const attribute, int const value)
+{
+  if (_is_describing)
+    return addField(property, attribute, property.getFixedPointBits() ? FieldType::FixedPoint : FieldType::Int);
+
+  Field * field = findField(property, attribute);
+  if (!field)
+    return CborErrorUnknownType;
+
+  if (field->type == FieldType::FixedPoint)
+    return appendInteger(*field, toFixedPoint(value, property.getFixedPointDecimals(), property.getFixedPointBits()), property.getFixedPointBits());
+  else
+    return appendInteger(*field, value, 32);
+}
+
+CborError PackedEncoder::append(Property & property, int const attribute, float const value)
+{
+  if (_is_describing)
+    return addField(property, attribute, property.getFixedPointBits() ? FieldType::FixedPoint : FieldType::Float);
+
+  Field * field = findField(property, attribute);
+  if (!field)
+    return CborErrorUnknownType;
+
+  if (field->type == FieldType::FixedPoint)
+    return appendInteger(*field, toFixedPoint(value, property.getFixedPointDecimals(), property.getFixedPointBits()), property.getFixedPointBits());
+
+  uint32_t raw;
+  memcpy(&raw, &value, sizeof(raw));
+  if (!write(field - _field + 1, _index_bits) || !write(raw, 32))
+    return CborErrorOutOfMemory;
+
+  return CborNoError;
+}
+
+CborError PackedEncoder::append(Property & property, int const attribute, String const & value)
+{
+  if (_is_describing)
+    return addField(property, attribute, FieldType::String);
+
+  Field * field = findField(property, attribute);
+  if (!field)
+    return CborErrorUnknownType;
+
+  size_t const length = value.length();
+  if (length > 255)
+    return CborErrorOutOfMemory;
+
+  if (!write(field - _field + 1, _index_bits) || !write(length, 8))
+    return CborErrorOutOfMemory;
+
+  for (size_t i = 0; i < length; i++)
+    if (!write(static_cast<uint8_t>(value[i]), 8))
+      return CborErrorOutOfMemory;
+
+  return CborNoError;
+}
+
+/******************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ ******************************************************************************/
+
+void PackedEncoder::buildSchema(PropertyContainer & property_container)
+{
+  _is_describing = true;
+  _field_cnt = 0;
+  _rejected_property_cnt = 0;
+  /* A property which does not fit into the schema entirely is left out. */
+  for (Property * p : property_container)
+  {
+    if (!p->isReadableByCloud())
+      continue;
+
+    size_t const field_cnt = _field_cnt;
+    if (p->describePacked(*this) != CborNoError) {
+      _field_cnt = field_cnt;
+      _rejected_property_cnt++;
+    }
+  }
+  _is_describing = false;
+  _property_cnt = property_container.size();
+  _index_bits = bitsFor(_field_cnt);
+
+  /* The values sent last refer to the previous schema. */
+  reset();
+}
+
+CborError PackedEncoder::addField(Property & property, int const attribute, FieldType const type)
+{
+  if (_field_cnt == MAX_FIELD_CNT)
+    return CborErrorOutOfMemory;
+
+  Field & field = _field[_field_cnt++];
+  field.property = &property;
+  field.attribute = attribute;
+  field.type = type;
+  field.has_reference = false;
+  field.has_pending_reference = false;
+  field.reference = 0;
+  field.pending_reference = 0;
+  return CborNoError;
+}
+
+bool PackedEncoder::isInSchema(Property const & property) const
+{
+  for (size_t i = 0; i < _field_cnt; i++)
+    if (_field[i].property == &property)
+      return true;
+  return false;
+}
+
+PackedEncoder::Field * PackedEncoder::findField(Property const & property, int const attribute)
+{
+  for (size_t i = 0; i < _field_cnt; i++)
+    if ((_field[i].property == &property) && (_field[i].attribute == attribute))
+      return &_field[i];
+  return nullptr;
+}
+
+CborError PackedEncoder::appendInteger(Field & field, int32_t const value, uint8_t const bits)
+{
+  /* A delta to the value sent last is half as wide as an absolute value. */
+  uint8_t const delta_bits = (bits + 1) / 2;
+  int64_t const delta = static_cast<int64_t>(value) - field.reference;
+  bool const is_delta = !_is_keyframe && field.has_reference && fits(delta, delta_bits);
+
+  if (!write(&field - _field + 1, _index_bits) || !write(is_delta ? 1 : 0, 1))
+    return CborErrorOutOfMemory;
+
+  if (!write(is_delta ? static_cast<uint32_t>(delta) : static_cast<uint32_t>(value), is_delta ? delta_bits : bits))
+    return CborErrorOutOfMemory;
+
+  field.pending_reference = value;
+  field.has_pending_reference = true;
+  return CborNoError;
+}
+
+bool PackedEncoder::write(uint32_t const value, uint8_t const bits)
+{
+  if ((_bit_pos + bits) > _bit_cnt)
+    return false;
+
+  for (uint8_t b = bits; b > 0; b--, _bit_pos++)
+  {
+    uint8_t const mask = 0x80 >> (_bit_pos % 8);
+    if ((value >> (b - 1)) & 1)
+      _data[_bit_pos / 8] |= mask;
+    else
+      _data[_bit_pos / 8] &= ~mask;
+  }
+  return true;
+}
+
+uint8_t PackedEncoder::bitsFor(size_t const value)
+{
+  uint8_t bits = 0;
+  while ((value >> bits) > 0)
+    bits++;
+  return bits;
+}
+
+bool PackedEncoder::fits(int64_t const value, uint8_t const bits)
+{
+  int64_t const max = (static_cast<int64_t>(1) << (bits - 1)) - 1;
+  return (value >= -max - 1) && (value <= max);
+}
+
+int32_t PackedEncoder::toFixedPoint(double const value, int8_t const decimals, uint8_t const bits)
+{
+  double scaled = value;
+  for (int8_t d = decimals; d > 0; d--)
+    scaled *= 10.0;
+  for (int8_t d = decimals; d < 0; d++)
+    scaled /= 10.0;
+
+  /* Saturate instead of wrapping around. */
+  double const max = static_cast<double>((static_cast<int64_t>(1) << (bits - 1)) - 1);
+  if (isnan(scaled))
+    return 0;
+  else if (scaled >= max)
+    return static_cast<int32_t>(max);
+  else if (scaled <= (-max - 1))
+    return static_cast<int32_t>(-max - 1);
+  else
+    return static_cast<int32_t>(lround(scaled));
+}
@@ -0,0 +1,161 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_PACKED_ENCODER_H_
+#define ARDUINO_PACKED_ENCODER_H_
+
+/******************************************************************************
+ * INCLUDE
+ ******************************************************************************/
+
+#include <AIoTC_Config.h>
+
+#include <Arduino.h>
+
+#include "../property/PropertyContainer.h"
+
+/******************************************************************************
+ * CLASS DECLARATION
+ ******************************************************************************/
+
+/* PackedEncoder is a schema driven alternative to the CBOR light payload for
+ * links with a very small payload, i.e. LPWAN. Every attribute of every
+ * property readable by the cloud is a field of the schema, which is derived
+ * from the registered properties and can be exported with printSchema(). A
+ * property is either part of the schema with all of its attributes or not at
+ * all, i.e. if MAX_FIELD_CNT would be exceeded or it has a byte string
+ * attribute. Changes of such properties are sent with the CBOR light payload
+ * instead, see hasRejectedChanges(). A message consists of a three byte header
+ * followed by a bit stream (MSB first) of fields:
+ *
+ *   header: 0xFC | version (3 bits) keyframe (1 bit) sequence number (12 bits)
+ *   field:  index (bitsFor(field count) bits, 1 based) | value
+ *
+ * 0xFC is a reserved initial byte in CBOR, hence a packed message can not be
+ * mistaken for a CBOR one. The stream ends when the remaining bits are less
+ * than an index or the index is 0, the last byte is padded with zeros. The
+ * value of a field depends on its type in the schema:
+ *
+ *   b: 1 bit
+ *   s: length (8 bits) | bytes
+ *   f: IEEE 754 single precision (32 bits)
+ *   i: delta flag (1 bit) | absolute value (32 bits) or delta (16 bits)
+ *   q: delta flag (1 bit) | absolute value (n bits) or delta ((n + 1) / 2 bits),
+ *      fixed point value * 10^d, see Property::encodeFixedPoint()
+ *
+ * All integers are two's complement. A delta refers to the value of the field
+ * in the last message which has been delivered, see commit(). A decoder having
+ * missed a message (gap in the sequence number) must ignore deltas until the
+ * next absolute value of the field. Every AIOT_CONFIG_PACKED_KEYFRAME_INTERVAL
+ * messages and after a message has been lost, see reset(), only absolute
+ * values are sent.
+ */
+class PackedEncoder
+{
+
+public:
+
+  static uint8_t const FORMAT_MARKER  = 0xFC;
+  static uint8_t const FORMAT_VERSION = 2;
+  static size_t  const HEADER_SIZE    = 3;
+  static size_t  const MAX_FIELD_CNT  = AIOT_CONFIG_PACKED_MAX_FIELD_CNT;
+
+  PackedEncoder();
+
+  /* encode packs as many of the changed properties as fit into size bytes,
+   * highest priority first, like CBOREncoder::pack(). The schema is rebuilt
+   * whenever the number of properties has changed. A message has to be
+   * committed once it has been delivered, otherwise it is considered lost by
+   * the next call and the next message is a keyframe.
+   */
+  CborError encode(PropertyContainer & property_container, uint8_t * data, size_t const size, int & bytes_encoded);
+  /* The values of the message encoded last become the reference of deltas. */
+  void commit();
+  /* Forgets the values sent last, the next message is a keyframe. To be
+   * called whenever a message has been lost.
+   */
+  void reset();
+  /* Indicates whether the last call of encode() skipped changed properties
+   * which are not part of the schema.
+   */
+  inline bool hasRejectedChanges() const { return _has_rejected_changes; }
+  /* Writes the schema as text, a header line "packed <version> <field count>"
+   * followed by one line per field "<index> <name> <identifier> <attribute> <type>",
+   * fixed point fields are followed by "<decimals> <bits>". The attribute is
+   * numbered like in the light payload. Returns the length of the complete
+   * schema, which is truncated if it exceeds size - 1.
+   */
+  size_t printSchema(PropertyContainer & property_container, char * buf, size_t const size);
+
+  inline size_t getFieldCount           () const { return _field_cnt; }
+  inline size_t getRejectedPropertyCount() const { return _rejected_property_cnt; }
+
+  /* Called by Property::appendAttributeReal() */
+  CborError append(Property & property, int const attribute, bool const value);
+  CborError append(Property & property, int const attribute, int const value);
+  CborError append(Property & property, int const attribute, float const value);
+  CborError append(Property & property, int const attribute, String const & value);
+
+private:
+
+  enum class FieldType : char
+  {
+    Bool       = 'b',
+    Int        = 'i',
+    Float      = 'f',
+    String     = 's',
+    FixedPoint = 'q',
+  };
+
+  struct Field
+  {
+    Property * property;
+    uint8_t    attribute;
+    FieldType  type;
+    bool       has_reference;
+    bool       has_pending_reference;
+    int32_t    reference;
+    int32_t    pending_reference;
+  };
+
+  Field     _field[MAX_FIELD_CNT];
+  size_t    _field_cnt;
+  size_t    _property_cnt;
+  size_t    _rejected_property_cnt;
+  bool      _is_describing;
+  unsigned long _msg_cnt;
+  bool      _is_keyframe;
+  bool      _is_uncommitted;
+  bool      _has_rejected_changes;
+  uint8_t   _index_bits;
+  uint8_t * _data;
+  size_t    _bit_cnt;
+  size_t    _bit_pos;
+
+  void buildSchema(PropertyContainer & property_container);
+  CborError addField(Property & property, int const attribute, FieldType const type);
+  Field * findField(Property const & property, int const attribute);
+  bool    isInSchema(Property const & property) const;
+  CborError appendInteger(Field & field, int32_t const value, uint8_t const bits);
+  bool write(uint32_t const value, uint8_t const bits);
+
+  static uint8_t bitsFor(size_t const value);
+  static bool fits(int64_t const value, uint8_t const bits);
+  static int32_t toFixedPoint(double const value, int8_t const decimals, uint8_t const bits);
+};
+
+#endif /* ARDUINO_PACKED_ENCODER_H_ */
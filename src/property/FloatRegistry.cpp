@@ -0,0 +1,85 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+/******************************************************************************
+ * INCLUDE
+ ******************************************************************************/
+
+#include "FloatRegistry.h"
+
+#include <math.h>
+
+/******************************************************************************
+ * CTOR/DTOR
+ ******************************************************************************/
+
+FloatRegistry::FloatRegistry(size_t const capacity, float ** primitive_value, float * local_value, float * cloud_value, float * min_delta, uint8_t * is_changed)
+: _capacity{capacity}
+, _size{0}
+, _primitive_value{primitive_value}
+, _local_value{local_value}
+, _cloud_value{cloud_value}
+, _min_delta{min_delta}
+, _is_changed{is_changed}
+{
+
+}
+
+/******************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ ******************************************************************************/
+
+int FloatRegistry::add(float & primitive_value, float const cloud_value)
+{
+  if (_size == _capacity)
+    return -1;
+
+  _primitive_value[_size] = &primitive_value;
+  _local_value[_size] = primitive_value;
+  _cloud_value[_size] = cloud_value;
+  _min_delta[_size] = 0.0f;
+  _is_changed[_size] = 0;
+  return _size++;
+}
+
+/* -O2 only vectorises loops which need no runtime alias checks. */
+__attribute__((optimize("tree-vectorize")))
+size_t FloatRegistry::scan()
+{
+  size_t const  size        = _size;
+  float       * local_value = _local_value;
+  float const * cloud_value = _cloud_value;
+  float const * min_delta   = _min_delta;
+  uint8_t     * is_changed  = _is_changed;
+
+  /* The primitive values are gathered first, which leaves a comparison loop
+   * free of indirections and branches the compiler is able to vectorise.
+   */
+  for (size_t i = 0; i < size; i++)
+    local_value[i] = *_primitive_value[i];
+
+  size_t changed_cnt = 0;
+  for (size_t i = 0; i < size; i++)
+  {
+    /* Same condition as CloudWrapperFloat::isDifferentFromCloud(). */
+    float const delta = local_value[i] - cloud_value[i];
+    uint8_t const changed = (local_value[i] != cloud_value[i]) & (fabsf(delta) >= min_delta[i]);
+    is_changed[i] = changed;
+    changed_cnt += changed;
+  }
+  return changed_cnt;
+}
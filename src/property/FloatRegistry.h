@@ -0,0 +1,91 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_FLOAT_REGISTRY_H_
+#define ARDUINO_FLOAT_REGISTRY_H_
+
+/******************************************************************************
+ * INCLUDE
+ ******************************************************************************/
+
+#include <Arduino.h>
+
+/******************************************************************************
+ * CLASS DECLARATION
+ ******************************************************************************/
+
+/* FloatRegistry keeps the state needed for the change detection of many float
+ * wrappers (see CloudWrapperFloat::attach()) in contiguous arrays, so that all
+ * of them are compared in a single loop by scan() instead of a virtual call of
+ * isDifferentFromCloud() per property. The storage is provided by
+ * StaticFloatRegistry.
+ */
+class FloatRegistry
+{
+
+public:
+
+  /* Returns the index of the new entry or -1 if the registry is full. */
+  int    add        (float & primitive_value, float const cloud_value);
+
+  /* Compares every primitive value with its cloud value and returns the number
+   * of entries which have changed by at least their minimum delta.
+   */
+  size_t scan       ();
+
+  inline size_t  size       () const                 { return _size; }
+  inline size_t  capacity   () const                 { return _capacity; }
+  inline float & cloudValue (size_t const idx)       { return _cloud_value[idx]; }
+  inline bool    isChanged  (size_t const idx) const { return _is_changed[idx]; }
+  inline void    clearChanged(size_t const idx)      { _is_changed[idx] = 0; }
+  inline void    setMinDelta(size_t const idx, float const min_delta) { _min_delta[idx] = min_delta; }
+
+protected:
+
+  FloatRegistry(size_t const capacity, float ** primitive_value, float * local_value, float * cloud_value, float * min_delta, uint8_t * is_changed);
+
+private:
+
+  size_t const _capacity;
+  size_t       _size;
+  float     ** _primitive_value;
+  float      * _local_value;
+  float      * _cloud_value;
+  float      * _min_delta;
+  uint8_t    * _is_changed;
+};
+
+template <size_t SIZE>
+class StaticFloatRegistry : public FloatRegistry
+{
+
+public:
+
+  StaticFloatRegistry()
+  : FloatRegistry(SIZE, _primitive_value_buf, _local_value_buf, _cloud_value_buf, _min_delta_buf, _is_changed_buf)
+  { }
+
+private:
+
+  float * _primitive_value_buf[SIZE];
+  float   _local_value_buf[SIZE];
+  float   _cloud_value_buf[SIZE];
+  float   _min_delta_buf[SIZE];
+  uint8_t _is_changed_buf[SIZE];
+};
+
+#endif /* ARDUINO_FLOAT_REGISTRY_H_ */
@@ -15,78 +15,218 @@
 // a commercial license, send an email to license@arduino.cc.
 //
 
+#include <AIoTC_Config.h>
+
 #include "Property.h"
 
+#include "../packed/PackedEncoder.h"
+#include "../utility/hash/FNV1a.h"
+
 #undef max
 #undef min
 #include <algorithm>
 
+#include <limits.h>
+#include <math.h>
+
 #ifndef ARDUINO_ARCH_SAMD
   #pragma message "No RTC available on this architecture - ArduinoIoTCloud will not keep track of local change timestamps ."
 #endif
 
+/******************************************************************************
+   LOCAL MODULE FUNCTIONS
+ ******************************************************************************/
+
+static bool isIntegral(float const value) {
+  /* Limited to the range of int32_t, beyond which an integer is not shorter than a float. */
+  return (value == truncf(value)) && (fabsf(value) < 2147483648.0f);
+}
+
+/* Returns true if the value can be represented as IEEE 754 half precision float
+ * without loss, the inverse of CBORDecoder::convertCborHalfFloatToDouble().
+ */
+static bool convertFloatToHalf(float const value, uint16_t & half_val) {
+  uint16_t const sign = signbit(value) ? 0x8000 : 0x0000;
+  float const abs_val = fabsf(value);
+
+  if (isnan(value)) {
+    half_val = 0x7E00;
+    return true;
+  } else if (isinf(value)) {
+    half_val = sign | 0x7C00;
+    return true;
+  } else if (abs_val < ldexpf(1.0f, -14)) {
+    /* Subnormal: value = mantissa * 2^-24 */
+    float const mant = ldexpf(abs_val, 24);
+    half_val = sign | static_cast<uint16_t>(mant);
+    return (mant == truncf(mant));
+  }
+
+  /* Normal: value = (1 + mantissa / 1024) * 2^(exponent - 15) */
+  int exp = 0;
+  float const frac = frexpf(abs_val, &exp);
+  int const half_exp = exp - 1 + 15;
+  float const mant = (frac * 2.0f - 1.0f) * 1024.0f;
+  if ((half_exp > 30) || (mant != truncf(mant)))
+    return false;
+
+  half_val = sign | static_cast<uint16_t>(half_exp << 10) | static_cast<uint16_t>(mant);
+  return true;
+}
+
 /******************************************************************************
    CTOR/DTOR
  ******************************************************************************/
 Property::Property()
 : _name{""}
+, _name_length{0}
+, _name_hash{hashName("", 0)}
 , _min_delta_property{0.0f}
 , _min_time_between_updates_millis{DEFAULT_MIN_TIME_BETWEEN_UPDATES_MILLIS}
-, _permission{Permission::Read}
+, _update_interval_seconds{0}
+, _extension{nullptr}
 , _get_time_func{nullptr}
-, _update_callback_func{nullptr}
-, _on_sync_callback_func{nullptr}
-, _update_policy{UpdatePolicy::OnChange}
-, _has_been_updated_once{false}
-, _has_been_modified_in_callback{false}
 , _last_updated_millis{0}
-, _update_interval_millis{0}
 , _last_local_change_timestamp{0}
 , _last_cloud_change_timestamp{0}
+, _map_data_list{nullptr}
+, _packed_encoder{nullptr}
 , _identifier{0}
 , _attributeIdentifier{0}
+, _priority{0}
+, _attribute_mask{ALL_ATTRIBUTES}
+, _permission{static_cast<uint16_t>(Permission::Read)}
+, _update_policy{static_cast<uint16_t>(UpdatePolicy::OnChange)}
+, _has_been_updated_once{false}
+, _has_been_modified_in_callback{false}
 , _lightPayload{false}
 , _update_requested{false}
 , _encode_timestamp{false}
-, _timestamp{0}
+, _encode_compact_float{AIOT_CONFIG_COMPACT_FLOAT_ENCODING}
+, _is_name_owned{false}
+, _sync_policy{static_cast<uint16_t>(SyncPolicy::None)}
 {
 
 }
 
+Property::Property(Property const & other)
+: Property()
+{
+  *this = other;
+}
+
+Property::~Property()
+{
+  if (_is_name_owned) {
+    delete [] _name;
+  }
+  delete _extension;
+}
+
+Property & Property::operator = (Property const & other)
+{
+  if (this == &other) {
+    return (*this);
+  }
+
+  setName(other._name, other._is_name_owned);
+  _min_delta_property = other._min_delta_property;
+  _min_time_between_updates_millis = other._min_time_between_updates_millis;
+  _update_interval_seconds = other._update_interval_seconds;
+  delete _extension;
+  _extension = other._extension ? new PropertyExtension(*other._extension) : nullptr;
+  _get_time_func = other._get_time_func;
+  _last_updated_millis = other._last_updated_millis;
+  _last_local_change_timestamp = other._last_local_change_timestamp;
+  _last_cloud_change_timestamp = other._last_cloud_change_timestamp;
+  _map_data_list = other._map_data_list;
+  _packed_encoder = other._packed_encoder;
+  _identifier = other._identifier;
+  _attributeIdentifier = other._attributeIdentifier;
+  _priority = other._priority;
+  _attribute_mask = other._attribute_mask;
+  _permission = other._permission;
+  _update_policy = other._update_policy;
+  _has_been_updated_once = other._has_been_updated_once;
+  _has_been_modified_in_callback = other._has_been_modified_in_callback;
+  _lightPayload = other._lightPayload;
+  _update_requested = other._update_requested;
+  _encode_timestamp = other._encode_timestamp;
+  _encode_compact_float = other._encode_compact_float;
+  _sync_policy = other._sync_policy;
+  return (*this);
+}
+
 /******************************************************************************
    PUBLIC MEMBER FUNCTIONS
  ******************************************************************************/
-void Property::init(String const name, Permission const permission, GetTimeCallbackFunc func) {
-  _name = name;
-  _permission = permission;
+void Property::init(LiteralName const name, Permission const permission, GetTimeCallbackFunc func) {
+  setName(name.str, false);
+  _permission = static_cast<uint16_t>(permission);
+  _get_time_func = func;
+}
+
+void Property::init(char const * name, Permission const permission, GetTimeCallbackFunc func) {
+  setName(name, true);
+  _permission = static_cast<uint16_t>(permission);
+  _get_time_func = func;
+}
+
+void Property::init(String const & name, Permission const permission, GetTimeCallbackFunc func) {
+  setName(name.c_str(), true);
+  _permission = static_cast<uint16_t>(permission);
   _get_time_func = func;
 }
 
 Property & Property::onUpdate(UpdateCallbackFunc func) {
-  _update_callback_func = func;
+  /* No callback is the default, e.g. passed by the legacy addPropertyReal() */
+  if (func || _extension) {
+    extension().update_callback_func = func;
+  }
   return (*this);
 }
 
 Property & Property::onSync(OnSyncCallbackFunc func) {
-  _on_sync_callback_func = func;
+  if (func == nullptr) {
+    _sync_policy = static_cast<uint16_t>(SyncPolicy::None);
+  } else if (func == MOST_RECENT_WINS) {
+    _sync_policy = static_cast<uint16_t>(SyncPolicy::MostRecentWins);
+  } else if (func == CLOUD_WINS) {
+    _sync_policy = static_cast<uint16_t>(SyncPolicy::CloudWins);
+  } else if (func == DEVICE_WINS) {
+    _sync_policy = static_cast<uint16_t>(SyncPolicy::DeviceWins);
+  } else {
+    _sync_policy = static_cast<uint16_t>(SyncPolicy::Custom);
+    extension().on_sync_callback_func = func;
+  }
   return (*this);
 }
 
 Property & Property::publishOnChange(float const min_delta_property, unsigned long const min_time_between_updates_millis) {
-  _update_policy = UpdatePolicy::OnChange;
+  _update_policy = static_cast<uint16_t>(UpdatePolicy::OnChange);
   _min_delta_property = min_delta_property;
-  _min_time_between_updates_millis = min_time_between_updates_millis;
+  if (min_time_between_updates_millis < MIN_TIME_BETWEEN_UPDATES_IN_EXTENSION) {
+    _min_time_between_updates_millis = static_cast<uint16_t>(min_time_between_updates_millis);
+  } else {
+    extension().min_time_between_updates_millis = min_time_between_updates_millis;
+    _min_time_between_updates_millis = MIN_TIME_BETWEEN_UPDATES_IN_EXTENSION;
+  }
   return (*this);
 }
 
 Property & Property::publishEvery(unsigned long const seconds) {
-  _update_policy = UpdatePolicy::TimeInterval;
-  _update_interval_millis = (seconds * 1000);
+  _update_policy = static_cast<uint16_t>(UpdatePolicy::TimeInterval);
+  if (seconds < UPDATE_INTERVAL_IN_EXTENSION) {
+    _update_interval_seconds = static_cast<uint16_t>(seconds);
+  } else {
+    extension().update_interval_millis = (seconds * 1000);
+    _update_interval_seconds = UPDATE_INTERVAL_IN_EXTENSION;
+  }
   return (*this);
 }
 
 Property & Property::publishOnDemand() {
-  _update_policy = UpdatePolicy::OnDemand;
+  _update_policy = static_cast<uint16_t>(UpdatePolicy::OnDemand);
   return (*this);
 }
 
@@ -96,9 +236,28 @@ Property & Property::encodeTimestamp()
   return (*this);
 }
 
+Property & Property::priority(uint8_t const priority)
+{
+  _priority = priority;
+  return (*this);
+}
+
+Property & Property::encodeFixedPoint(int8_t const decimals, uint8_t const bits)
+{
+  extension().fixed_point_decimals = decimals;
+  extension().fixed_point_bits = std::min(bits, static_cast<uint8_t>(32));
+  return (*this);
+}
+
+Property & Property::encodeCompactFloat(bool const enable)
+{
+  _encode_compact_float = enable;
+  return (*this);
+}
+
 void Property::setTimestamp(unsigned long const timestamp)
 {
-  _timestamp = timestamp;
+  extension().timestamp = timestamp;
 }
 
 bool Property::shouldBeUpdated() {
@@ -106,16 +265,20 @@ bool Property::shouldBeUpdated() {
     return true;
   }
 
+  /* Only cleared once the property has been appended, it may be deferred. */
   if (_has_been_modified_in_callback) {
-    _has_been_modified_in_callback = false;
     return true;
   }
 
-  if (_update_policy == UpdatePolicy::OnChange) {
-    return (isDifferentFromCloud() && ((millis() - _last_updated_millis) >= (_min_time_between_updates_millis)));
-  } else if (_update_policy == UpdatePolicy::TimeInterval) {
-    return ((millis() - _last_updated_millis) >= _update_interval_millis);
-  } else if (_update_policy == UpdatePolicy::OnDemand) {
+  if (updatePolicy() == UpdatePolicy::OnChange) {
+    unsigned long const min_time_between_updates_millis = (_min_time_between_updates_millis == MIN_TIME_BETWEEN_UPDATES_IN_EXTENSION)
+                                                        ? _extension->min_time_between_updates_millis : _min_time_between_updates_millis;
+    return (isDifferentFromCloud() && ((millis() - _last_updated_millis) >= min_time_between_updates_millis));
+  } else if (updatePolicy() == UpdatePolicy::TimeInterval) {
+    unsigned long const update_interval_millis = (_update_interval_seconds == UPDATE_INTERVAL_IN_EXTENSION)
+                                               ? _extension->update_interval_millis : (_update_interval_seconds * 1000UL);
+    return ((millis() - _last_updated_millis) >= update_interval_millis);
+  } else if (updatePolicy() == UpdatePolicy::OnDemand) {
     return _update_requested;
   } else {
     return false;
@@ -128,8 +291,8 @@ void Property::requestUpdate()
 }
 
 void Property::execCallbackOnChange() {
-  if (_update_callback_func != nullptr) {
-    _update_callback_func();
+  if (_extension && (_extension->update_callback_func != nullptr)) {
+    _extension->update_callback_func();
   }
   if (!isDifferentFromCloud()) {
     _has_been_modified_in_callback = true;
@@ -137,23 +300,51 @@ void Property::execCallbackOnChange() {
 }
 
 void Property::execCallbackOnSync() {
-  if (_on_sync_callback_func != nullptr) {
-    _on_sync_callback_func(*this);
+  switch (static_cast<SyncPolicy>(_sync_policy)) {
+    case SyncPolicy::MostRecentWins: MOST_RECENT_WINS(*this);                   break;
+    case SyncPolicy::CloudWins:      CLOUD_WINS(*this);                         break;
+    case SyncPolicy::DeviceWins:     DEVICE_WINS(*this);                        break;
+    case SyncPolicy::Custom:         _extension->on_sync_callback_func(*this); break;
+    case SyncPolicy::None:                                                      break;
   }
 }
 
 CborError Property::append(CborEncoder *encoder, bool lightPayload) {
   _lightPayload = lightPayload;
   _attributeIdentifier = 0;
+  _attribute_mask = selectAttributes();
   CHECK_CBOR(appendAttributesToCloudReal(encoder));
   fromLocalToCloud();
   _has_been_updated_once = true;
+  _has_been_modified_in_callback = false;
   _update_requested = false;
   _last_updated_millis = millis();
   return CborNoError;
 }
 
+CborError Property::appendPacked(PackedEncoder & encoder) {
+  _attribute_mask = selectAttributes();
+  CHECK_CBOR(appendPackedAttributes(encoder));
+  fromLocalToCloud();
+  _has_been_updated_once = true;
+  _has_been_modified_in_callback = false;
+  _update_requested = false;
+  _last_updated_millis = millis();
+  return CborNoError;
+}
+
+CborError Property::describePacked(PackedEncoder & encoder) {
+  _attribute_mask = ALL_ATTRIBUTES;
+  return appendPackedAttributes(encoder);
+}
+
 CborError Property::appendAttributeReal(bool value, String attributeName, CborEncoder *encoder) {
+  if (!nextAttribute(attributeName)) {
+    return CborNoError;
+  }
+  if (_packed_encoder) {
+    return _packed_encoder->append(*this, _attributeIdentifier, value);
+  }
   return appendAttributeName(attributeName, [value](CborEncoder & mapEncoder)
   {
     CHECK_CBOR(cbor_encode_int(&mapEncoder, static_cast<int>(CborIntegerMapKey::BooleanValue)));
@@ -163,6 +354,12 @@ CborError Property::appendAttributeReal(bool value, String attributeName, CborEn
 }
 
 CborError Property::appendAttributeReal(int value, String attributeName, CborEncoder *encoder) {
+  if (!nextAttribute(attributeName)) {
+    return CborNoError;
+  }
+  if (_packed_encoder) {
+    return _packed_encoder->append(*this, _attributeIdentifier, value);
+  }
   return appendAttributeName(attributeName, [value](CborEncoder & mapEncoder)
   {
     CHECK_CBOR(cbor_encode_int(&mapEncoder, static_cast<int>(CborIntegerMapKey::Value)));
@@ -172,15 +369,35 @@ CborError Property::appendAttributeReal(int value, String attributeName, CborEnc
 }
 
 CborError Property::appendAttributeReal(float value, String attributeName, CborEncoder *encoder) {
-  return appendAttributeName(attributeName, [value](CborEncoder & mapEncoder)
+  if (!nextAttribute(attributeName)) {
+    return CborNoError;
+  }
+  if (_packed_encoder) {
+    return _packed_encoder->append(*this, _attributeIdentifier, value);
+  }
+  bool const compact = _encode_compact_float;
+  return appendAttributeName(attributeName, [value, compact](CborEncoder & mapEncoder)
   {
     CHECK_CBOR(cbor_encode_int(&mapEncoder, static_cast<int>(CborIntegerMapKey::Value)));
-    CHECK_CBOR(cbor_encode_float(&mapEncoder, value));
+    uint16_t half_val = 0;
+    if (compact && isIntegral(value)) {
+      CHECK_CBOR(cbor_encode_int(&mapEncoder, static_cast<int64_t>(value)));
+    } else if (compact && convertFloatToHalf(value, half_val)) {
+      CHECK_CBOR(cbor_encode_half_float(&mapEncoder, &half_val));
+    } else {
+      CHECK_CBOR(cbor_encode_float(&mapEncoder, value));
+    }
     return CborNoError;
   }, encoder);
 }
 
 CborError Property::appendAttributeReal(String value, String attributeName, CborEncoder *encoder) {
+  if (!nextAttribute(attributeName)) {
+    return CborNoError;
+  }
+  if (_packed_encoder) {
+    return _packed_encoder->append(*this, _attributeIdentifier, value);
+  }
   return appendAttributeName(attributeName, [value](CborEncoder & mapEncoder)
   {
     CHECK_CBOR(cbor_encode_int(&mapEncoder, static_cast<int>(CborIntegerMapKey::StringValue)));
@@ -189,23 +406,37 @@ CborError Property::appendAttributeReal(String value, String attributeName, Cbor
   }, encoder);
 }
 
+CborError Property::appendAttributeReal(CborByteString const & value, String attributeName, CborEncoder *encoder) {
+  if (!nextAttribute(attributeName)) {
+    return CborNoError;
+  }
+  /* Byte strings are not part of the packed format, the property is left out
+   * of the schema.
+   */
+  if (_packed_encoder) {
+    return CborErrorUnknownType;
+  }
+  return appendAttributeName(attributeName, [value](CborEncoder & mapEncoder)
+  {
+    CHECK_CBOR(cbor_encode_int(&mapEncoder, static_cast<int>(CborIntegerMapKey::DataValue)));
+    CHECK_CBOR(cbor_encode_byte_string(&mapEncoder, value.data, value.length));
+    return CborNoError;
+  }, encoder);
+}
+
 #ifdef __AVR__
 CborError Property::appendAttributeName(String attributeName, nonstd::function<CborError (CborEncoder& mapEncoder)>appendValue, CborEncoder *encoder)
 #else
 CborError Property::appendAttributeName(String attributeName, std::function<CborError (CborEncoder& mapEncoder)>appendValue, CborEncoder *encoder)
 #endif
 {
-  if (attributeName != "") {
-    // when the attribute name string is not empty, the attribute identifier is incremented in order to be encoded in the message if the _lightPayload flag is set
-    _attributeIdentifier++;
-  }
   CborEncoder mapEncoder;
   unsigned int num_map_properties = _encode_timestamp ? 3 : 2;
   CHECK_CBOR(cbor_encoder_create_map(encoder, &mapEncoder, num_map_properties));
   CHECK_CBOR(cbor_encode_int(&mapEncoder, static_cast<int>(CborIntegerMapKey::Name)));
 
   // if _lightPayload is true, the property and attribute identifiers will be encoded instead of the property name
-  if (_lightPayload)
+  if (_lightPayload && (_identifier <= MAX_LEGACY_IDENTIFIER))
   {
     // the most significant byte of the identifier to be encoded represent the property identifier
     int completeIdentifier = _attributeIdentifier * 256;
@@ -213,13 +444,24 @@ CborError Property::appendAttributeName(String attributeName, std::function<Cbor
     completeIdentifier += _identifier;
     CHECK_CBOR(cbor_encode_int(&mapEncoder, completeIdentifier));
   }
+  else if (_lightPayload)
+  {
+    // property identifiers which do not fit into the least significant byte are encoded as [property identifier, attribute identifier]
+    CborEncoder identifierEncoder;
+    CHECK_CBOR(cbor_encoder_create_array(&mapEncoder, &identifierEncoder, 2));
+    CHECK_CBOR(cbor_encode_int(&identifierEncoder, _identifier));
+    CHECK_CBOR(cbor_encode_int(&identifierEncoder, _attributeIdentifier));
+    CHECK_CBOR(cbor_encoder_close_container(&mapEncoder, &identifierEncoder));
+  }
   else
   {
-    String completeName = _name;
     if (attributeName != "") {
+      String completeName = _name;
       completeName += ":" + attributeName;
+      CHECK_CBOR(cbor_encode_text_stringz(&mapEncoder, completeName.c_str()));
+    } else {
+      CHECK_CBOR(cbor_encode_text_string(&mapEncoder, _name, _name_length));
     }
-    CHECK_CBOR(cbor_encode_text_stringz(&mapEncoder, completeName.c_str()));
   }
   /* Encode the value */
   CHECK_CBOR(appendValue(mapEncoder));
@@ -228,13 +470,49 @@ CborError Property::appendAttributeName(String attributeName, std::function<Cbor
   if(_encode_timestamp)
   {
     CHECK_CBOR(cbor_encode_int (&mapEncoder, static_cast<int>(CborIntegerMapKey::Time)));
-    CHECK_CBOR(cbor_encode_uint(&mapEncoder, _timestamp));
+    CHECK_CBOR(cbor_encode_uint(&mapEncoder, _extension ? _extension->timestamp : 0));
   }
   /* Close the container */
   CHECK_CBOR(cbor_encoder_close_container(encoder, &mapEncoder));
   return CborNoError;
 }
 
+bool Property::nextAttribute(String const & attributeName) {
+  if (attributeName != "") {
+    // when the attribute name string is not empty, the attribute identifier is incremented in order to be encoded in the message if the _lightPayload flag is set
+    _attributeIdentifier++;
+  }
+  // attributes without name and those beyond the width of the mask are always encoded
+  if ((_attributeIdentifier == 0) || (_attributeIdentifier > 32)) {
+    return true;
+  }
+  return (_attribute_mask & (1UL << (_attributeIdentifier - 1))) != 0;
+}
+
+uint32_t Property::selectAttributes() {
+  /* Only a property published because it differs from the cloud value is
+   * reduced to the attributes which have changed, all other updates (first
+   * update, time interval, on demand, requested) carry every attribute.
+   */
+  if (!_has_been_updated_once || (updatePolicy() != UpdatePolicy::OnChange) || _update_requested) {
+    return ALL_ATTRIBUTES;
+  }
+  uint32_t const changed_attributes = getChangedAttributes();
+  return changed_attributes ? changed_attributes : ALL_ATTRIBUTES;
+}
+
+CborError Property::appendPackedAttributes(PackedEncoder & encoder) {
+  /* appendAttributeReal() hands the attributes over to the packed encoder
+   * as long as it is set, the attribute identifiers are numbered the same
+   * way as in the light payload.
+   */
+  _packed_encoder = &encoder;
+  _attributeIdentifier = 0;
+  CborError const error = appendAttributesToCloudReal(nullptr);
+  _packed_encoder = nullptr;
+  return error;
+}
+
 void Property::setAttributesFromCloud(std::list<CborMapData> * map_data_list) {
   _map_data_list = map_data_list;
   _attributeIdentifier = 0;
@@ -260,7 +538,17 @@ void Property::setAttributeReal(bool& value, String attributeName) {
 
 void Property::setAttributeReal(int& value, String attributeName) {
   setAttributeReal(attributeName, [&value](CborMapData & md) {
-    value = md.val.get();
+    // Converting a double out of the range of int is undefined, saturate instead
+    double const val = md.val.get();
+    if (isnan(val)) {
+      /* This should not happen. Leave the previous value */
+    } else if (val >= static_cast<double>(INT_MAX)) {
+      value = INT_MAX;
+    } else if (val <= static_cast<double>(INT_MIN)) {
+      value = INT_MIN;
+    } else {
+      value = val;
+    }
   });
 }
 
@@ -276,6 +564,14 @@ void Property::setAttributeReal(String& value, String attributeName) {
   });
 }
 
+void Property::setAttributeReal(CborByteString& value, String attributeName) {
+  setAttributeReal(attributeName, [&value](CborMapData & md) {
+    if (md.data_val.isSet()) {
+      value = md.data_val.get();
+    }
+  });
+}
+
 #ifdef __AVR__
 void Property::setAttributeReal(String attributeName, nonstd::function<void (CborMapData & md)>setValue)
 #else
@@ -346,6 +642,44 @@ void Property::setIdentifier(int identifier) {
   _identifier = identifier;
 }
 
+uint16_t Property::hashName(char const * name, size_t const length) {
+  /* FNV-1a, folded to 16 bit */
+  uint32_t const hash = fnv1a(name, length);
+  return static_cast<uint16_t>((hash >> 16) ^ (hash & 0xFFFF));
+}
+
+/******************************************************************************
+   PRIVATE MEMBER FUNCTIONS
+ ******************************************************************************/
+
+PropertyExtension & Property::extension() {
+  if (!_extension) {
+    _extension = new PropertyExtension{nullptr, nullptr, 0, 0, 0, 0, 0};
+  }
+  return (*_extension);
+}
+
+void Property::setName(char const * name, bool const copy) {
+  char const * const prev_name = _name;
+  bool const is_prev_name_owned = _is_name_owned;
+
+  _name_length = strlen(name);
+  _name_hash = hashName(name, _name_length);
+  if (copy) {
+    char * name_copy = new char[_name_length + 1];
+    memcpy(name_copy, name, _name_length + 1);
+    _name = name_copy;
+  } else {
+    _name = name;
+  }
+  _is_name_owned = copy;
+
+  /* Released last since the new name may be a copy of it. */
+  if (is_prev_name_owned) {
+    delete [] prev_name;
+  }
+}
+
 /******************************************************************************
    SYNCHRONIZATION CALLBACKS
  ******************************************************************************/
@@ -29,6 +29,8 @@
 
 #include <Arduino.h>
 
+#include <string.h>
+
 #undef max
 #undef min
 
@@ -101,6 +103,18 @@ class MapEntry {
 
 };
 
+/* A byte string referring to memory owned by someone else, i.e. the buffer of
+ * a CloudBlob or the payload being decoded.
+ */
+class CborByteString {
+  public:
+    CborByteString() : data(nullptr), length(0) { }
+    CborByteString(uint8_t const * data, size_t const length) : data(data), length(length) { }
+
+    uint8_t const * data;
+    size_t          length;
+};
+
 class CborMapData {
 
   public:
@@ -116,6 +130,8 @@ class CborMapData {
     MapEntry<float>  val;
     MapEntry<String> str_val;
     MapEntry<bool>   bool_val;
+    /* Refers to the payload, i.e. it is only valid within CBORDecoder::decode(). */
+    MapEntry<CborByteString> data_val;
     MapEntry<double> time;
 };
 
@@ -131,11 +147,39 @@ enum class UpdatePolicy {
   OnChange, TimeInterval, OnDemand
 };
 
+class PackedEncoder;
+
 typedef void(*UpdateCallbackFunc)(void);
 typedef unsigned long(*GetTimeCallbackFunc)();
 class Property;
 typedef void(*OnSyncCallbackFunc)(Property &);
 
+/* Settings of features most properties do not use, allocated by a property
+ * on first use of one of them.
+ */
+struct PropertyExtension
+{
+  UpdateCallbackFunc update_callback_func;
+  OnSyncCallbackFunc on_sync_callback_func;
+  /* Only used if they do not fit into Property::_min_time_between_updates_millis
+   * and Property::_update_interval_seconds respectively
+   */
+  unsigned long      min_time_between_updates_millis;
+  unsigned long      update_interval_millis;
+  unsigned long      timestamp;
+  int8_t             fixed_point_decimals;
+  uint8_t            fixed_point_bits;
+};
+
+/* A property name which outlives the property, i.e. the string literal passed
+ * by the addProperty() macro. It is referenced instead of copied.
+ */
+struct LiteralName
+{
+  explicit LiteralName(char const * s) : str{s} { }
+  char const * str;
+};
+
 /******************************************************************************
    CLASS DECLARATION
  ******************************************************************************/
@@ -148,7 +192,13 @@ class Property
 {
   public:
     Property();
-    void init(String const name, Permission const permission, GetTimeCallbackFunc func);
+    Property(Property const & other);
+    virtual ~Property();
+    Property & operator = (Property const & other);
+    /* Only a LiteralName is referenced, any other name is copied. */
+    void init(LiteralName const name, Permission const permission, GetTimeCallbackFunc func);
+    void init(char const * name, Permission const permission, GetTimeCallbackFunc func);
+    void init(String const & name, Permission const permission, GetTimeCallbackFunc func);
 
     /* Composable configuration of the Property class */
     Property & onUpdate(UpdateCallbackFunc func);
@@ -157,18 +207,47 @@ class Property
     Property & publishEvery(unsigned long const seconds);
     Property & publishOnDemand();
     Property & encodeTimestamp();
-
-    inline String name() const {
+    /* Float attributes are encoded as CBOR integer if integral or as half precision float if that is
+     * lossless, otherwise as single precision float. Enabled for all properties if
+     * AIOT_CONFIG_COMPACT_FLOAT_ENCODING is set.
+     */
+    Property & encodeCompactFloat(bool const enable = true);
+    /* Properties with a higher priority are encoded first when not all changed
+     * properties fit into a single message, see CBOREncoder::pack().
+     */
+    Property & priority(uint8_t const priority);
+    /* Numeric attributes are sent as integers of the given width scaled by
+     * 10^decimals by the PackedEncoder, e.g. (2, 12) for a temperature within
+     * [-20.48, 20.47] with a resolution of 0.01. Values out of range saturate.
+     */
+    Property & encodeFixedPoint(int8_t const decimals, uint8_t const bits);
+
+    inline char const * name() const {
       return _name;
     }
+    inline uint16_t nameLength() const {
+      return _name_length;
+    }
+    inline uint16_t nameHash() const {
+      return _name_hash;
+    }
     inline int identifier() const {
       return _identifier;
     }
+    inline uint8_t getPriority() const {
+      return _priority;
+    }
+    inline int8_t getFixedPointDecimals() const {
+      return _extension ? _extension->fixed_point_decimals : 0;
+    }
+    inline uint8_t getFixedPointBits() const {
+      return _extension ? _extension->fixed_point_bits : 0;
+    }
     inline bool   isReadableByCloud() const {
-      return (_permission == Permission::Read) || (_permission == Permission::ReadWrite);
+      return (permission() == Permission::Read) || (permission() == Permission::ReadWrite);
     }
     inline bool   isWriteableByCloud() const {
-      return (_permission == Permission::Write) || (_permission == Permission::ReadWrite);
+      return (permission() == Permission::Write) || (permission() == Permission::ReadWrite);
     }
 
     void setTimestamp(unsigned long const timestamp);
@@ -184,10 +263,13 @@ class Property
 
     void updateLocalTimestamp();
     CborError append(CborEncoder * encoder, bool lightPayload);
+    CborError appendPacked(PackedEncoder & encoder);
+    CborError describePacked(PackedEncoder & encoder);
     CborError appendAttributeReal(bool value, String attributeName = "", CborEncoder *encoder = nullptr);
     CborError appendAttributeReal(int value, String attributeName = "", CborEncoder *encoder = nullptr);
     CborError appendAttributeReal(float value, String attributeName = "", CborEncoder *encoder = nullptr);
     CborError appendAttributeReal(String value, String attributeName = "", CborEncoder *encoder = nullptr);
+    CborError appendAttributeReal(CborByteString const & value, String attributeName = "", CborEncoder *encoder = nullptr);
 #ifndef __AVR__
     CborError appendAttributeName(String attributeName, std::function<CborError (CborEncoder& mapEncoder)>f, CborEncoder *encoder);
     void setAttributeReal(String attributeName, std::function<void (CborMapData & md)>setValue);
@@ -200,6 +282,7 @@ class Property
     void setAttributeReal(int& value, String attributeName = "");
     void setAttributeReal(float& value, String attributeName = "");
     void setAttributeReal(String& value, String attributeName = "");
+    void setAttributeReal(CborByteString& value, String attributeName = "");
     String getAttributeName(String propertyName, char separator);
 
     virtual bool isDifferentFromCloud() = 0;
@@ -210,41 +293,85 @@ class Property
     virtual bool isPrimitive() {
       return false;
     };
+    /* Composite properties return the attributes differing from the cloud value,
+     * bit n - 1 for the attribute with identifier n. A property published on change
+     * only sends these attributes.
+     */
+    virtual uint32_t getChangedAttributes() {
+      return ALL_ATTRIBUTES;
+    }
 
     static unsigned long const DEFAULT_MIN_TIME_BETWEEN_UPDATES_MILLIS = 500; /* Data rate throttled to 2 Hz */
+    /* Light payloads identify a property by (attribute identifier * 256 + property identifier) as long as the
+     * property identifier fits into a byte and by the array [property identifier, attribute identifier] otherwise.
+     */
+    static int const MAX_LEGACY_IDENTIFIER = 255;
+    static uint32_t const ALL_ATTRIBUTES = 0xFFFFFFFF;
+
+    static uint16_t hashName(char const * name, size_t const length);
 
   protected:
+    char const *       _name;
+    uint16_t           _name_length;
+    uint16_t           _name_hash;
     /* Variables used for UpdatePolicy::OnChange */
-    String             _name;
     float              _min_delta_property;
-    unsigned long      _min_time_between_updates_millis;
+    /* MIN_TIME_BETWEEN_UPDATES_IN_EXTENSION if the time is stored in the extension */
+    uint16_t           _min_time_between_updates_millis;
+    /* Variables used for UpdatePolicy::TimeInterval, UPDATE_INTERVAL_IN_EXTENSION if the interval is stored in the extension */
+    uint16_t           _update_interval_seconds;
 
   private:
-    Permission         _permission;
+    static uint16_t const MIN_TIME_BETWEEN_UPDATES_IN_EXTENSION = 0xFFFF;
+    static uint16_t const UPDATE_INTERVAL_IN_EXTENSION = 0xFFFF;
+
+    /* The sync callbacks provided by the library are stored without an extension */
+    enum class SyncPolicy {
+      None, MostRecentWins, CloudWins, DeviceWins, Custom
+    };
+
+    /* Allocated on first use, see PropertyExtension */
+    PropertyExtension * _extension;
     GetTimeCallbackFunc _get_time_func;
-    UpdateCallbackFunc _update_callback_func;
-    OnSyncCallbackFunc _on_sync_callback_func;
-
-    UpdatePolicy       _update_policy;
-    bool               _has_been_updated_once,
-                       _has_been_modified_in_callback;
-    /* Variables used for UpdatePolicy::TimeInterval */
-    unsigned long      _last_updated_millis,
-             _update_interval_millis;
+    /* Variables used for UpdatePolicy::OnChange and UpdatePolicy::TimeInterval */
+    unsigned long      _last_updated_millis;
     /* Variables used for reconnection sync*/
     unsigned long      _last_local_change_timestamp;
     unsigned long      _last_cloud_change_timestamp;
     std::list<CborMapData> * _map_data_list;
+    /* Set while the attributes are appended by a PackedEncoder instead of CBOR */
+    PackedEncoder *    _packed_encoder;
     /* Store the identifier of the property in the array list */
     int                _identifier;
-    int                _attributeIdentifier;
+    uint8_t            _attributeIdentifier;
+    uint8_t            _priority;
+    /* Attributes to be encoded by the ongoing append(), see getChangedAttributes() */
+    uint32_t           _attribute_mask;
+    /* The flags below share a single 16 bit word */
+    uint16_t           _permission                    : 2;
+    uint16_t           _update_policy                 : 2;
+    uint16_t           _has_been_updated_once         : 1;
+    uint16_t           _has_been_modified_in_callback : 1;
     /* Indicates if the property shall be encoded using the identifier instead of the name */
-    bool               _lightPayload;
+    uint16_t           _lightPayload                  : 1;
     /* Indicates whether a property update has been requested in case of the OnDemand update policy. */
-    bool               _update_requested;
+    uint16_t           _update_requested              : 1;
     /* Indicates whether the timestamp shall be encoded in the property or not */
-    bool               _encode_timestamp;
-    unsigned long      _timestamp;
+    uint16_t           _encode_timestamp              : 1;
+    /* Indicates whether float attributes shall be encoded with as few bytes as possible without loss */
+    uint16_t           _encode_compact_float          : 1;
+    /* Indicates whether _name has been copied to the heap and is released by the property */
+    uint16_t           _is_name_owned                 : 1;
+    /* SyncPolicy::Custom if the sync callback is stored in the extension */
+    uint16_t           _sync_policy                   : 3;
+
+    inline Permission   permission  () const { return static_cast<Permission>(_permission); }
+    inline UpdatePolicy updatePolicy() const { return static_cast<UpdatePolicy>(_update_policy); }
+    PropertyExtension & extension();
+    void setName(char const * name, bool const copy);
+    bool nextAttribute(String const & attributeName);
+    uint32_t selectAttributes();
+    CborError appendPackedAttributes(PackedEncoder & encoder);
 };
 
 /******************************************************************************
@@ -252,7 +379,7 @@ class Property
  ******************************************************************************/
 
 inline bool operator == (Property const & lhs, Property const & rhs) {
-  return (lhs.name() == rhs.name());
+  return (lhs.nameHash() == rhs.nameHash()) && (strcmp(lhs.name(), rhs.name()) == 0);
 }
 
 /******************************************************************************
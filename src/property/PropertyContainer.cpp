@@ -35,29 +35,58 @@ void addProperty(PropertyContainer & prop_cont, Property * property_obj, int pro
    PUBLIC FUNCTION DEFINITION
  ******************************************************************************/
 
-Property & addPropertyToContainer(PropertyContainer & prop_cont, Property & property, String const & name, Permission const permission, int propertyIdentifier, GetTimeCallbackFunc func)
+Property & addPropertyToContainer(PropertyContainer & prop_cont, Property & property, LiteralName const name, Permission const permission, int propertyIdentifier, GetTimeCallbackFunc func)
+{
+  /* Check whether or not the property already has been added to the container */
+  Property * p = getProperty(prop_cont, name.str);
+  if(p != nullptr) return (*p);
+
+  /* Initialize property referring to the name and add it to the container */
+  property.init(name, permission, func);
+
+  addProperty(prop_cont, &property, propertyIdentifier);
+  return property;
+}
+
+Property & addPropertyToContainer(PropertyContainer & prop_cont, Property & property, char const * name, Permission const permission, int propertyIdentifier, GetTimeCallbackFunc func)
 {
   /* Check whether or not the property already has been added to the container */
   Property * p = getProperty(prop_cont, name);
   if(p != nullptr) return (*p);
 
-  /* Initialize property and add it to the container */
+  /* Initialize property with a copy of the name and add it to the container */
   property.init(name, permission, func);
 
   addProperty(prop_cont, &property, propertyIdentifier);
   return property;
 }
 
+Property & addPropertyToContainer(PropertyContainer & prop_cont, Property & property, String const & name, Permission const permission, int propertyIdentifier, GetTimeCallbackFunc func)
+{
+  /* Check whether or not the property already has been added to the container */
+  Property * p = getProperty(prop_cont, name);
+  if(p != nullptr) return (*p);
+
+  /* Initialize property with a copy of the name and add it to the container */
+  property.init(name, permission, func);
 
-Property * getProperty(PropertyContainer & prop_cont, String const & name)
+  addProperty(prop_cont, &property, propertyIdentifier);
+  return property;
+}
+
+Property * getProperty(PropertyContainer & prop_cont, char const * name)
 {
   std::list<Property *>::iterator iter;
 
+  /* The precomputed length and hash rule out most properties without comparing their names. */
+  size_t const length = strlen(name);
+  uint16_t const hash = Property::hashName(name, length);
+
   iter = std::find_if(prop_cont.begin(),
                       prop_cont.end(),
-                      [name](Property * p) -> bool
+                      [name, length, hash](Property * p) -> bool
                       {
-                        return (p->name() == name);
+                        return (p->nameLength() == length) && (p->nameHash() == hash) && (strcmp(p->name(), name) == 0);
                       });
 
   if (iter == prop_cont.end())
@@ -66,6 +95,11 @@ Property * getProperty(PropertyContainer & prop_cont, String const & name)
     return (*iter);
 }
 
+Property * getProperty(PropertyContainer & prop_cont, String const & name)
+{
+  return getProperty(prop_cont, name.c_str());
+}
+
 Property * getProperty(PropertyContainer & prop_cont, int const identifier)
 {
   std::list<Property *>::iterator iter;
@@ -129,12 +163,7 @@ void updateProperty(PropertyContainer & prop_cont, String propertyName, unsigned
 
 String getPropertyNameByIdentifier(PropertyContainer & prop_cont, int propertyIdentifier)
 {
-  Property * property = nullptr;
-
-  if (propertyIdentifier > 255)
-    property = getProperty(prop_cont, propertyIdentifier & 255);
-  else
-    property = getProperty(prop_cont, propertyIdentifier);
+  Property * property = getProperty(prop_cont, propertyIdentifier);
 
   if (property)
     return property->name();
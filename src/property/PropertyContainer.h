@@ -39,6 +39,8 @@
 #include "types/CloudInt.h"
 #include "types/CloudString.h"
 #include "types/CloudLocation.h"
+#include "types/CloudTrack.h"
+#include "types/CloudBlob.h"
 #include "types/CloudColor.h"
 #include "types/CloudWrapperBase.h"
 
@@ -99,6 +101,20 @@ typedef CloudFloat CloudRelativeHumidity;
    FUNCTION DECLARATION
  ******************************************************************************/
 
+/* The name is not copied, it has to outlive the property. */
+Property & addPropertyToContainer(PropertyContainer & prop_cont,
+                                  Property & property,
+                                  LiteralName const name,
+                                  Permission const permission,
+                                  int propertyIdentifier = -1,
+                                  GetTimeCallbackFunc func = getTime);
+/* The name is copied, i.e. for names composed at runtime. */
+Property & addPropertyToContainer(PropertyContainer & prop_cont,
+                                  Property & property,
+                                  char const * name,
+                                  Permission const permission,
+                                  int propertyIdentifier = -1,
+                                  GetTimeCallbackFunc func = getTime);
 Property & addPropertyToContainer(PropertyContainer & prop_cont,
                                   Property & property,
                                   String const & name,
@@ -107,6 +123,7 @@ Property & addPropertyToContainer(PropertyContainer & prop_cont,
                                   GetTimeCallbackFunc func = getTime);
 
   
+Property * getProperty(PropertyContainer & prop_cont, char const * name);
 Property * getProperty(PropertyContainer & prop_cont, String const & name);
 Property * getProperty(PropertyContainer & prop_cont, int const identifier);
 
@@ -0,0 +1,115 @@
+//
+// This file is part of ArduinoCloudThing
+//
+// Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+//
+// This software is released under the GNU General Public License version 3,
+// which covers the main part of ArduinoCloudThing.
+// The terms of this license can be found at:
+// https://www.gnu.org/licenses/gpl-3.0.en.html
+//
+// You can be released from the requirements of the above licenses by purchasing
+// a commercial license. Buying such a license is mandatory if you want to modify or
+// otherwise use the software for commercial activities involving the Arduino
+// software without disclosing the source code of your own applications. To purchase
+// a commercial license, send an email to license@arduino.cc.
+//
+
+#ifndef CLOUDBLOB_H_
+#define CLOUDBLOB_H_
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <string.h>
+#include <Arduino.h>
+#include "../Property.h"
+#include "../../utility/hash/FNV1a.h"
+
+/******************************************************************************
+   CLASS DECLARATION
+ ******************************************************************************/
+
+/* CloudBlob publishes the first length() bytes of a buffer owned by the
+ * sketch as a CBOR byte string (SenML data value) without copying them.
+ * Changes are detected by the length and a hash of the bytes sent last. A
+ * value received from the cloud is copied straight from the payload into the
+ * buffer, values exceeding its capacity are ignored.
+ */
+class CloudBlob : public Property {
+  private:
+    uint8_t *      _buffer;
+    size_t         _capacity,
+                   _length;
+    /* Points into the payload being decoded, i.e. it is only valid until
+     * the decoder returns. It is therefore cleared whenever a new value is
+     * received and when the device value wins the sync, otherwise a later
+     * ignored update would copy from a stale payload in fromCloudToLocal().
+     */
+    CborByteString _cloud_value;
+    uint32_t       _cloud_hash;
+    size_t         _cloud_length;
+
+    static inline uint32_t hash(uint8_t const * data, size_t const length) {
+      return fnv1a(reinterpret_cast<char const *>(data), length);
+    }
+  public:
+    CloudBlob(uint8_t * buffer, size_t const capacity, size_t const length = 0) :
+      _buffer(buffer),
+      _capacity(capacity),
+      _length((length < capacity) ? length : capacity),
+      _cloud_value(),
+      _cloud_hash(hash(buffer, _length)),
+      _cloud_length(_length) {
+    }
+
+    /* To be called once the first 'length' bytes of the buffer have been written. */
+    void setLength(size_t const length) {
+      _length = (length < _capacity) ? length : _capacity;
+      updateLocalTimestamp();
+    }
+
+    inline uint8_t const * data() const {
+      return _buffer;
+    }
+    inline size_t length() const {
+      return _length;
+    }
+    inline size_t capacity() const {
+      return _capacity;
+    }
+
+    virtual bool isDifferentFromCloud() {
+      return (_length != _cloud_length) || (hash(_buffer, _length) != _cloud_hash);
+    }
+    virtual void fromCloudToLocal() {
+      if (!_cloud_value.data) {
+        return;
+      }
+      memcpy(_buffer, _cloud_value.data, _cloud_value.length);
+      _length = _cloud_value.length;
+      _cloud_value = CborByteString();
+    }
+    virtual void fromLocalToCloud() {
+      _cloud_value = CborByteString();
+      _cloud_hash = hash(_buffer, _length);
+      _cloud_length = _length;
+    }
+    virtual CborError appendAttributesToCloud() {
+      CborByteString const value(_buffer, _length);
+      return appendAttribute(value);
+    }
+    virtual void setAttributesFromCloud() {
+      CborByteString value;
+      _cloud_value = CborByteString();
+      setAttribute(value);
+      if (value.data && (value.length <= _capacity)) {
+        _cloud_value = value;
+        _cloud_hash = hash(value.data, value.length);
+        _cloud_length = value.length;
+      }
+    }
+};
+
+#endif /* CLOUDBLOB_H_ */
@@ -25,6 +25,7 @@
 #include <math.h>
 #include <Arduino.h>
 #include "../Property.h"
+#include "../../utility/color/ColorConversion.h"
 
 /******************************************************************************
    CLASS DECLARATION
@@ -79,6 +80,10 @@ class Color {
       } else if (imax == 0) {
 
         hue = 60 * fmod((temp[1] - temp[2]) / delta, 6);
+        /* fmod() keeps the sign, reds with more blue than green end up in (-60, 0). */
+        if (hue < 0) {
+          hue += 360;
+        }
       } else if (imax == 1) {
         hue = 60 * (((temp[2] - temp[0]) / delta) + 2);
       } else if (imax == 2) {
@@ -136,6 +141,26 @@ class Color {
       B = lrint((fB + fM) * 255);
     }
 
+    /* Same as setColorRGB() and getRGB() within 1 LSB, with integer arithmetic
+     * apart from the conversion from and to the float members, see
+     * ColorConversion.h.
+     */
+    bool setColorRGBFast(uint8_t R, uint8_t G, uint8_t B) {
+      uint16_t h, s, b;
+      rgbToHsb(R, G, B, h, s, b);
+      hue = h * (60.0f / COLOR_HUE_SECTOR);
+      sat = s * (100.0f / COLOR_UNIT);
+      bri = b * (100.0f / COLOR_UNIT);
+      return true;
+    }
+
+    void getRGBFast(uint8_t& R, uint8_t& G, uint8_t& B) {
+      hsbToRgb(toFixedPoint(hue, COLOR_HUE_SECTOR / 60.0f, COLOR_HUE_MAX),
+               toFixedPoint(sat, COLOR_UNIT / 100.0f, COLOR_UNIT),
+               toFixedPoint(bri, COLOR_UNIT / 100.0f, COLOR_UNIT),
+               R, G, B);
+    }
+
     Color& operator=(Color & aColor) {
       hue = aColor.hue;
       sat = aColor.sat;
@@ -151,6 +176,15 @@ class Color {
       return !(operator==(aColor));
     }
 
+  private:
+    static uint16_t toFixedPoint(float const value, float const scale, uint16_t const max) {
+      if (!(value > 0)) {
+        return 0;
+      }
+      float const scaled = value * scale + 0.5f;
+      return (scaled < max) ? static_cast<uint16_t>(scaled) : max;
+    }
+
 };
 
 class CloudColor : public Property {
@@ -166,6 +200,12 @@ class CloudColor : public Property {
       return _value != _cloud_value;
     }
 
+    virtual uint32_t getChangedAttributes() {
+      return (_value.hue != _cloud_value.hue ? 0x01 : 0) |
+             (_value.sat != _cloud_value.sat ? 0x02 : 0) |
+             (_value.bri != _cloud_value.bri ? 0x04 : 0);
+    }
+
     CloudColor& operator=(Color aColor) {
       _value.hue = aColor.hue;
       _value.sat = aColor.sat;
@@ -23,7 +23,9 @@
  ******************************************************************************/
 
 #include <Arduino.h>
+#include <AIoTC_Config.h>
 #include "../Property.h"
+#include "../../utility/hash/FNV1a.h"
 
 /******************************************************************************
    CLASS DECLARATION
@@ -35,24 +37,56 @@ class CloudString : public Property {
   private:
     String  _value,
             _cloud_value;
+    bool     _is_hashed,
+             _has_cloud_value;
+    uint32_t _cloud_hash;
+    size_t   _cloud_length;
   public:
-    CloudString()                                {
-      CloudString("");
+    CloudString() : CloudString(String("")) {}
+    CloudString(const char *v) : CloudString(String(v)) {}
+    CloudString(String v) : _value(v), _cloud_value(v), _is_hashed(false), _has_cloud_value(true), _cloud_hash(0), _cloud_length(0) {
+#if AIOT_CONFIG_STRING_HASH_CHANGE_DETECTION
+      detectChangesByHash();
+#endif
     }
-    CloudString(const char *v)                   {
-      CloudString(String(v));
+    /* See CloudWrapperString::detectChangesByHash(). */
+    void detectChangesByHash() {
+      if (_is_hashed) {
+        return;
+      }
+      _cloud_hash = fnv1a(_cloud_value.c_str(), _cloud_value.length());
+      _cloud_length = _cloud_value.length();
+      _cloud_value = String();
+      _is_hashed = true;
+      _has_cloud_value = false;
     }
-    CloudString(String v) : _value(v), _cloud_value(v) {}
     operator String() const {
       return _value;
     }
     virtual bool isDifferentFromCloud() {
+      if (_is_hashed) {
+        return (_value.length() != _cloud_length) || (fnv1a(_value.c_str(), _cloud_length) != _cloud_hash);
+      }
       return _value != _cloud_value;
     }
     virtual void fromCloudToLocal() {
+      if (!_has_cloud_value) {
+        return;
+      }
       _value = _cloud_value;
+      if (_is_hashed) {
+        _cloud_value = String();
+        _has_cloud_value = false;
+      }
     }
     virtual void fromLocalToCloud() {
+      if (_is_hashed) {
+        _cloud_hash = fnv1a(_value.c_str(), _value.length());
+        _cloud_length = _value.length();
+        _cloud_value = String();
+        _has_cloud_value = false;
+        return;
+      }
       _cloud_value = _value;
     }
     virtual CborError appendAttributesToCloud() {
@@ -60,6 +94,11 @@ class CloudString : public Property {
     }
     virtual void setAttributesFromCloud() {
       setAttribute(_cloud_value);
+      if (_is_hashed) {
+        _cloud_hash = fnv1a(_cloud_value.c_str(), _cloud_value.length());
+        _cloud_length = _cloud_value.length();
+        _has_cloud_value = true;
+      }
     }
     //modifiers
     CloudString& operator=(String v) {
@@ -0,0 +1,78 @@
+//
+// This file is part of ArduinoCloudThing
+//
+// Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+//
+// This software is released under the GNU General Public License version 3,
+// which covers the main part of ArduinoCloudThing.
+// The terms of this license can be found at:
+// https://www.gnu.org/licenses/gpl-3.0.en.html
+//
+// You can be released from the requirements of the above licenses by purchasing
+// a commercial license. Buying such a license is mandatory if you want to modify or
+// otherwise use the software for commercial activities involving the Arduino
+// software without disclosing the source code of your own applications. To purchase
+// a commercial license, send an email to license@arduino.cc.
+//
+
+#ifndef CLOUDTRACK_H_
+#define CLOUDTRACK_H_
+
+/******************************************************************************
+   INCLUDE
+ ******************************************************************************/
+
+#include <Arduino.h>
+#include <AIoTC_Config.h>
+#include "../Property.h"
+#include "CloudLocation.h"
+#include "../../utility/track/Polyline.h"
+
+/******************************************************************************
+   CLASS DECLARATION
+ ******************************************************************************/
+
+/* CloudTrack collects the locations assigned to it and publishes the path
+ * travelled since the last update as a simplified, encoded polyline (see
+ * Polyline), which starts with the last point sent before. It is meant to be
+ * published periodically, i.e. with publishEvery() or with a minimum time
+ * between updates, a change is pending as soon as a location has been added.
+ */
+class CloudTrack : public Property {
+  private:
+    StaticPolyline<AIOT_CONFIG_TRACK_MAX_POINTS> _track;
+  public:
+    CloudTrack(float const tolerance_m = 5.0f) {
+      _track.setTolerance(tolerance_m);
+    }
+
+    CloudTrack& operator=(Location aLocation) {
+      if (_track.add(aLocation.lat, aLocation.lon)) {
+        updateLocalTimestamp();
+      }
+      return *this;
+    }
+
+    Polyline const & getValue() const {
+      return _track;
+    }
+
+    virtual bool isDifferentFromCloud() {
+      return _track.size() > 1;
+    }
+    virtual void fromCloudToLocal() {
+    }
+    virtual void fromLocalToCloud() {
+      _track.restart();
+    }
+    virtual CborError appendAttributesToCloud() {
+      _track.simplify();
+      String polyline;
+      _track.encode(polyline);
+      return appendAttribute(polyline);
+    }
+    virtual void setAttributesFromCloud() {
+    }
+};
+
+#endif /* CLOUDTRACK_H_ */
@@ -26,6 +26,7 @@
 
 #include <Arduino.h>
 #include "CloudWrapperBase.h"
+#include "../FloatRegistry.h"
 
 /******************************************************************************
    CLASS DECLARATION
@@ -36,22 +37,51 @@ class CloudWrapperFloat : public CloudWrapperBase {
     float  &_primitive_value,
            _cloud_value,
            _local_value;
+    FloatRegistry * _registry;
+    int    _registry_idx;
+
+    inline float & cloudValue() {
+      return _registry ? _registry->cloudValue(_registry_idx) : _cloud_value;
+    }
   public:
-    CloudWrapperFloat(float& v) : _primitive_value(v), _cloud_value(v), _local_value(v) {}
+    CloudWrapperFloat(float& v) : _primitive_value(v), _cloud_value(v), _local_value(v), _registry(nullptr), _registry_idx(-1) {}
+    /* Moves the cloud value into 'registry', isDifferentFromCloud() then reports
+     * the result of the last FloatRegistry::scan(). Returns false if the
+     * registry is full, the wrapper keeps on comparing its values itself.
+     */
+    bool attach(FloatRegistry & registry) {
+      int const idx = registry.add(_primitive_value, _cloud_value);
+      if (idx < 0) {
+        return false;
+      }
+      _registry = &registry;
+      _registry_idx = idx;
+      return true;
+    }
     virtual bool isDifferentFromCloud() {
+      if (_registry) {
+        return _registry->isChanged(_registry_idx);
+      }
       return _primitive_value != _cloud_value && (abs(_primitive_value - _cloud_value) >= Property::_min_delta_property);
     }
     virtual void fromCloudToLocal() {
-      _primitive_value = _cloud_value;
+      _primitive_value = cloudValue();
+      if (_registry) {
+        _registry->clearChanged(_registry_idx);
+      }
     }
     virtual void fromLocalToCloud() {
-      _cloud_value = _primitive_value;
+      cloudValue() = _primitive_value;
+      if (_registry) {
+        _registry->clearChanged(_registry_idx);
+        _registry->setMinDelta(_registry_idx, Property::_min_delta_property);
+      }
     }
     virtual CborError appendAttributesToCloud() {
       return appendAttribute(_primitive_value);
     }
     virtual void setAttributesFromCloud() {
-      setAttribute(_cloud_value);
+      setAttribute(cloudValue());
     }
     virtual bool isPrimitive() {
       return true;
@@ -23,7 +23,9 @@
  ******************************************************************************/
 
 #include <Arduino.h>
+#include <AIoTC_Config.h>
 #include "CloudWrapperBase.h"
+#include "../../utility/hash/FNV1a.h"
 
 /******************************************************************************
    CLASS DECLARATION
@@ -34,19 +36,72 @@ class CloudWrapperString : public CloudWrapperBase {
     String  &_primitive_value,
             _cloud_value,
             _local_value;
+    bool     _is_hashed,
+             _has_cloud_value;
+    uint32_t _cloud_hash,
+             _local_hash;
+    size_t   _cloud_length,
+             _local_length;
+
+    static inline bool isEqual(String const & v, uint32_t const hash, size_t const length) {
+      return (v.length() == length) && (fnv1a(v.c_str(), length) == hash);
+    }
   public:
     CloudWrapperString(String& v) :
       _primitive_value(v),
       _cloud_value(v),
-      _local_value(v) {
+      _local_value(v),
+      _is_hashed(false),
+      _has_cloud_value(true),
+      _cloud_hash(0),
+      _local_hash(0),
+      _cloud_length(0),
+      _local_length(0) {
+#if AIOT_CONFIG_STRING_HASH_CHANGE_DETECTION
+      detectChangesByHash();
+#endif
+    }
+    /* Replaces the copies of the cloud and the local value by their length and
+     * 32 bit hash. A value received from the cloud is only kept until it has
+     * been applied by fromCloudToLocal() or overwritten by fromLocalToCloud().
+     */
+    void detectChangesByHash() {
+      if (_is_hashed) {
+        return;
+      }
+      _cloud_hash = fnv1a(_cloud_value.c_str(), _cloud_value.length());
+      _cloud_length = _cloud_value.length();
+      _local_hash = fnv1a(_local_value.c_str(), _local_value.length());
+      _local_length = _local_value.length();
+      _cloud_value = String();
+      _local_value = String();
+      _is_hashed = true;
+      _has_cloud_value = false;
     }
     virtual bool isDifferentFromCloud() {
+      if (_is_hashed) {
+        return !isEqual(_primitive_value, _cloud_hash, _cloud_length);
+      }
       return _primitive_value != _cloud_value;
     }
     virtual void fromCloudToLocal() {
+      if (!_has_cloud_value) {
+        return;
+      }
       _primitive_value = _cloud_value;
+      if (_is_hashed) {
+        _cloud_value = String();
+        _has_cloud_value = false;
+      }
     }
     virtual void fromLocalToCloud() {
+      if (_is_hashed) {
+        _cloud_hash = fnv1a(_primitive_value.c_str(), _primitive_value.length());
+        _cloud_length = _primitive_value.length();
+        _cloud_value = String();
+        _has_cloud_value = false;
+        return;
+      }
       _cloud_value = _primitive_value;
     }
     virtual CborError appendAttributesToCloud() {
@@ -54,11 +109,19 @@ class CloudWrapperString : public CloudWrapperBase {
     }
     virtual void setAttributesFromCloud() {
       setAttribute(_cloud_value);
+      if (_is_hashed) {
+        _cloud_hash = fnv1a(_cloud_value.c_str(), _cloud_value.length());
+        _cloud_length = _cloud_value.length();
+        _has_cloud_value = true;
+      }
     }
     virtual bool isPrimitive() {
       return true;
     }
     virtual bool isChangedLocally() {
+      if (_is_hashed) {
+        return !isEqual(_primitive_value, _local_hash, _local_length);
+      }
       return _primitive_value != _local_value;
     }
 };
@@ -59,6 +59,13 @@ class CloudColoredLight : public CloudColor {
       return _value != _cloud_value;
     }
 
+    virtual uint32_t getChangedAttributes() {
+      return (_value.swi != _cloud_value.swi ? 0x01 : 0) |
+             (_value.hue != _cloud_value.hue ? 0x02 : 0) |
+             (_value.sat != _cloud_value.sat ? 0x04 : 0) |
+             (_value.bri != _cloud_value.bri ? 0x08 : 0);
+    }
+
     CloudColoredLight& operator=(ColoredLight aLight) {
       _value.swi = aLight.swi;
       _value.hue = aLight.hue;
@@ -60,6 +60,14 @@ class CloudDimmedLight : public Property {
       return _value != _cloud_value;
     }
 
+    /* The constant hue and saturation (attributes 2 and 3) are only sent along
+     * with a complete update.
+     */
+    virtual uint32_t getChangedAttributes() {
+      return (_value.swi != _cloud_value.swi ? 0x01 : 0) |
+             (_value.bri != _cloud_value.bri ? 0x08 : 0);
+    }
+
     CloudDimmedLight& operator=(DimmedLight aLight) {
       _value.swi = aLight.swi;
       _value.bri = aLight.bri;
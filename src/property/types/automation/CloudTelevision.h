@@ -149,6 +149,15 @@ class CloudTelevision : public Property {
       return _value != _cloud_value;
     }
 
+    virtual uint32_t getChangedAttributes() {
+      return (_value.swi != _cloud_value.swi ? 0x01 : 0) |
+             (_value.vol != _cloud_value.vol ? 0x02 : 0) |
+             (_value.mut != _cloud_value.mut ? 0x04 : 0) |
+             (_value.pbc != _cloud_value.pbc ? 0x08 : 0) |
+             (_value.inp != _cloud_value.inp ? 0x10 : 0) |
+             (_value.cha != _cloud_value.cha ? 0x20 : 0);
+    }
+
     CloudTelevision& operator=(Television const aTV) {
       _value.swi = aTV.swi;
       _value.vol = aTV.vol;
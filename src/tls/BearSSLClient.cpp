@@ -31,6 +31,7 @@
 
 #include "BearSSLTrustAnchors.h"
 #include "utility/eccX08_asn1.h"
+#include "../utility/trace/Trace.h"
 
 #include "BearSSLClient.h"
 
@@ -258,6 +259,8 @@ int BearSSLClient::errorCode()
 
 int BearSSLClient::connectSSL(const char* host)
 {
+  AIOT_TRACE(TlsHandshakeBegin, 0, 0);
+
   // initialize client context with all necessary algorithms and hardcoded trust anchors.
   aiotc_client_profile_init(&_sc, &_xc, _TAs, _numTAs);
 
@@ -266,7 +269,10 @@ int BearSSLClient::connectSSL(const char* host)
   // inject entropy in engine
   unsigned char entropy[32];
 
-  if (ECCX08.begin() && ECCX08.locked() && ECCX08.random(entropy, sizeof(entropy))) {
+  bool const is_eccx08_entropy = ECCX08.begin() && ECCX08.locked() && ECCX08.random(entropy, sizeof(entropy));
+  AIOT_TRACE(TlsEntropy, is_eccx08_entropy, 0);
+
+  if (is_eccx08_entropy) {
     // ECC508 random success, add custom ECDSA vfry and EC sign
     br_ssl_engine_set_ecdsa(&_sc.eng, eccX08_vrfy_asn1);
     br_x509_minimal_set_ecdsa(&_xc, br_ssl_engine_get_ec(&_sc.eng), br_ssl_engine_get_ecdsa(&_sc.eng));
@@ -285,6 +291,7 @@ int BearSSLClient::connectSSL(const char* host)
 
   // set the hostname used for SNI
   br_ssl_client_reset(&_sc, host, 0);
+  AIOT_TRACE(TlsClientReset, 0, 0);
 
   // get the current time and set it for X.509 validation
   uint32_t now = _get_time_func();
@@ -304,10 +311,13 @@ int BearSSLClient::connectSSL(const char* host)
     if (state & BR_SSL_SENDAPP) {
       break;
     } else if (state & BR_SSL_CLOSED) {
+      AIOT_TRACE(TlsHandshakeEnd, 0, br_ssl_engine_last_error(&_sc.eng));
       return 0;
     }
   }
 
+  AIOT_TRACE(TlsHandshakeEnd, 1, 0);
+
   return 1;
 }
 
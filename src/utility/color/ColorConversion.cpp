@@ -0,0 +1,201 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "ColorConversion.h"
+
+#ifdef __AVR__
+#  include <avr/pgmspace.h>
+#endif
+
+/**************************************************************************************
+ * CONSTANTS
+ **************************************************************************************/
+
+/* RECIPROCAL[d] = round(2^23 / d), replaces the divisions by the maximum and
+ * the span of the RGB components. AVR keeps the table in flash instead of
+ * spending 1 kB of RAM on it.
+ */
+#ifdef __AVR__
+static uint32_t const RECIPROCAL[256] PROGMEM =
+#else
+static uint32_t const RECIPROCAL[256] =
+#endif
+{
+  0x000000, 0x800000, 0x400000, 0x2AAAAB, 0x200000, 0x19999A, 0x155555, 0x124925,
+  0x100000, 0x0E38E4, 0x0CCCCD, 0x0BA2E9, 0x0AAAAB, 0x09D89E, 0x092492, 0x088889,
+  0x080000, 0x078788, 0x071C72, 0x06BCA2, 0x066666, 0x061862, 0x05D174, 0x0590B2,
+  0x055555, 0x051EB8, 0x04EC4F, 0x04BDA1, 0x049249, 0x0469EE, 0x044444, 0x042108,
+  0x040000, 0x03E0F8, 0x03C3C4, 0x03A83B, 0x038E39, 0x03759F, 0x035E51, 0x034835,
+  0x033333, 0x031F38, 0x030C31, 0x02FA0C, 0x02E8BA, 0x02D82E, 0x02C859, 0x02B931,
+  0x02AAAB, 0x029CBC, 0x028F5C, 0x028283, 0x027627, 0x026A44, 0x025ED1, 0x0253C8,
+  0x024925, 0x023EE1, 0x0234F7, 0x022B64, 0x022222, 0x02192E, 0x021084, 0x020821,
+  0x020000, 0x01F820, 0x01F07C, 0x01E913, 0x01E1E2, 0x01DAE6, 0x01D41D, 0x01CD85,
+  0x01C71C, 0x01C0E0, 0x01BAD0, 0x01B4E8, 0x01AF28, 0x01A98F, 0x01A41A, 0x019EC9,
+  0x01999A, 0x01948B, 0x018F9C, 0x018ACC, 0x018618, 0x018182, 0x017D06, 0x0178A5,
+  0x01745D, 0x01702E, 0x016C17, 0x016817, 0x01642D, 0x016058, 0x015C99, 0x0158ED,
+  0x015555, 0x0151D0, 0x014E5E, 0x014AFD, 0x0147AE, 0x014470, 0x014141, 0x013E23,
+  0x013B14, 0x013814, 0x013522, 0x01323E, 0x012F68, 0x012CA0, 0x0129E4, 0x012735,
+  0x012492, 0x0121FB, 0x011F70, 0x011CF0, 0x011A7C, 0x011812, 0x0115B2, 0x01135D,
+  0x011111, 0x010ECF, 0x010C97, 0x010A68, 0x010842, 0x010625, 0x010410, 0x010204,
+  0x010000, 0x00FE04, 0x00FC10, 0x00FA23, 0x00F83E, 0x00F660, 0x00F48A, 0x00F2BA,
+  0x00F0F1, 0x00EF2F, 0x00ED73, 0x00EBBE, 0x00EA0F, 0x00E866, 0x00E6C3, 0x00E526,
+  0x00E38E, 0x00E1FC, 0x00E070, 0x00DEE9, 0x00DD68, 0x00DBEB, 0x00DA74, 0x00D902,
+  0x00D794, 0x00D62C, 0x00D4C7, 0x00D368, 0x00D20D, 0x00D0B7, 0x00CF64, 0x00CE17,
+  0x00CCCD, 0x00CB87, 0x00CA46, 0x00C908, 0x00C7CE, 0x00C698, 0x00C566, 0x00C437,
+  0x00C30C, 0x00C1E5, 0x00C0C1, 0x00BFA0, 0x00BE83, 0x00BD69, 0x00BC52, 0x00BB3F,
+  0x00BA2F, 0x00B921, 0x00B817, 0x00B710, 0x00B60B, 0x00B50A, 0x00B40B, 0x00B30F,
+  0x00B216, 0x00B120, 0x00B02C, 0x00AF3B, 0x00AE4C, 0x00AD60, 0x00AC77, 0x00AB8F,
+  0x00AAAB, 0x00A9C8, 0x00A8E8, 0x00A80B, 0x00A72F, 0x00A656, 0x00A57F, 0x00A4AA,
+  0x00A3D7, 0x00A306, 0x00A238, 0x00A16B, 0x00A0A1, 0x009FD8, 0x009F11, 0x009E4D,
+  0x009D8A, 0x009CC9, 0x009C0A, 0x009B4C, 0x009A91, 0x0099D7, 0x00991F, 0x009869,
+  0x0097B4, 0x009701, 0x009650, 0x0095A0, 0x0094F2, 0x009446, 0x00939B, 0x0092F1,
+  0x009249, 0x0091A3, 0x0090FE, 0x00905A, 0x008FB8, 0x008F17, 0x008E78, 0x008DDA,
+  0x008D3E, 0x008CA3, 0x008C09, 0x008B70, 0x008AD9, 0x008A43, 0x0089AE, 0x00891B,
+  0x008889, 0x0087F8, 0x008768, 0x0086D9, 0x00864C, 0x0085BF, 0x008534, 0x0084AA,
+  0x008421, 0x008399, 0x008312, 0x00828D, 0x008208, 0x008185, 0x008102, 0x008081
+};
+
+/**************************************************************************************
+ * INTERNAL FUNCTIONS
+ **************************************************************************************/
+
+static inline uint32_t reciprocal(uint8_t const d)
+{
+#ifdef __AVR__
+  return pgm_read_dword(&RECIPROCAL[d]);
+#else
+  return RECIPROCAL[d];
+#endif
+}
+
+/* Component 'n' (5: red, 3: green, 1: blue) is bri - chroma * max(0, min(k, 4 - k, 1))
+ * with k = (n + hue / 60) mod 6, which has no branch depending on the sector
+ * of the hue. All operands fit into 16 bit and the products are widening
+ * multiplications of 16 bit values, which SSE2 and NEON provide as well.
+ */
+static inline uint8_t hsbComponent(uint16_t const n, uint16_t const hue, uint16_t const bri, uint16_t const chroma)
+{
+  uint16_t k = n * COLOR_HUE_SECTOR + hue;
+  k = (k >= COLOR_HUE_MAX) ? (k - COLOR_HUE_MAX) : k;
+  int16_t t = 4 * COLOR_HUE_SECTOR - k;
+  t = (static_cast<int16_t>(k) < t) ? static_cast<int16_t>(k) : t;
+  t = (t < static_cast<int16_t>(COLOR_HUE_SECTOR)) ? t : static_cast<int16_t>(COLOR_HUE_SECTOR);
+  t = (t > 0) ? t : 0;
+  uint16_t const value = bri - static_cast<uint16_t>((static_cast<uint32_t>(chroma) * static_cast<uint16_t>(t) + (COLOR_HUE_SECTOR / 2)) >> 12);
+  return static_cast<uint8_t>((static_cast<uint32_t>(value) * 255 + (COLOR_UNIT / 2)) >> 15);
+}
+
+static inline void hsbToRgbInline(uint16_t hue, uint16_t sat, uint16_t bri, uint8_t & r, uint8_t & g, uint8_t & b)
+{
+  /* A hue of at most 65535 needs two subtractions at most. */
+  hue = (hue >= COLOR_HUE_MAX) ? (hue - COLOR_HUE_MAX) : hue;
+  hue = (hue >= COLOR_HUE_MAX) ? (hue - COLOR_HUE_MAX) : hue;
+  sat = (sat < COLOR_UNIT) ? sat : COLOR_UNIT;
+  bri = (bri < COLOR_UNIT) ? bri : COLOR_UNIT;
+
+  uint16_t const chroma = static_cast<uint16_t>((static_cast<uint32_t>(bri) * sat + (COLOR_UNIT / 2)) >> 15);
+  r = hsbComponent(5, hue, bri, chroma);
+  g = hsbComponent(3, hue, bri, chroma);
+  b = hsbComponent(1, hue, bri, chroma);
+}
+
+static inline void rgbToHsbInline(uint8_t const r, uint8_t const g, uint8_t const b, uint16_t & hue, uint16_t & sat, uint16_t & bri)
+{
+  /* Ties are resolved like in Color::setColorRGB(), the last maximum wins. */
+  uint8_t max = r, min = r;
+  uint8_t imax = 0;
+  if (g >= max) { max = g; imax = 1; }
+  if (b >= max) { max = b; imax = 2; }
+  if (g < min) { min = g; }
+  if (b < min) { min = b; }
+
+  uint8_t const delta = max - min;
+  bri = static_cast<uint16_t>((max * reciprocal(255) + 128) >> 8);
+  sat = static_cast<uint16_t>((delta * reciprocal(max) + 128) >> 8);
+
+  if (delta == 0) {
+    hue = 0;
+    return;
+  }
+
+  int32_t diff;
+  uint32_t base;
+  if (imax == 0) {
+    diff = static_cast<int32_t>(g) - b;
+    base = 0;
+  } else if (imax == 1) {
+    diff = static_cast<int32_t>(b) - r;
+    base = 2 * COLOR_HUE_SECTOR;
+  } else {
+    diff = static_cast<int32_t>(r) - g;
+    base = 4 * COLOR_HUE_SECTOR;
+  }
+
+  uint32_t const frac = ((diff < 0 ? -diff : diff) * reciprocal(delta) + 1024) >> 11;
+  uint32_t h = (diff < 0) ? (base + COLOR_HUE_MAX - frac) : (base + frac);
+  h = (h >= COLOR_HUE_MAX) ? (h - COLOR_HUE_MAX) : h;
+  hue = static_cast<uint16_t>(h);
+}
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+void hsbToRgb(uint16_t const hue, uint16_t const sat, uint16_t const bri, uint8_t & r, uint8_t & g, uint8_t & b)
+{
+  hsbToRgbInline(hue, sat, bri, r, g, b);
+}
+
+void rgbToHsb(uint8_t const r, uint8_t const g, uint8_t const b, uint16_t & hue, uint16_t & sat, uint16_t & bri)
+{
+  rgbToHsbInline(r, g, b, hue, sat, bri);
+}
+
+/* The colours are converted in blocks into planar buffers, which -O2 is able
+ * to vectorise with SSE2 already, the interleaving stores are not.
+ */
+__attribute__((optimize("tree-vectorize")))
+void hsbToRgb(uint16_t const * hue, uint16_t const * sat, uint16_t const * bri, uint8_t * rgb, size_t const cnt)
+{
+  static size_t const BLOCK_SIZE = 32;
+  uint8_t r[BLOCK_SIZE], g[BLOCK_SIZE], b[BLOCK_SIZE];
+
+  for (size_t offset = 0; offset < cnt; offset += BLOCK_SIZE)
+  {
+    size_t const block_cnt = ((cnt - offset) < BLOCK_SIZE) ? (cnt - offset) : BLOCK_SIZE;
+
+    for (size_t i = 0; i < block_cnt; i++)
+      hsbToRgbInline(hue[offset + i], sat[offset + i], bri[offset + i], r[i], g[i], b[i]);
+
+    for (size_t i = 0; i < block_cnt; i++)
+    {
+      rgb[3 * (offset + i)]     = r[i];
+      rgb[3 * (offset + i) + 1] = g[i];
+      rgb[3 * (offset + i) + 2] = b[i];
+    }
+  }
+}
+
+void rgbToHsb(uint8_t const * rgb, uint16_t * hue, uint16_t * sat, uint16_t * bri, size_t const cnt)
+{
+  for (size_t i = 0; i < cnt; i++)
+    rgbToHsbInline(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2], hue[i], sat[i], bri[i]);
+}
@@ -0,0 +1,58 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_COLOR_CONVERSION_H_
+#define ARDUINO_IOT_CLOUD_COLOR_CONVERSION_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**************************************************************************************
+ * CONSTANTS
+ **************************************************************************************/
+
+/* Fixed point representation of HSB colours: the hue is counted in 1/4096 of a
+ * 60 degree sector, i.e. 0 ... 24576 for 0 ... 360 degree, saturation and
+ * brightness in 1/32768, i.e. 0 ... 32768 for 0 ... 100 %.
+ */
+static uint16_t const COLOR_HUE_SECTOR = 4096;
+static uint16_t const COLOR_HUE_MAX    = 6 * COLOR_HUE_SECTOR;
+static uint16_t const COLOR_UNIT       = 32768;
+
+/**************************************************************************************
+ * FUNCTION DECLARATION
+ **************************************************************************************/
+
+/* Integer only counterparts of Color::getRGB() and Color::setColorRGB(), their
+ * results are within 1 LSB of the floating point conversion. Out of range
+ * saturation and brightness values are clamped, a hue of COLOR_HUE_MAX or more
+ * wraps around.
+ */
+void hsbToRgb(uint16_t const hue, uint16_t const sat, uint16_t const bri, uint8_t & r, uint8_t & g, uint8_t & b);
+void rgbToHsb(uint8_t const r, uint8_t const g, uint8_t const b, uint16_t & hue, uint16_t & sat, uint16_t & bri);
+
+/* Convert 'cnt' colours at once, e.g. a whole LED strip. The RGB values are
+ * interleaved, 3 bytes per colour.
+ */
+void hsbToRgb(uint16_t const * hue, uint16_t const * sat, uint16_t const * bri, uint8_t * rgb, size_t const cnt);
+void rgbToHsb(uint8_t const * rgb, uint16_t * hue, uint16_t * sat, uint16_t * bri, size_t const cnt);
+
+#endif /* ARDUINO_IOT_CLOUD_COLOR_CONVERSION_H_ */
@@ -0,0 +1,44 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_FNV1A_H_
+#define ARDUINO_IOT_CLOUD_FNV1A_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+/* 32 bit FNV-1a hash, see http://www.isthe.com/chongo/tech/comp/fnv/ */
+inline uint32_t fnv1a(char const * data, size_t const length)
+{
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < length; i++)
+  {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+#endif /* ARDUINO_IOT_CLOUD_FNV1A_H_ */
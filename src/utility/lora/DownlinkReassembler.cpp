@@ -0,0 +1,118 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <AIoTC_Config.h>
+#if AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE > 0
+
+#include "DownlinkReassembler.h"
+
+#include <string.h>
+
+/**************************************************************************************
+ * CONSTANTS
+ **************************************************************************************/
+
+uint8_t const DownlinkReassembler::HEADER_MARKER;
+size_t  const DownlinkReassembler::HEADER_SIZE;
+size_t  const DownlinkReassembler::MAX_FRAGMENT_CNT;
+size_t  const DownlinkReassembler::BUFFER_SIZE;
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+DownlinkReassembler::DownlinkReassembler()
+: _length{0}
+, _message_id{0}
+, _next_index{0}
+, _discarded_cnt{0}
+{
+
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+bool DownlinkReassembler::isFragment(uint8_t const * data, size_t const length)
+{
+  return (length >= HEADER_SIZE) && (data[0] == HEADER_MARKER);
+}
+
+DownlinkReassembler::Result DownlinkReassembler::push(uint8_t const * data, size_t const length)
+{
+  if (!isFragment(data, length))
+    return Result::NotFragmented;
+
+  uint8_t const message_id = data[1] >> 5;
+  bool    const is_last    = (data[1] & 0x10) != 0;
+  uint8_t const index      = data[1] & 0x0F;
+
+  /* A new message starts, an incomplete one has been abandoned by the cloud. */
+  if (index == 0)
+  {
+    if (isPending())
+      _discarded_cnt++;
+    reset();
+  }
+
+  if ((index != _next_index) || (isPending() && (message_id != _message_id)))
+    return discard();
+
+  size_t const payload_length = length - HEADER_SIZE;
+  if ((_length + payload_length) > BUFFER_SIZE)
+    return discard();
+
+  memcpy(_buf + _length, data + HEADER_SIZE, payload_length);
+  _length += payload_length;
+  _message_id = message_id;
+
+  if (is_last)
+  {
+    _next_index = 0;
+    return Result::Complete;
+  }
+
+  _next_index++;
+  if (_next_index == MAX_FRAGMENT_CNT)
+    return discard();
+
+  return Result::Incomplete;
+}
+
+void DownlinkReassembler::reset()
+{
+  _length = 0;
+  _next_index = 0;
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+DownlinkReassembler::Result DownlinkReassembler::discard()
+{
+  _discarded_cnt++;
+  reset();
+  return Result::Discarded;
+}
+
+#endif /* AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE > 0 */
@@ -0,0 +1,92 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_DOWNLINK_REASSEMBLER_H_
+#define ARDUINO_IOT_CLOUD_DOWNLINK_REASSEMBLER_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <AIoTC_Config.h>
+#if AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE > 0
+
+#include <Arduino.h>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* DownlinkReassembler joins a CBOR message which has been split by the cloud
+ * across several downlinks. Every fragment starts with a two byte header:
+ *
+ *   0xFD | message id (3 bits) last fragment (1 bit) fragment index (4 bits)
+ *
+ * 0xFD is a reserved initial byte in CBOR, hence a downlink which is not
+ * fragmented is passed on unchanged. The fragments of a message must arrive
+ * in order, starting with index 0. A missing or foreign fragment discards the
+ * message received so far, the first fragment of a message discards any
+ * incomplete one.
+ */
+class DownlinkReassembler
+{
+
+public:
+
+  static uint8_t const HEADER_MARKER     = 0xFD;
+  static size_t  const HEADER_SIZE       = 2;
+  static size_t  const MAX_FRAGMENT_CNT  = 16;
+  static size_t  const BUFFER_SIZE       = AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE;
+
+  enum class Result
+  {
+    NotFragmented,
+    Incomplete,
+    Complete,
+    Discarded,
+  };
+
+  DownlinkReassembler();
+
+
+  static bool isFragment(uint8_t const * data, size_t const length);
+
+  /* After Result::Complete the message is available via data() and length()
+   * until the next call of push() or reset().
+   */
+  Result          push           (uint8_t const * data, size_t const length);
+  void            reset          ();
+
+  inline uint8_t const * data    () const { return _buf; }
+  inline size_t   length         () const { return _length; }
+  inline bool     isPending      () const { return _next_index > 0; }
+  inline unsigned long getDiscardedCount() const { return _discarded_cnt; }
+
+private:
+
+  uint8_t       _buf[BUFFER_SIZE];
+  size_t        _length;
+  uint8_t       _message_id;
+  uint8_t       _next_index;
+  unsigned long _discarded_cnt;
+
+  Result discard();
+};
+
+#endif /* AIOT_CONFIG_LPWAN_REASSEMBLY_BUFFER_SIZE > 0 */
+
+#endif /* ARDUINO_IOT_CLOUD_DOWNLINK_REASSEMBLER_H_ */
@@ -0,0 +1,147 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <AIoTC_Config.h>
+
+#include "DutyCycleScheduler.h"
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+DutyCycleScheduler::DutyCycleScheduler()
+: _sub_band_cnt{0}
+{
+  uint16_t const duty_cycle_permille = AIOT_CONFIG_LPWAN_DUTY_CYCLE_PERMILLE;
+  setSubBands(&duty_cycle_permille, 1);
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+bool DutyCycleScheduler::setSubBands(uint16_t const * duty_cycle_permille, size_t const sub_band_cnt)
+{
+  if ((sub_band_cnt == 0) || (sub_band_cnt > MAX_SUB_BAND_CNT))
+    return false;
+
+  for (size_t i = 0; i < sub_band_cnt; i++)
+    if ((duty_cycle_permille[i] == 0) || (duty_cycle_permille[i] > 1000))
+      return false;
+
+  for (size_t i = 0; i < sub_band_cnt; i++)
+    _sub_band[i].duty_cycle_permille = duty_cycle_permille[i];
+  _sub_band_cnt = sub_band_cnt;
+
+  reset();
+  return true;
+}
+
+void DutyCycleScheduler::reset()
+{
+  for (size_t i = 0; i < _sub_band_cnt; i++)
+  {
+    _sub_band[i].tx_tick = 0;
+    _sub_band[i].off_time_ms = 0;
+    _sub_band[i].consumed_airtime_us = 0;
+  }
+}
+
+bool DutyCycleScheduler::isAvailable() const
+{
+  return (getWaitTime() == 0);
+}
+
+unsigned long DutyCycleScheduler::getWaitTime() const
+{
+  unsigned long wait_time_ms = getWaitTime(_sub_band[0]);
+  for (size_t i = 1; i < _sub_band_cnt; i++)
+  {
+    unsigned long const sub_band_wait_time_ms = getWaitTime(_sub_band[i]);
+    if (sub_band_wait_time_ms < wait_time_ms)
+      wait_time_ms = sub_band_wait_time_ms;
+  }
+  return wait_time_ms;
+}
+
+void DutyCycleScheduler::onTransmit(unsigned long const airtime_us)
+{
+  /* Among the available sub-bands the one with the oldest transmission is used. */
+  SubBand * sub_band = &_sub_band[0];
+  for (size_t i = 1; i < _sub_band_cnt; i++)
+  {
+    unsigned long const wait_time_ms = getWaitTime(_sub_band[i]);
+    bool const is_available_earlier = (wait_time_ms < getWaitTime(*sub_band));
+    bool const is_idle_longer = (wait_time_ms == getWaitTime(*sub_band)) && ((millis() - _sub_band[i].tx_tick) > (millis() - sub_band->tx_tick));
+    if (is_available_earlier || is_idle_longer)
+      sub_band = &_sub_band[i];
+  }
+
+  sub_band->tx_tick = millis();
+  sub_band->consumed_airtime_us += airtime_us;
+
+  if (sub_band->duty_cycle_permille >= 1000)
+    return;
+
+  uint64_t const airtime_off_us = static_cast<uint64_t>(airtime_us) * (1000 - sub_band->duty_cycle_permille) / sub_band->duty_cycle_permille;
+  sub_band->off_time_ms = static_cast<unsigned long>((airtime_us + airtime_off_us + 999) / 1000);
+}
+
+size_t DutyCycleScheduler::getSubBandCount() const
+{
+  return _sub_band_cnt;
+}
+
+unsigned long DutyCycleScheduler::getConsumedAirtime(size_t const sub_band) const
+{
+  return (sub_band < _sub_band_cnt) ? _sub_band[sub_band].consumed_airtime_us : 0;
+}
+
+unsigned long DutyCycleScheduler::computeAirtime(size_t const payload_size, uint8_t const spreading_factor)
+{
+  static unsigned long const BANDWIDTH_Hz = 125000;
+  static long const CODING_RATE = 1; /* 4/5 */
+  static long const PREAMBLE_SYMBOL_CNT = 8;
+
+  long const sf = (spreading_factor < 7) ? 7 : ((spreading_factor > 12) ? 12 : spreading_factor);
+  long const pl = static_cast<long>(payload_size + LORAWAN_OVERHEAD);
+  /* Low data rate optimization is mandatory for SF11 and SF12 at 125 kHz. */
+  long const de = (sf >= 11) ? 1 : 0;
+
+  long const numerator = 8 * pl - 4 * sf + 28 + 16;
+  long const denominator = 4 * (sf - 2 * de);
+  long const payload_symbol_cnt = 8 + ((numerator > 0) ? ((numerator + denominator - 1) / denominator) * (CODING_RATE + 4) : 0);
+
+  /* T = (preamble + 4.25 + payload symbols) * 2^SF / BW, in quarter symbols to stay integer. */
+  unsigned long const quarter_symbol_cnt = static_cast<unsigned long>(4 * (PREAMBLE_SYMBOL_CNT + payload_symbol_cnt) + 17);
+  return static_cast<unsigned long>((static_cast<uint64_t>(quarter_symbol_cnt) * (1UL << sf) * 1000000UL) / (4 * BANDWIDTH_Hz));
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+unsigned long DutyCycleScheduler::getWaitTime(SubBand const & sub_band) const
+{
+  unsigned long const elapsed_ms = millis() - sub_band.tx_tick;
+  return (elapsed_ms >= sub_band.off_time_ms) ? 0 : (sub_band.off_time_ms - elapsed_ms);
+}
@@ -0,0 +1,85 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+
+#ifndef ARDUINO_IOT_CLOUD_DUTY_CYCLE_SCHEDULER_H_
+#define ARDUINO_IOT_CLOUD_DUTY_CYCLE_SCHEDULER_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino.h>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* DutyCycleScheduler keeps track of the airtime consumed in the sub-bands of a
+ * LoRa region. After a transmission of airtime T a sub-band with a duty cycle
+ * of d is blocked for T * (1 / d - 1), as done by the LoRaWAN stacks. Since the
+ * channel of an uplink is chosen by the network stack, the airtime is accounted
+ * to the sub-band which has been available the longest, i.e. the one the stack
+ * would pick. A sub-band with a duty cycle of 1000 per mille, the default,
+ * is never blocked, i.e. for regions without a duty cycle rule like US915.
+ */
+class DutyCycleScheduler
+{
+
+public:
+
+  static size_t const MAX_SUB_BAND_CNT = 4;
+  /* MAC header, frame header, port and MIC of an uplink without MAC commands. */
+  static size_t const LORAWAN_OVERHEAD = 13;
+
+  DutyCycleScheduler();
+
+
+  /* The duty cycle of every sub-band is given in per mille, i.e. 10 for 1 %. */
+  bool          setSubBands         (uint16_t const * duty_cycle_permille, size_t const sub_band_cnt);
+  void          reset               ();
+
+  bool          isAvailable         () const;
+  unsigned long getWaitTime         () const;
+  void          onTransmit          (unsigned long const airtime_us);
+
+  size_t        getSubBandCount     () const;
+  unsigned long getConsumedAirtime  (size_t const sub_band) const;
+
+  /* Time on air in us of an uplink with the given application payload at
+   * 125 kHz bandwidth, coding rate 4/5, 8 symbols preamble, explicit header
+   * and CRC (Semtech AN1200.13).
+   */
+  static unsigned long computeAirtime(size_t const payload_size, uint8_t const spreading_factor);
+
+private:
+
+  struct SubBand
+  {
+    uint16_t      duty_cycle_permille;
+    unsigned long tx_tick;
+    unsigned long off_time_ms;
+    unsigned long consumed_airtime_us;
+  };
+
+  SubBand _sub_band[MAX_SUB_BAND_CNT];
+  size_t  _sub_band_cnt;
+
+  unsigned long getWaitTime(SubBand const & sub_band) const;
+};
+
+#endif /* ARDUINO_IOT_CLOUD_DUTY_CYCLE_SCHEDULER_H_ */
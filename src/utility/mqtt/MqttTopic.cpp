@@ -0,0 +1,83 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "MqttTopic.h"
+
+#include <string.h>
+
+#include "../hash/FNV1a.h"
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+MqttTopic::MqttTopic()
+{
+  clear();
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+bool MqttTopic::set(String const & topic)
+{
+  if (topic.length() > MAX_LENGTH)
+  {
+    clear();
+    return false;
+  }
+
+  _length = topic.length();
+  memcpy(_topic, topic.c_str(), _length);
+  _topic[_length] = '\0';
+  _hash = hash(_topic, _length);
+  return true;
+}
+
+void MqttTopic::clear()
+{
+  _topic[0] = '\0';
+  _length = 0;
+  _hash = hash(_topic, 0);
+}
+
+bool MqttTopic::matches(char const * topic, size_t const length, uint32_t const hash) const
+{
+  if (isEmpty() || (length != _length) || (hash != _hash))
+    return false;
+
+  return (memcmp(topic, _topic, _length) == 0);
+}
+
+bool MqttTopic::matches(String const & topic) const
+{
+  return matches(topic.c_str(), topic.length(), hash(topic.c_str(), topic.length()));
+}
+
+/**************************************************************************************
+ * STATIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+uint32_t MqttTopic::hash(char const * topic, size_t const length)
+{
+  return fnv1a(topic, length);
+}
@@ -0,0 +1,65 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_MQTT_TOPIC_H_
+#define ARDUINO_IOT_CLOUD_MQTT_TOPIC_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino.h>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* MqttTopic stores a topic name in a fixed size buffer together with its length
+ * and hash. Both are computed once when the topic is set, so that comparing the
+ * topic of an incoming message against several topics only needs to hash the
+ * incoming topic once and only needs a full compare of the topic which matches.
+ */
+class MqttTopic
+{
+
+public:
+
+  static size_t const MAX_LENGTH = 64;
+
+  MqttTopic();
+
+
+  bool set    (String const & topic);
+  void clear  ();
+  bool matches(char const * topic, size_t const length, uint32_t const hash) const;
+  bool matches(String const & topic) const;
+
+  inline char const * c_str  () const { return _topic; }
+  inline size_t       length () const { return _length; }
+  inline bool         isEmpty() const { return _length == 0; }
+
+  static uint32_t hash(char const * topic, size_t const length);
+
+private:
+
+  char     _topic[MAX_LENGTH + 1];
+  size_t   _length;
+  uint32_t _hash;
+
+};
+
+#endif /* ARDUINO_IOT_CLOUD_MQTT_TOPIC_H_ */
@@ -0,0 +1,198 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_RETRANSMIT_QUEUE_H_
+#define ARDUINO_IOT_CLOUD_RETRANSMIT_QUEUE_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino.h>
+
+#include <string.h>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* RetransmitQueue stores up to QUEUE_SIZE published messages for a retransmission,
+ * each one identified by a non-zero 16 bit id assigned by the queue (the MQTT
+ * client assigns its own packet ids). ArduinoMqttClient publishes stop-and-wait,
+ * i.e. with QoS 1 a message is acknowledged (PUBACK) before the next one is sent,
+ * hence the queue only holds messages whose publish failed until they can be
+ * retransmitted, i.e. after a connection loss. A message is never dropped
+ * before it has been acknowledged, a full queue rejects new messages instead
+ * and the caller has to hold them back until a slot is free.
+ * With QoS 0 nothing is ever acknowledged, a message is released instead once
+ * it has been sent: it is kept for a retransmission but is not pending, i.e.
+ * it is replaced by the next message.
+ */
+template <size_t QUEUE_SIZE, size_t MAX_MESSAGE_SIZE>
+class RetransmitQueue
+{
+
+public:
+
+  RetransmitQueue()
+  : _next_packet_id{1}
+  {
+    for (size_t i = 0; i < QUEUE_SIZE; i++)
+    {
+      _msg[i].packet_id = 0;
+      _msg[i].is_released = false;
+    }
+  }
+
+
+  /* Returns the id assigned to the message or 0 if the message is too large
+   * or the queue is full.
+   */
+  uint16_t push(uint8_t const * data, size_t const length)
+  {
+    if (length > MAX_MESSAGE_SIZE)
+      return 0;
+
+    /* Only unused slots and released messages are replaced. */
+    Message * msg = find(0);
+    if (!msg)
+      msg = oldest(true);
+    if (!msg)
+      return 0;
+
+    msg->packet_id = _next_packet_id;
+    msg->is_resend_requested = false;
+    msg->is_released = false;
+    msg->length = length;
+    memcpy(msg->data, data, length);
+
+    /* Id 0 marks an unused slot. */
+    _next_packet_id++;
+    if (_next_packet_id == 0)
+      _next_packet_id = 1;
+
+    return msg->packet_id;
+  }
+
+  bool ack(uint16_t const packet_id)
+  {
+    Message * msg = (packet_id != 0) ? find(packet_id) : nullptr;
+    if (!msg)
+      return false;
+
+    msg->packet_id = 0;
+    return true;
+  }
+
+  bool release(uint16_t const packet_id)
+  {
+    Message * msg = (packet_id != 0) ? find(packet_id) : nullptr;
+    if (!msg)
+      return false;
+
+    msg->is_released = true;
+    return true;
+  }
+
+  void requestResend()
+  {
+    for (size_t i = 0; i < QUEUE_SIZE; i++)
+      _msg[i].is_resend_requested = (_msg[i].packet_id != 0);
+  }
+
+  /* Returns the packet id of the oldest message flagged for retransmission and
+   * clears the flag or 0 if there is no message left to retransmit.
+   */
+  uint16_t nextResend()
+  {
+    Message * msg = nullptr;
+    for (size_t i = 0; i < QUEUE_SIZE; i++)
+    {
+      if (_msg[i].packet_id && _msg[i].is_resend_requested && (!msg || isOlder(_msg[i], *msg)))
+        msg = &_msg[i];
+    }
+
+    if (!msg)
+      return 0;
+
+    msg->is_resend_requested = false;
+    return msg->packet_id;
+  }
+
+  bool get(uint16_t const packet_id, uint8_t const * & data, size_t & length)
+  {
+    Message * msg = (packet_id != 0) ? find(packet_id) : nullptr;
+    if (!msg)
+      return false;
+
+    data = msg->data;
+    length = msg->length;
+    return true;
+  }
+
+  size_t size() const
+  {
+    size_t cnt = 0;
+    for (size_t i = 0; i < QUEUE_SIZE; i++)
+      if (_msg[i].packet_id && !_msg[i].is_released)
+        cnt++;
+    return cnt;
+  }
+
+  inline bool isFull() const { return size() == QUEUE_SIZE; }
+
+private:
+
+  struct Message
+  {
+    uint16_t      packet_id;
+    bool          is_resend_requested;
+    bool          is_released;
+    size_t        length;
+    uint8_t       data[MAX_MESSAGE_SIZE];
+  };
+
+  Message  _msg[QUEUE_SIZE];
+  uint16_t _next_packet_id;
+
+  Message * find(uint16_t const packet_id)
+  {
+    for (size_t i = 0; i < QUEUE_SIZE; i++)
+      if (_msg[i].packet_id == packet_id)
+        return &_msg[i];
+    return nullptr;
+  }
+
+  Message * oldest(bool const is_released)
+  {
+    Message * msg = nullptr;
+    for (size_t i = 0; i < QUEUE_SIZE; i++)
+      if ((_msg[i].is_released == is_released) && (!msg || isOlder(_msg[i], *msg)))
+        msg = &_msg[i];
+    return msg;
+  }
+
+  /* Packet ids are assigned in ascending order, the age of a message is the
+   * distance of its packet id to the next one to be assigned (wrap-around safe).
+   */
+  bool isOlder(Message const & lhs, Message const & rhs) const
+  {
+    return static_cast<uint16_t>(_next_packet_id - lhs.packet_id) > static_cast<uint16_t>(_next_packet_id - rhs.packet_id);
+  }
+};
+
+#endif /* ARDUINO_IOT_CLOUD_RETRANSMIT_QUEUE_H_ */
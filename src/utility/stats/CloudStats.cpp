@@ -0,0 +1,256 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "CloudStats.h"
+
+#include <stdio.h>
+
+#if defined(__arm__) && !defined(HOST)
+#  include <malloc.h>
+#endif
+
+/**************************************************************************************
+ * LOCAL FUNCTIONS
+ **************************************************************************************/
+
+template <typename T>
+static inline void saturatingAdd(T & counter, unsigned long const value)
+{
+  T const sum = static_cast<T>(counter + value);
+  counter = (sum >= counter) ? sum : static_cast<T>(~static_cast<T>(0));
+}
+
+static void getHeapUsage(size_t & used, size_t & high_water)
+{
+#if defined(ARDUINO_ARCH_ESP32)
+  size_t const size = ESP.getHeapSize();
+  used = size - ESP.getFreeHeap();
+  high_water = size - ESP.getMinFreeHeap();
+#elif defined(__arm__) && !defined(HOST)
+  /* mallinfo() walks the free list, it is called once per sample. newlib
+   * never gives memory obtained by sbrk() back.
+   */
+  struct mallinfo const info = mallinfo();
+  used = info.uordblks;
+  high_water = info.arena;
+#else
+  used = 0;
+  high_water = 0;
+#endif
+}
+
+/**************************************************************************************
+ * DurationHistogram
+ **************************************************************************************/
+
+DurationHistogram::DurationHistogram()
+{
+  reset();
+}
+
+void DurationHistogram::add(unsigned long const duration_us)
+{
+  saturatingAdd(_bucket[getBucketIndex(duration_us)], 1);
+  if (duration_us > _max_us)
+    _max_us = duration_us;
+}
+
+void DurationHistogram::reset()
+{
+  for (size_t i = 0; i < BUCKET_CNT; i++)
+    _bucket[i] = 0;
+  _max_us = 0;
+}
+
+uint32_t DurationHistogram::getCount() const
+{
+  uint32_t cnt = 0;
+  for (size_t i = 0; i < BUCKET_CNT; i++)
+    saturatingAdd(cnt, _bucket[i]);
+  return cnt;
+}
+
+uint32_t DurationHistogram::getBucket(size_t const bucket) const
+{
+  return (bucket < BUCKET_CNT) ? _bucket[bucket] : 0;
+}
+
+unsigned long DurationHistogram::getMax() const
+{
+  return _max_us;
+}
+
+unsigned long DurationHistogram::getPercentile(unsigned int const percent) const
+{
+  uint32_t const cnt = getCount();
+  if (cnt == 0)
+    return 0;
+
+  /* Number of durations which have to be <= the percentile, rounded up. */
+  uint32_t const threshold = static_cast<uint32_t>((static_cast<uint64_t>(cnt) * percent + 99) / 100);
+  uint32_t sum = 0;
+  for (size_t i = 0; i < BUCKET_CNT; i++)
+  {
+    sum += _bucket[i];
+    if (sum >= threshold)
+      return (getBucketUpperBound(i) < _max_us) ? getBucketUpperBound(i) : _max_us;
+  }
+  return _max_us;
+}
+
+size_t DurationHistogram::getBucketIndex(unsigned long const duration_us)
+{
+  size_t bucket = 0;
+  for (unsigned long d = duration_us; (d > 0) && (bucket < (BUCKET_CNT - 1)); d >>= 1)
+    bucket++;
+  return bucket;
+}
+
+unsigned long DurationHistogram::getBucketUpperBound(size_t const bucket)
+{
+  if (bucket >= (BUCKET_CNT - 1))
+    return ~0UL;
+  return (1UL << bucket) - 1;
+}
+
+/**************************************************************************************
+ * CloudStats
+ **************************************************************************************/
+
+CloudStats::CloudStats()
+{
+  reset();
+}
+
+void CloudStats::reset()
+{
+  messages_in = 0;
+  bytes_in = 0;
+  messages_out = 0;
+  bytes_out = 0;
+  publish_failures = 0;
+  retransmits = 0;
+  dropped_for_size = 0;
+  connect_attempts = 0;
+  for (size_t i = 0; i < MAX_STATE_CNT; i++)
+    reconnects[i] = 0;
+  handshake_duration_ms = 0;
+  max_handshake_duration_ms = 0;
+  queue_depth = 0;
+  max_queue_depth = 0;
+  heap_used = 0;
+  max_heap_used = 0;
+  heap_high_water = 0;
+  encode_duration_us.reset();
+  decode_duration_us.reset();
+}
+
+void CloudStats::onMessageIn(size_t const length)
+{
+  saturatingAdd(messages_in, 1);
+  saturatingAdd(bytes_in, length);
+}
+
+void CloudStats::onMessageOut(size_t const length)
+{
+  saturatingAdd(messages_out, 1);
+  saturatingAdd(bytes_out, length);
+}
+
+void CloudStats::onPublishFailure()
+{
+  saturatingAdd(publish_failures, 1);
+}
+
+void CloudStats::onRetransmit()
+{
+  saturatingAdd(retransmits, 1);
+}
+
+void CloudStats::onDroppedForSize()
+{
+  saturatingAdd(dropped_for_size, 1);
+}
+
+void CloudStats::onConnectAttempt()
+{
+  saturatingAdd(connect_attempts, 1);
+}
+
+void CloudStats::onHandshake(unsigned long const duration_ms)
+{
+  handshake_duration_ms = duration_ms;
+  if (duration_ms > max_handshake_duration_ms)
+    max_handshake_duration_ms = duration_ms;
+}
+
+void CloudStats::onReconnect(size_t const state)
+{
+  if (state < MAX_STATE_CNT)
+    saturatingAdd(reconnects[state], 1);
+}
+
+void CloudStats::onQueueDepth(size_t const depth)
+{
+  queue_depth = depth;
+  if (depth > max_queue_depth)
+    max_queue_depth = depth;
+}
+
+void CloudStats::onEncode(unsigned long const duration_us)
+{
+  encode_duration_us.add(duration_us);
+}
+
+void CloudStats::onDecode(unsigned long const duration_us)
+{
+  decode_duration_us.add(duration_us);
+}
+
+void CloudStats::updateHeapUsage()
+{
+  getHeapUsage(heap_used, heap_high_water);
+  if (heap_used > max_heap_used)
+    max_heap_used = heap_used;
+}
+
+int CloudStats::print(char * buf, size_t const size) const
+{
+  unsigned long reconnect_cnt = 0;
+  for (size_t i = 0; i < MAX_STATE_CNT; i++)
+    reconnect_cnt += reconnects[i];
+
+  return snprintf(buf, size, "mi=%lu,bi=%lu,mo=%lu,bo=%lu,pf=%lu,rt=%lu,ds=%lu,rc=%lu,hs=%lu,q=%lu,hp=%lu,hw=%lu,e99=%lu,d99=%lu",
+                  static_cast<unsigned long>(messages_in),
+                  static_cast<unsigned long>(bytes_in),
+                  static_cast<unsigned long>(messages_out),
+                  static_cast<unsigned long>(bytes_out),
+                  static_cast<unsigned long>(publish_failures),
+                  static_cast<unsigned long>(retransmits),
+                  static_cast<unsigned long>(dropped_for_size),
+                  reconnect_cnt,
+                  max_handshake_duration_ms,
+                  static_cast<unsigned long>(max_queue_depth),
+                  static_cast<unsigned long>(max_heap_used),
+                  static_cast<unsigned long>(heap_high_water),
+                  encode_duration_us.getPercentile(99),
+                  decode_duration_us.getPercentile(99));
+}
@@ -0,0 +1,153 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_STATS_H_
+#define ARDUINO_IOT_CLOUD_STATS_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <AIoTC_Config.h>
+
+#include <Arduino.h>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Histogram of durations in microseconds with logarithmic buckets: bucket 0
+ * counts durations of 0 us, bucket i durations in [2^(i-1), 2^i) us and the
+ * last bucket all durations from 2^(BUCKET_CNT-2) us upwards (16 ms).
+ */
+class DurationHistogram
+{
+public:
+
+  static size_t const BUCKET_CNT = 16;
+
+  DurationHistogram();
+
+  void          add        (unsigned long const duration_us);
+  void          reset      ();
+
+  uint32_t      getCount   () const;
+  uint32_t      getBucket  (size_t const bucket) const;
+  unsigned long getMax     () const;
+  /* Returns the upper bound of the bucket containing the given percentile,
+   * i.e. 99 % of the durations are <= getPercentile(99), or the maximum
+   * duration if it is smaller.
+   */
+  unsigned long getPercentile(unsigned int const percent) const;
+
+  static size_t        getBucketIndex     (unsigned long const duration_us);
+  static unsigned long getBucketUpperBound(size_t const bucket);
+
+private:
+
+  uint32_t _bucket[BUCKET_CNT];
+  unsigned long _max_us;
+};
+
+/* Counters describing the behaviour of the cloud stack, see getStats(). All
+ * counters start at 0 and saturate instead of wrapping around.
+ */
+class CloudStats
+{
+public:
+
+  /* The connection state machines have at most MAX_STATE_CNT states. */
+  static size_t const MAX_STATE_CNT = 8;
+
+  CloudStats();
+
+  void reset();
+
+  void onMessageIn      (size_t const length);
+  void onMessageOut     (size_t const length);
+  void onPublishFailure ();
+  void onRetransmit     ();
+  void onDroppedForSize ();
+  void onConnectAttempt ();
+  void onHandshake      (unsigned long const duration_ms);
+  void onReconnect      (size_t const state);
+  void onQueueDepth     (size_t const depth);
+  void onEncode         (unsigned long const duration_us);
+  void onDecode         (unsigned long const duration_us);
+  /* Samples the heap once, called by getStats() only. */
+  void updateHeapUsage  ();
+
+  /* Prints the most important counters as 'key=value' pairs separated by ',',
+   * returns the number of characters which would have been written.
+   */
+  int print(char * buf, size_t const size) const;
+
+  uint32_t messages_in;
+  uint32_t bytes_in;
+  uint32_t messages_out;
+  uint32_t bytes_out;
+  uint32_t publish_failures;
+  uint32_t retransmits;
+  /* Messages which could not be encoded because they exceed the transmit buffer. */
+  uint32_t dropped_for_size;
+  uint32_t connect_attempts;
+  /* Number of reconnections triggered from within each state of the connection
+   * state machine, indexed by the numeric value of the state.
+   */
+  uint16_t reconnects[MAX_STATE_CNT];
+  unsigned long handshake_duration_ms;
+  unsigned long max_handshake_duration_ms;
+  size_t queue_depth;
+  size_t max_queue_depth;
+  /* Heap in use, only available on ARM (newlib) and ESP32, otherwise 0. The
+   * maximum is the maximum of the samples, peaks in between are only covered
+   * by the high-water mark kept by the allocator: the size of the arena
+   * obtained by sbrk() on newlib, the heap size minus the minimum of free heap
+   * on ESP32.
+   */
+  size_t heap_used;
+  size_t max_heap_used;
+  size_t heap_high_water;
+  DurationHistogram encode_duration_us;
+  DurationHistogram decode_duration_us;
+};
+
+/**************************************************************************************
+ * DEFINES
+ **************************************************************************************/
+
+/* The counters of ArduinoIoTCloudClass are updated through AIOT_STATS(), which
+ * compiles to nothing without AIOT_CONFIG_STATS_ENABLED.
+ */
+#if AIOT_CONFIG_STATS_ENABLED
+#  define AIOT_STATS(call) _stats.call
+#else
+#  define AIOT_STATS(call) do { } while (0)
+#endif
+
+/* Durations are only measured if they are reported, either by AIOT_STATS() or
+ * by AIOT_TRACE().
+ */
+#if AIOT_CONFIG_STATS_ENABLED || (AIOT_CONFIG_TRACE_BUFFER_SIZE > 0)
+#  define AIOT_STATS_TIMESTAMP(start_us)             unsigned long const start_us = micros()
+#  define AIOT_STATS_DURATION(duration_us, start_us) unsigned long const duration_us = micros() - start_us
+#else
+#  define AIOT_STATS_TIMESTAMP(start_us)             do { } while (0)
+#  define AIOT_STATS_DURATION(duration_us, start_us) do { } while (0)
+#endif
+
+#endif /* ARDUINO_IOT_CLOUD_STATS_H_ */
@@ -54,7 +54,7 @@ private:
   static int           const MAX_NTP_PORT         = 65535;
 #endif
   static unsigned long const NTP_TIMEOUT_MS       = 1000;
-  static char constexpr *    NTP_TIME_SERVER      = "time.arduino.cc";
+  static constexpr char const * NTP_TIME_SERVER   = "time.arduino.cc";
 
   static void sendNTPpacket(UDP & udp);
 };
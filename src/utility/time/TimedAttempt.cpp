@@ -0,0 +1,114 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "TimedAttempt.h"
+
+/**************************************************************************************
+ * CONSTANTS
+ **************************************************************************************/
+
+static uint32_t const DEFAULT_RANDOM_SEED = 0x9E3779B9;
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+TimedAttempt::TimedAttempt(unsigned long const min_delay_ms, unsigned long const max_delay_ms)
+: _min_delay_ms{min_delay_ms}
+, _max_delay_ms{max_delay_ms}
+, _retry_cnt{0}
+, _retry_tick{0}
+, _wait_time_ms{0}
+, _rand_state{DEFAULT_RANDOM_SEED}
+{
+
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void TimedAttempt::seed(uint32_t const seed)
+{
+  /* A xorshift generator must never be seeded with 0. */
+  _rand_state = (seed != 0) ? seed : DEFAULT_RANDOM_SEED;
+}
+
+unsigned long TimedAttempt::retry()
+{
+  _retry_cnt++;
+
+  /* Wait for somewhere between half and the full backoff delay. */
+  unsigned long const delay_ms = getBackoffDelay();
+  unsigned long const half_delay_ms = delay_ms / 2;
+  _wait_time_ms = half_delay_ms + (getRandom() % (delay_ms - half_delay_ms + 1));
+  _retry_tick = millis();
+
+  return _wait_time_ms;
+}
+
+void TimedAttempt::reset()
+{
+  _retry_cnt = 0;
+  _wait_time_ms = 0;
+}
+
+bool TimedAttempt::isRetry() const
+{
+  return (_retry_cnt > 0);
+}
+
+bool TimedAttempt::isExpired() const
+{
+  return ((millis() - _retry_tick) >= _wait_time_ms);
+}
+
+unsigned int TimedAttempt::getRetryCount() const
+{
+  return _retry_cnt;
+}
+
+unsigned long TimedAttempt::getWaitTime() const
+{
+  return _wait_time_ms;
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+unsigned long TimedAttempt::getBackoffDelay() const
+{
+  unsigned long delay_ms = _min_delay_ms;
+  for (unsigned int i = 1; (i < _retry_cnt) && (delay_ms < _max_delay_ms); i++)
+    delay_ms *= 2;
+
+  return (delay_ms < _max_delay_ms) ? delay_ms : _max_delay_ms;
+}
+
+uint32_t TimedAttempt::getRandom()
+{
+  /* Source: Marsaglia, "Xorshift RNGs", Journal of Statistical Software, 2003 */
+  _rand_state ^= _rand_state << 13;
+  _rand_state ^= _rand_state >> 17;
+  _rand_state ^= _rand_state << 5;
+  return _rand_state;
+}
@@ -0,0 +1,68 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_TIMED_ATTEMPT_H_
+#define ARDUINO_IOT_CLOUD_TIMED_ATTEMPT_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino.h>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* TimedAttempt keeps track of consecutive failed attempts of an operation and
+ * computes the time to wait before the next attempt. The wait time doubles with
+ * every failure (min_delay_ms, 2 * min_delay_ms, 4 * min_delay_ms, ...) until it
+ * saturates at max_delay_ms. A random jitter in the range [delay / 2, delay] is
+ * applied so that a fleet of devices losing the broker at the same time does not
+ * retry in lockstep.
+ */
+class TimedAttempt
+{
+
+public:
+
+  TimedAttempt(unsigned long const min_delay_ms, unsigned long const max_delay_ms);
+
+
+  void          seed         (uint32_t const seed);
+  unsigned long retry        ();
+  void          reset        ();
+  bool          isRetry      () const;
+  bool          isExpired    () const;
+  unsigned int  getRetryCount() const;
+  unsigned long getWaitTime  () const;
+
+private:
+
+  unsigned long _min_delay_ms;
+  unsigned long _max_delay_ms;
+  unsigned int  _retry_cnt;
+  unsigned long _retry_tick;
+  unsigned long _wait_time_ms;
+  uint32_t      _rand_state;
+
+  unsigned long getBackoffDelay() const;
+  uint32_t      getRandom();
+
+};
+
+#endif /* ARDUINO_IOT_CLOUD_TIMED_ATTEMPT_H_ */
@@ -0,0 +1,182 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_TRACE_H_
+#define ARDUINO_IOT_CLOUD_TRACE_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <AIoTC_Config.h>
+
+#include <Arduino.h>
+
+/**************************************************************************************
+ * TYPEDEF
+ **************************************************************************************/
+
+/* The numeric values are part of the dump format, keep them in sync with
+ * extras/tools/trace_decode.py and never reuse the value of a removed event.
+ */
+enum class TraceEvent : uint16_t
+{
+  StateTransition    = 0x01, /* arg0 = (from << 8) | to                      */
+  MqttConnectBegin   = 0x10,
+  MqttConnectEnd     = 0x11, /* arg0 = success                               */
+  ConnectionLost     = 0x12,
+  TlsHandshakeBegin  = 0x20,
+  TlsEntropy         = 0x21, /* arg0 = entropy provided by the ECCX08        */
+  TlsClientReset     = 0x22,
+  TlsHandshakeEnd    = 0x23, /* arg0 = success, arg1 = last BearSSL error    */
+  Encode             = 0x30, /* arg0 = bytes encoded, arg1 = duration us     */
+  EncodeError        = 0x31, /* arg0 = CborError                             */
+  Decode             = 0x32, /* arg0 = bytes decoded, arg1 = duration us     */
+  MessageIn          = 0x40, /* arg1 = length                                */
+  MessageOut         = 0x41, /* arg1 = length                                */
+  PublishFailure     = 0x42, /* arg1 = length                                */
+  OtaRequest         = 0x50,
+  OtaResult          = 0x51, /* arg0 = OTAError, arg1 = download error code  */
+};
+
+struct TraceEntry
+{
+  uint32_t timestamp_us;
+  uint16_t event;
+  uint16_t arg0;
+  uint32_t arg1;
+};
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* TraceBuffer records the last SIZE events in a ring buffer, overwriting the
+ * oldest entry when full. Recording an event only stores a timestamp and two
+ * arguments, the decoding is left to the host (extras/tools/trace_decode.py).
+ */
+template <size_t SIZE>
+class TraceBuffer
+{
+
+public:
+
+  static uint8_t const FORMAT_VERSION = 1;
+  static size_t  const HEADER_SIZE    = 12;
+  static size_t  const ENTRY_SIZE     = 12;
+
+  TraceBuffer()
+  : _head{0}
+  , _cnt{0}
+  , _dropped_cnt{0}
+  { }
+
+
+  void record(TraceEvent const event, uint16_t const arg0 = 0, uint32_t const arg1 = 0)
+  {
+    TraceEntry & entry = _entry[_head];
+    entry.timestamp_us = micros();
+    entry.event = static_cast<uint16_t>(event);
+    entry.arg0 = arg0;
+    entry.arg1 = arg1;
+
+    _head = (_head + 1) % SIZE;
+    if (_cnt < SIZE)
+      _cnt++;
+    else
+      _dropped_cnt++;
+  }
+
+  void clear()
+  {
+    _head = 0;
+    _cnt = 0;
+    _dropped_cnt = 0;
+  }
+
+  /* Entry 0 is the oldest one. */
+  TraceEntry const & get(size_t const idx) const
+  {
+    return _entry[(_head + SIZE - _cnt + idx) % SIZE];
+  }
+
+  inline size_t        size           () const { return _cnt; }
+  inline unsigned long getDroppedCount() const { return _dropped_cnt; }
+
+  /* Writes the recorded entries, oldest first, to any object providing
+   * write(uint8_t const *, size_t), e.g. Serial or a File. All fields are
+   * little endian:
+   *
+   *   header: 'T' 'R' 'C' version | entry count (u16) | entry size (u16) | dropped count (u32)
+   *   entry:  timestamp us (u32) | event (u16) | arg0 (u16) | arg1 (u32)
+   *
+   * Returns the number of bytes written.
+   */
+  template <typename WRITER>
+  size_t dump(WRITER & out) const
+  {
+    uint8_t buf[HEADER_SIZE] = {'T', 'R', 'C', FORMAT_VERSION};
+    pack16(buf + 4, static_cast<uint16_t>(_cnt));
+    pack16(buf + 6, ENTRY_SIZE);
+    pack32(buf + 8, _dropped_cnt);
+    size_t bytes_written = out.write(buf, HEADER_SIZE);
+
+    for (size_t i = 0; i < _cnt; i++)
+    {
+      TraceEntry const & entry = get(i);
+      pack32(buf + 0, entry.timestamp_us);
+      pack16(buf + 4, entry.event);
+      pack16(buf + 6, entry.arg0);
+      pack32(buf + 8, entry.arg1);
+      bytes_written += out.write(buf, ENTRY_SIZE);
+    }
+
+    return bytes_written;
+  }
+
+private:
+
+  TraceEntry    _entry[SIZE];
+  size_t        _head;
+  size_t        _cnt;
+  unsigned long _dropped_cnt;
+
+  static void pack16(uint8_t * buf, uint16_t const val)
+  {
+    buf[0] = val & 0xFF;
+    buf[1] = val >> 8;
+  }
+
+  static void pack32(uint8_t * buf, uint32_t const val)
+  {
+    pack16(buf + 0, val & 0xFFFF);
+    pack16(buf + 2, val >> 16);
+  }
+};
+
+/**************************************************************************************
+ * EXTERN DECLARATION
+ **************************************************************************************/
+
+#if AIOT_CONFIG_TRACE_BUFFER_SIZE > 0
+extern TraceBuffer<AIOT_CONFIG_TRACE_BUFFER_SIZE> aiotc_trace;
+#  define AIOT_TRACE(event, arg0, arg1) aiotc_trace.record(TraceEvent::event, arg0, arg1)
+#else
+#  define AIOT_TRACE(event, arg0, arg1) do { } while (0)
+#endif
+
+#endif /* ARDUINO_IOT_CLOUD_TRACE_H_ */
@@ -0,0 +1,212 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "Polyline.h"
+
+#include <math.h>
+#include <string.h>
+
+/**************************************************************************************
+ * CONSTANTS
+ **************************************************************************************/
+
+long const Polyline::SCALE;
+
+/* Length of 1e-5 degree of latitude on a sphere of 6371 km radius. */
+static float const METRES_PER_UNIT = 1.11195f;
+static float const RADIANS_PER_UNIT = 3.14159265f / 180.0f / Polyline::SCALE;
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+Polyline::Polyline(size_t const capacity, int32_t * lat, int32_t * lon, uint16_t * stack, uint8_t * keep)
+: _capacity{capacity}
+, _size{0}
+, _tolerance{0.0f}
+, _lat{lat}
+, _lon{lon}
+, _stack{stack}
+, _keep{keep}
+{
+
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void Polyline::setTolerance(float const tolerance_m)
+{
+  _tolerance = tolerance_m;
+}
+
+bool Polyline::add(float const lat, float const lon)
+{
+  int32_t const y = static_cast<int32_t>(lround(static_cast<double>(lat) * SCALE));
+  int32_t const x = static_cast<int32_t>(lround(static_cast<double>(lon) * SCALE));
+
+  if (_size > 0)
+  {
+    /* The longitude is not corrected for the latitude, which overestimates
+     * the distance, i.e. only fixes which are closer for sure are dropped.
+     */
+    float const dy = static_cast<float>(y - _lat[_size - 1]);
+    float const dx = static_cast<float>(x - _lon[_size - 1]);
+    float const tolerance = _tolerance / METRES_PER_UNIT;
+    if ((dx * dx + dy * dy) < (tolerance * tolerance))
+      return false;
+  }
+
+  if (_size == _capacity)
+  {
+    /* At most the start and end point remain at some point. */
+    for (float tolerance = (_tolerance > METRES_PER_UNIT) ? _tolerance : METRES_PER_UNIT; _size == _capacity; tolerance *= 2.0f)
+      simplify(tolerance);
+  }
+
+  _lat[_size] = y;
+  _lon[_size] = x;
+  _size++;
+  return true;
+}
+
+void Polyline::simplify()
+{
+  simplify(_tolerance);
+}
+
+void Polyline::restart()
+{
+  if (_size > 1)
+  {
+    _lat[0] = _lat[_size - 1];
+    _lon[0] = _lon[_size - 1];
+    _size = 1;
+  }
+}
+
+void Polyline::clear()
+{
+  _size = 0;
+}
+
+void Polyline::encode(String & polyline) const
+{
+  polyline.reserve(_size * 8);
+
+  int32_t prev_lat = 0, prev_lon = 0;
+  for (size_t i = 0; i < _size; i++)
+  {
+    encodeValue(polyline, _lat[i] - prev_lat);
+    encodeValue(polyline, _lon[i] - prev_lon);
+    prev_lat = _lat[i];
+    prev_lon = _lon[i];
+  }
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void Polyline::simplify(float const tolerance)
+{
+  if (_size < 3)
+    return;
+
+  /* The distances are computed in a plane in which a unit of longitude is
+   * scaled by the cosine of the latitude of the first point, they are
+   * compared squared and multiplied by the squared length of the segment in
+   * order to neither need sqrt() nor a division per point.
+   */
+  float const kx = cosf(_lat[0] * RADIANS_PER_UNIT);
+  float const tolerance2 = (tolerance / METRES_PER_UNIT) * (tolerance / METRES_PER_UNIT);
+
+  memset(_keep, 0, _size);
+  _keep[0] = 1;
+  _keep[_size - 1] = 1;
+
+  size_t sp = 0;
+  _stack[sp++] = 0;
+  _stack[sp++] = _size - 1;
+
+  while (sp > 0)
+  {
+    uint16_t const b = _stack[--sp];
+    uint16_t const a = _stack[--sp];
+    if ((b - a) < 2)
+      continue;
+
+    float const sx = (_lon[b] - _lon[a]) * kx;
+    float const sy = static_cast<float>(_lat[b] - _lat[a]);
+    float const length2 = sx * sx + sy * sy;
+
+    float max_distance = 0.0f;
+    uint16_t max_idx = a;
+    for (uint16_t i = a + 1; i < b; i++)
+    {
+      float const px = (_lon[i] - _lon[a]) * kx;
+      float const py = static_cast<float>(_lat[i] - _lat[a]);
+      float const cross = sx * py - sy * px;
+      float const distance = (length2 > 0.0f) ? (cross * cross) : (px * px + py * py);
+      if (distance > max_distance)
+      {
+        max_distance = distance;
+        max_idx = i;
+      }
+    }
+
+    if (max_distance > ((length2 > 0.0f) ? (tolerance2 * length2) : tolerance2))
+    {
+      _keep[max_idx] = 1;
+      _stack[sp++] = a;
+      _stack[sp++] = max_idx;
+      _stack[sp++] = max_idx;
+      _stack[sp++] = b;
+    }
+  }
+
+  size_t cnt = 0;
+  for (size_t i = 0; i < _size; i++)
+  {
+    if (_keep[i])
+    {
+      _lat[cnt] = _lat[i];
+      _lon[cnt] = _lon[i];
+      cnt++;
+    }
+  }
+  _size = cnt;
+}
+
+void Polyline::encodeValue(String & polyline, int32_t const value)
+{
+  /* The sign is moved into the lowest bit, the value is then sent in chunks of
+   * 5 bit, lowest first, with 0x20 marking that another chunk follows.
+   */
+  uint32_t chunks = (value < 0) ? ~(static_cast<uint32_t>(value) << 1) : (static_cast<uint32_t>(value) << 1);
+  while (chunks >= 0x20)
+  {
+    polyline += static_cast<char>((0x20 | (chunks & 0x1F)) + 63);
+    chunks >>= 5;
+  }
+  polyline += static_cast<char>(chunks + 63);
+}
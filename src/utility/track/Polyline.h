@@ -0,0 +1,101 @@
+/*
+   This file is part of ArduinoIoTCloud.
+
+   Copyright 2021 ARDUINO SA (http://www.arduino.cc/)
+
+   This software is released under the GNU General Public License version 3,
+   which covers the main part of arduino-cli.
+   The terms of this license can be found at:
+   https://www.gnu.org/licenses/gpl-3.0.en.html
+
+   You can be released from the requirements of the above licenses by purchasing
+   a commercial license. Buying such a license is mandatory if you want to modify or
+   otherwise use the software for commercial activities involving the Arduino
+   software without disclosing the source code of your own applications. To purchase
+   a commercial license, send an email to license@arduino.cc.
+*/
+
+#ifndef ARDUINO_IOT_CLOUD_POLYLINE_H_
+#define ARDUINO_IOT_CLOUD_POLYLINE_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino.h>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Polyline buffers GPS fixes as coordinates in 1e-5 degree (about 1.1 m) and
+ * simplifies them with the Douglas-Peucker algorithm, which only keeps the
+ * points deviating by more than 'tolerance' metres from the simplified path.
+ * Once the buffer is full it is simplified, if this frees no point the
+ * tolerance is doubled until it does, so the memory used is bounded by the
+ * capacity. encode() produces the Encoded Polyline Algorithm Format known from
+ * the map services, i.e. the deltas between consecutive points as printable
+ * characters. The storage is provided by StaticPolyline.
+ */
+class Polyline
+{
+
+public:
+
+  static long const SCALE = 100000L;
+
+  void   setTolerance(float const tolerance_m);
+  /* Returns false if the fix is dropped because it is closer than the
+   * tolerance to the last point.
+   */
+  bool   add        (float const lat, float const lon);
+  void   simplify   ();
+  /* Removes all points but the last one, i.e. the start of the next track. */
+  void   restart    ();
+  void   clear      ();
+  void   encode     (String & polyline) const;
+
+  inline size_t  size    () const                 { return _size; }
+  inline size_t  capacity() const                 { return _capacity; }
+  inline int32_t lat     (size_t const idx) const { return _lat[idx]; }
+  inline int32_t lon     (size_t const idx) const { return _lon[idx]; }
+
+protected:
+
+  Polyline(size_t const capacity, int32_t * lat, int32_t * lon, uint16_t * stack, uint8_t * keep);
+
+private:
+
+  size_t const _capacity;
+  size_t       _size;
+  float        _tolerance;
+  int32_t    * _lat;
+  int32_t    * _lon;
+  uint16_t   * _stack;
+  uint8_t    * _keep;
+
+  void simplify(float const tolerance);
+  static void encodeValue(String & polyline, int32_t const value);
+};
+
+template <size_t SIZE>
+class StaticPolyline : public Polyline
+{
+
+public:
+
+  static_assert(SIZE >= 3, "A polyline needs room for at least 3 points in order to be simplified");
+
+  StaticPolyline()
+  : Polyline(SIZE, _lat_buf, _lon_buf, _stack_buf, _keep_buf)
+  { }
+
+private:
+
+  int32_t  _lat_buf[SIZE];
+  int32_t  _lon_buf[SIZE];
+  uint16_t _stack_buf[2 * SIZE];
+  uint8_t  _keep_buf[SIZE];
+};
+
+#endif /* ARDUINO_IOT_CLOUD_POLYLINE_H_ */